@@ -2,6 +2,9 @@
 
 #include <libpldm/instance-id.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cerrno>
 #include <cstdint>
 #include <exception>
@@ -39,7 +42,7 @@ class InstanceIdDb
         }
     }
 
-    ~InstanceIdDb()
+    virtual ~InstanceIdDb()
     {
         /*
          * Abandon error-reporting. We shouldn't throw an exception from the
@@ -56,7 +59,7 @@ class InstanceIdDb
      *  @return - PLDM instance id or -EAGAIN if there are no available instance
      *            IDs
      */
-    uint8_t next(uint8_t tid)
+    virtual uint8_t next(uint8_t tid)
     {
         uint8_t id;
         int rc = pldm_instance_id_alloc(pldmInstanceIdDb, tid, &id);
@@ -78,7 +81,7 @@ class InstanceIdDb
      *  @param[in] tid - the terminus ID the instance ID is associated with
      *  @param[in] instanceId - PLDM instance id to be freed
      */
-    void free(uint8_t tid, uint8_t instanceId)
+    virtual void free(uint8_t tid, uint8_t instanceId)
     {
         int rc = pldm_instance_id_free(pldmInstanceIdDb, tid, instanceId);
         if (rc == -EINVAL)
@@ -97,4 +100,146 @@ class InstanceIdDb
     pldm_instance_db* pldmInstanceIdDb = nullptr;
 };
 
+/** @class LeasedInstanceIdDb
+ *  @brief Instance ID allocator of a long-running requester
+ *
+ *  Reserves instance IDs of a terminus from the shared instance ID database
+ *  on first use and hands them out round robin from a bitmap, so that
+ *  allocating and freeing an instance ID doesn't lock the database. The
+ *  reserved IDs stay allocated in the database for the lifetime of the
+ *  allocator, which is why the lease is capped: the other processes, pldmtool
+ *  included, allocate from the rest. Requests beyond the lease allocate their
+ *  IDs from the database.
+ */
+class LeasedInstanceIdDb : public InstanceIdDb
+{
+  public:
+    /** @brief Largest lease, one instance ID of the 32 of the database is
+     *         always left to the other processes
+     */
+    static constexpr uint8_t maxLeaseSize = 31;
+
+    /** @brief Constructor
+     *
+     *  @param[in] leaseSize - number of instance IDs reserved per terminus
+     */
+    explicit LeasedInstanceIdDb(
+        uint8_t leaseSize = static_cast<uint8_t>(INSTANCE_ID_LEASE_SIZE)) :
+        leaseSize(std::min(leaseSize, maxLeaseSize))
+    {}
+
+    /** @brief Constructor
+     *
+     *  @param[in] path - instance ID database path
+     *  @param[in] leaseSize - number of instance IDs reserved per terminus
+     */
+    explicit LeasedInstanceIdDb(
+        const std::string& path,
+        uint8_t leaseSize = static_cast<uint8_t>(INSTANCE_ID_LEASE_SIZE)) :
+        InstanceIdDb(path), leaseSize(std::min(leaseSize, maxLeaseSize))
+    {}
+
+    /* The reserved IDs are released with the database */
+    ~LeasedInstanceIdDb() override = default;
+
+    /** @brief Allocate an instance ID for the given terminus
+     *  @param[in] tid - the terminus ID the instance ID is associated with
+     *  @return - PLDM instance id
+     */
+    uint8_t next(uint8_t tid) override
+    {
+        auto& lease = leases[tid];
+        auto available = lease.reserved & ~lease.used;
+        if (!available && std::popcount(lease.reserved) < leaseSize)
+        {
+            reserve(tid, lease);
+            available = lease.reserved & ~lease.used;
+        }
+        if (!available)
+        {
+            return InstanceIdDb::next(tid);
+        }
+
+        /* round robin, the IDs following the last one handed out first */
+        auto shift = (lease.last + 1) % maxInstanceIds;
+        auto rotated = std::rotr(available, shift);
+        auto id = static_cast<uint8_t>((std::countr_zero(rotated) + shift) %
+                                       maxInstanceIds);
+        lease.used |= (1u << id);
+        lease.last = id;
+        return id;
+    }
+
+    /** @brief Mark an instance id as unused
+     *  @param[in] tid - the terminus ID the instance ID is associated with
+     *  @param[in] instanceId - PLDM instance id to be freed
+     */
+    void free(uint8_t tid, uint8_t instanceId) override
+    {
+        auto& lease = leases[tid];
+        auto bit = (instanceId < maxInstanceIds) ? (1u << instanceId) : 0;
+        if (!(lease.reserved & bit))
+        {
+            InstanceIdDb::free(tid, instanceId);
+            return;
+        }
+        if (!(lease.used & bit))
+        {
+            throw std::runtime_error(
+                "Instance ID " + std::to_string(instanceId) + " for TID " +
+                std::to_string(tid) + " was not previously allocated");
+        }
+
+        lease.used &= ~bit;
+    }
+
+    /** @brief Get the number of instance IDs reserved per terminus
+     *
+     *  @return the lease size
+     */
+    uint8_t getLeaseSize() const
+    {
+        return leaseSize;
+    }
+
+  private:
+    static constexpr uint8_t maxInstanceIds = 32;
+
+    /** @struct Lease
+     *  @brief The instance IDs reserved for a terminus
+     */
+    struct Lease
+    {
+        uint32_t reserved = 0;             //!< IDs reserved in the database
+        uint32_t used = 0;                 //!< IDs handed out
+        uint8_t last = maxInstanceIds - 1; //!< ID last handed out
+    };
+
+    /** @brief Reserve instance IDs up to leaseSize, fewer if the database is
+     *         short of IDs or fails. The requests beyond the lease then get
+     *         the error of the database.
+     */
+    void reserve(uint8_t tid, Lease& lease)
+    {
+        while (std::popcount(lease.reserved) < leaseSize)
+        {
+            try
+            {
+                lease.reserved |= (1u << InstanceIdDb::next(tid));
+            }
+            catch (const std::runtime_error&)
+            {
+                break;
+            }
+            catch (const std::error_condition&)
+            {
+                break;
+            }
+        }
+    }
+
+    uint8_t leaseSize;                         //!< IDs reserved per terminus
+    std::array<Lease, PLDM_MAX_TIDS> leases{}; //!< Leases per terminus ID
+};
+
 } // namespace pldm
@@ -0,0 +1,96 @@
+#include "common/instance_id.hpp"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+class LeasedInstanceIdDbTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char dbName[] = "/tmp/db.XXXXXX";
+        ::close(::mkstemp(dbName));
+        dbPath = dbName;
+        std::filesystem::resize_file(dbPath,
+                                     static_cast<uintmax_t>(PLDM_MAX_TIDS) *
+                                         maxInstanceIds);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(dbPath);
+    }
+
+    static constexpr uintmax_t maxInstanceIds = 32;
+    static constexpr uint8_t tid = 9;
+    static constexpr uint8_t leaseSize = 4;
+    std::filesystem::path dbPath;
+};
+
+TEST_F(LeasedInstanceIdDbTest, roundRobin)
+{
+    LeasedInstanceIdDb db(dbPath, leaseSize);
+
+    // Freed IDs are not handed out again right away
+    std::vector<uint8_t> ids;
+    for (auto i = 0; i < leaseSize + 1; i++)
+    {
+        ids.emplace_back(db.next(tid));
+        db.free(tid, ids.back());
+    }
+    EXPECT_EQ(std::set<uint8_t>(ids.begin(), ids.end()).size(), leaseSize);
+    EXPECT_EQ(ids.front(), ids.back());
+
+    EXPECT_THROW(db.free(tid, ids.front()), std::runtime_error);
+}
+
+TEST_F(LeasedInstanceIdDbTest, sharedWithOtherProcesses)
+{
+    LeasedInstanceIdDb db(dbPath, leaseSize);
+    InstanceIdDb other(dbPath);
+
+    // The lease is capped, the requests past it allocate from the database
+    std::set<uint8_t> ids;
+    for (auto i = 0; i < leaseSize + 2; i++)
+    {
+        EXPECT_TRUE(ids.emplace(db.next(tid)).second);
+    }
+    for (uintmax_t i = leaseSize + 2; i < maxInstanceIds; i++)
+    {
+        EXPECT_FALSE(ids.contains(other.next(tid)));
+    }
+    EXPECT_THROW(other.next(tid), std::runtime_error);
+    EXPECT_THROW(db.next(tid), std::runtime_error);
+
+    // Only the IDs allocated past the lease go back to the database
+    for (auto id : ids)
+    {
+        db.free(tid, id);
+    }
+    EXPECT_NO_THROW(other.next(tid));
+    EXPECT_NO_THROW(other.next(tid));
+    EXPECT_THROW(other.next(tid), std::runtime_error);
+
+    // The lease is still there for the next requests
+    EXPECT_NO_THROW(db.next(tid));
+}
+
+TEST_F(LeasedInstanceIdDbTest, leaseSizeCapped)
+{
+    LeasedInstanceIdDb db(dbPath, maxInstanceIds);
+    InstanceIdDb other(dbPath);
+    EXPECT_EQ(db.getLeaseSize(), LeasedInstanceIdDb::maxLeaseSize);
+
+    // The lease leaves an ID to the other processes
+    db.next(tid);
+    EXPECT_NO_THROW(other.next(tid));
+    EXPECT_THROW(other.next(tid), std::runtime_error);
+}
@@ -30,6 +30,37 @@ TEST(GetInventoryObjects, testForObject)
     EXPECT_EQ(model, std::string("1234 - 00Z"));
 }
 
+class GetManagedChangingObject
+{
+  public:
+    static ObjectValueTree getManagedObj(const char* /*service*/,
+                                         const char* /*path*/)
+    {
+        ++calls;
+        return ObjectValueTree{
+            {sdbusplus::message::object_path("/foo/bar" +
+                                             std::to_string(calls)),
+             {}}};
+    }
+
+    static inline size_t calls = 0;
+};
+
+TEST(GetInventoryObjects, testRefresh)
+{
+    auto& cached = DBusHandler::getInventoryObjects<GetManagedChangingObject>();
+    EXPECT_TRUE(cached.contains(sdbusplus::message::object_path("/foo/bar1")));
+    DBusHandler::getInventoryObjects<GetManagedChangingObject>();
+    EXPECT_EQ(GetManagedChangingObject::calls, 1u);
+
+    auto& refreshed =
+        DBusHandler::refreshInventoryObjects<GetManagedChangingObject>();
+    EXPECT_EQ(&refreshed, &cached);
+    EXPECT_EQ(GetManagedChangingObject::calls, 2u);
+    EXPECT_FALSE(cached.contains(sdbusplus::message::object_path("/foo/bar1")));
+    EXPECT_TRUE(cached.contains(sdbusplus::message::object_path("/foo/bar2")));
+}
+
 TEST(printBuffer, testprintBufferGoodPath)
 {
     std::vector<uint8_t> buffer = {10, 12, 14, 25, 233};
@@ -3,8 +3,14 @@
 #include <libpldm/transport.h>
 #include <libpldm/transport/af-mctp.h>
 #include <libpldm/transport/mctp-demux.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <ranges>
 #include <system_error>
 
@@ -100,6 +106,141 @@ static constexpr uint8_t MCTP_EID_VALID_MAX = 255;
     return pldmTransport;
 }
 
+/*
+ * The loopback transport exchanges SOCK_SEQPACKET packets made of the TID of
+ * the remote terminus followed by the PLDM message: the destination TID when
+ * sending, the source TID when receiving. Received messages are allocated with
+ * malloc() like the libpldm transports do, the caller frees them.
+ */
+
+static pldm_requester_rc_t pldm_transport_loopback_send(
+    int fd, pldm_tid_t tid, const void* tx, size_t len)
+{
+    if (len < sizeof(pldm_msg_hdr))
+    {
+        return PLDM_REQUESTER_NOT_PLDM_MSG;
+    }
+
+    iovec iov[2] = {{&tid, sizeof(tid)}, {const_cast<void*>(tx), len}};
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+    if (sendmsg(fd, &msg, MSG_NOSIGNAL) < 0)
+    {
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+static pldm_requester_rc_t pldm_transport_loopback_recv(
+    int fd, pldm_tid_t& tid, void*& rx, size_t& len)
+{
+    auto size = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+    if (size <= 0)
+    {
+        /* Error, or the terminus closed its end */
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+
+    auto buf = static_cast<uint8_t*>(malloc(size));
+    if (!buf)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    if (recv(fd, buf, size, 0) != size)
+    {
+        free(buf);
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    if (static_cast<size_t>(size) < sizeof(tid) + sizeof(pldm_msg_hdr))
+    {
+        free(buf);
+        return PLDM_REQUESTER_INVALID_RECV_LEN;
+    }
+
+    tid = buf[0];
+    len = size - sizeof(tid);
+    memmove(buf, buf + sizeof(tid), len);
+    rx = buf;
+
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+static pldm_requester_rc_t pldm_transport_loopback_send_recv(
+    int fd, pldm_tid_t tid, const void* tx, size_t txLen, void*& rx,
+    size_t& rxLen)
+{
+    if (txLen < sizeof(pldm_msg_hdr))
+    {
+        return PLDM_REQUESTER_NOT_PLDM_MSG;
+    }
+    auto req = static_cast<const pldm_msg_hdr*>(tx);
+    if (!req->request)
+    {
+        return PLDM_REQUESTER_NOT_REQ_MSG;
+    }
+
+    auto rc = pldm_transport_loopback_send(fd, tid, tx, txLen);
+    if (rc != PLDM_REQUESTER_SUCCESS)
+    {
+        return rc;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(RESPONSE_TIME_OUT);
+    pollfd pfd{fd, POLLIN, 0};
+    while (true)
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             deadline - std::chrono::steady_clock::now())
+                             .count();
+        if (remaining <= 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+
+        auto ret = poll(&pfd, 1, remaining);
+        if (ret < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (ret < 0)
+        {
+            return PLDM_REQUESTER_POLL_FAIL;
+        }
+        if (ret == 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+
+        pldm_tid_t src{};
+        void* msg = nullptr;
+        size_t len{};
+        rc = pldm_transport_loopback_recv(fd, src, msg, len);
+        if (rc == PLDM_REQUESTER_RECV_FAIL)
+        {
+            return rc;
+        }
+        if (rc != PLDM_REQUESTER_SUCCESS)
+        {
+            continue;
+        }
+
+        /* Drop anything that is not the response to this request */
+        auto hdr = static_cast<const pldm_msg_hdr*>(msg);
+        if (src == tid && !hdr->request &&
+            hdr->instance_id == req->instance_id && hdr->type == req->type &&
+            hdr->command == req->command)
+        {
+            rx = msg;
+            rxLen = len;
+            return PLDM_REQUESTER_SUCCESS;
+        }
+        free(msg);
+    }
+}
+
 struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd)
 {
 #if defined(PLDM_TRANSPORT_WITH_MCTP_DEMUX)
@@ -129,8 +270,35 @@ PldmTransport::PldmTransport()
     }
 }
 
+PldmTransport::PldmTransport(int fd) :
+    pfd{fd, POLLIN, 0}, impl{}, transport(nullptr)
+{
+    if (fd < 0)
+    {
+        throw std::system_error(EBADF, std::generic_category());
+    }
+
+    int type = 0;
+    socklen_t typeLen = sizeof(type);
+    if (getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &typeLen))
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+    if (type != SOCK_SEQPACKET)
+    {
+        throw std::system_error(EPROTOTYPE, std::generic_category());
+    }
+
+    loopbackFd = fd;
+}
+
 PldmTransport::~PldmTransport()
 {
+    if (loopbackFd >= 0)
+    {
+        close(loopbackFd);
+        return;
+    }
     transport_impl_destroy(impl);
 }
 
@@ -142,17 +310,30 @@ int PldmTransport::getEventSource() const
 pldm_requester_rc_t PldmTransport::sendMsg(pldm_tid_t tid, const void* tx,
                                            size_t len)
 {
+    if (loopbackFd >= 0)
+    {
+        return pldm_transport_loopback_send(loopbackFd, tid, tx, len);
+    }
     return pldm_transport_send_msg(transport, tid, tx, len);
 }
 
 pldm_requester_rc_t PldmTransport::recvMsg(pldm_tid_t& tid, void*& rx,
                                            size_t& len)
 {
+    if (loopbackFd >= 0)
+    {
+        return pldm_transport_loopback_recv(loopbackFd, tid, rx, len);
+    }
     return pldm_transport_recv_msg(transport, &tid, (void**)&rx, &len);
 }
 
 pldm_requester_rc_t PldmTransport::sendRecvMsg(
     pldm_tid_t tid, const void* tx, size_t txLen, void*& rx, size_t& rxLen)
 {
+    if (loopbackFd >= 0)
+    {
+        return pldm_transport_loopback_send_recv(loopbackFd, tid, tx, txLen,
+                                                 rx, rxLen);
+    }
     return pldm_transport_send_recv_msg(transport, tid, tx, txLen, &rx, &rxLen);
 }
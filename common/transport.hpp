@@ -20,6 +20,19 @@ class PldmTransport
 {
   public:
     PldmTransport();
+
+    /** @brief Create a loopback transport over a connected SOCK_SEQPACKET
+     *         socket, taking ownership of it. Every packet carries the TID of
+     *         the remote terminus followed by the PLDM message. It lets the
+     *         daemon be exercised against a fake terminus without MCTP.
+     *
+     *  @param[in] fd - connected socket, the peer end acts as the terminus
+     *
+     *  @throw std::system_error if fd is not a SOCK_SEQPACKET socket, it is
+     *         left to the caller then
+     */
+    explicit PldmTransport(int fd);
+
     PldmTransport(const PldmTransport& other) = delete;
     PldmTransport(const PldmTransport&& other) = delete;
     PldmTransport& operator=(const PldmTransport& other) = delete;
@@ -103,4 +116,9 @@ class PldmTransport
      *         PLDM messages.
      */
     struct pldm_transport* transport;
+
+    /** @brief Socket of the loopback transport, -1 for the libpldm
+     *         transports
+     */
+    int loopbackFd = -1;
 };
@@ -363,6 +363,23 @@ class DBusHandler : public DBusHandlerInterface
             inventoryManager::interface, inventoryPath);
         return object;
     }
+
+    /**
+     *  @brief Refetch the inventory objects, after FRUs were added or removed,
+     *  and update the cache returned by getInventoryObjects.
+     *
+     *  @tparam ClassType - The class type that manages the inventory objects.
+     *
+     *  @return A reference to the cached inventory objects.
+     */
+    template <typename ClassType>
+    static auto& refreshInventoryObjects()
+    {
+        auto& object = getInventoryObjects<ClassType>();
+        object = ClassType::getManagedObj(inventoryManager::interface,
+                                          inventoryPath);
+        return object;
+    }
 };
 
 /** @brief Fetch parent D-Bus object based on pathname
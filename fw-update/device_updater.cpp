@@ -57,7 +57,8 @@ void DeviceUpdater::startFwUpdateFlow()
 
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_REQUEST_UPDATE, std::move(request),
-        std::bind_front(&DeviceUpdater::requestUpdate, this));
+        std::bind_front(&DeviceUpdater::requestUpdate, this),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         // Handle error scenario
@@ -186,7 +187,8 @@ void DeviceUpdater::sendPassCompTableRequest(size_t offset)
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_PASS_COMPONENT_TABLE,
         std::move(request),
-        std::bind_front(&DeviceUpdater::passCompTable, this));
+        std::bind_front(&DeviceUpdater::passCompTable, this),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         // Handle error scenario
@@ -317,7 +319,8 @@ void DeviceUpdater::sendUpdateComponentRequest(size_t offset)
 
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_UPDATE_COMPONENT, std::move(request),
-        std::bind_front(&DeviceUpdater::updateComponent, this));
+        std::bind_front(&DeviceUpdater::updateComponent, this),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         // Handle error scenario
@@ -669,7 +672,8 @@ void DeviceUpdater::sendActivateFirmwareRequest()
 
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_ACTIVATE_FIRMWARE, std::move(request),
-        std::bind_front(&DeviceUpdater::activateFirmware, this));
+        std::bind_front(&DeviceUpdater::activateFirmware, this),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         error(
@@ -8,9 +8,15 @@ void CustomDBus::setLocationCode(const std::string& path, std::string value)
 {
     if (!location.contains(path))
     {
-        location.emplace(path,
-                         std::make_unique<LocationIntf>(
-                             pldm::utils::DBusHandler::getBus(), path.c_str()));
+        // A new interface is announced with its value, in a single
+        // InterfacesAdded signal
+        auto intf = std::make_unique<LocationIntf>(
+            pldm::utils::DBusHandler::getBus(), path.c_str(),
+            LocationIntf::action::defer_emit);
+        intf->locationCode(value, true);
+        intf->emit_object_added();
+        location.emplace(path, std::move(intf));
+        return;
     }
 
     location.at(path)->locationCode(value);
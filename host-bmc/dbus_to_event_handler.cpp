@@ -68,7 +68,8 @@ void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
 
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
-        std::move(requestMsg), std::move(platformEventMessageResponseHandler));
+        std::move(requestMsg), std::move(platformEventMessageResponseHandler),
+        pldm::requester::RequestPriority::Event);
     if (rc)
     {
         error("Failed to send the platform event message, response code '{RC}'",
@@ -585,7 +585,8 @@ int HostEffecterParser::setTerminusNumericEffecter(
 
     rc = handler->registerRequest(
         mctpEid, instanceId, PLDM_PLATFORM, PLDM_SET_NUMERIC_EFFECTER_VALUE,
-        std::move(requestMsg), std::move(setNumericEffecterRespHandler));
+        std::move(requestMsg), std::move(setNumericEffecterRespHandler),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         error("Failed to send request to set an effecter on Host");
@@ -651,7 +652,8 @@ int HostEffecterParser::setHostStateEffecter(
 
     rc = handler->registerRequest(
         mctpEid, instanceId, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES,
-        std::move(requestMsg), std::move(setStateEffecterStatesRespHandler));
+        std::move(requestMsg), std::move(setStateEffecterStatesRespHandler),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         error(
@@ -13,8 +13,9 @@
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/time.hpp>
 
-#include <cassert>
 #include <fstream>
+#include <limits>
+#include <tuple>
 #include <type_traits>
 
 PHOSPHOR_LOG2_USING;
@@ -89,7 +90,7 @@ HostPDRHandler::HostPDRHandler(
     pldm_entity_association_tree* bmcEntityTree,
     pldm::InstanceIdDb& instanceIdDb,
     pldm::requester::Handler<pldm::requester::Request>* handler) :
-    mctp_eid(mctp_eid), event(event), repo(repo),
+    mctp_eid(mctp_eid), event(event), repo(repo), pdrRepo(repo),
     stateSensorHandler(eventsJsonsDir), entityTree(entityTree),
     instanceIdDb(instanceIdDb), handler(handler),
     entityMaps(parseEntityMap(ENTITY_MAP_JSON)), oemUtilsHandler(nullptr)
@@ -99,7 +100,7 @@ HostPDRHandler::HostPDRHandler(
         pldm::utils::DBusHandler::getBus(),
         propertiesChanged("/xyz/openbmc_project/state/host0",
                           "xyz.openbmc_project.State.Host"),
-        [this, repo, entityTree, bmcEntityTree](sdbusplus::message_t& msg) {
+        [this, entityTree, bmcEntityTree](sdbusplus::message_t& msg) {
             DbusChangedProps props{};
             std::string intf;
             msg.read(intf, props);
@@ -115,7 +116,11 @@ HostPDRHandler::HostPDRHandler(
                         const auto& [key, value] = item;
                         return key != TERMINUS_HANDLE;
                     });
-                    pldm_pdr_remove_remote_pdrs(repo);
+                    this->pdrRepo.removeRemoteRecords();
+                    // The host refetches the whole repo when it comes back
+                    this->changeJournal.clear();
+                    this->lastNotifiedChangeNumber =
+                        this->changeJournal.getChangeNumber();
                     pldm_entity_association_tree_destroy_root(entityTree);
                     pldm_entity_association_tree_copy_root(bmcEntityTree,
                                                            entityTree);
@@ -149,6 +154,46 @@ void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles)
                          std::placeholders::_1));
 }
 
+void HostPDRHandler::deletePDR(const PDRRecordHandles& recordHandles)
+{
+    for (const auto& recordHandle : recordHandles)
+    {
+        uint8_t* data = nullptr;
+        uint32_t size{};
+        uint32_t nextRecordHandle{};
+        auto record = pldm_pdr_find_record(repo, recordHandle, &data, &size,
+                                           &nextRecordHandle);
+        if (!record || !pldm_pdr_record_is_remote(record))
+        {
+            continue;
+        }
+
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(data);
+        if (pdrHdr->type == PLDM_STATE_SENSOR_PDR)
+        {
+            std::vector<uint8_t> pdr(data, data + size);
+            const auto& [terminusHandle, sensorID, sensorInfo] =
+                responder::pdr_utils::parseStateSensorPDR(pdr);
+            std::erase_if(sensorMap, [&](const auto& item) {
+                return item.first.sensorID == sensorID &&
+                       tlPDRInfo.contains(terminusHandle) &&
+                       item.first.terminusID ==
+                           std::get<0>(tlPDRInfo.at(terminusHandle));
+            });
+        }
+
+        auto rc = pdrRepo.removeRecord(recordHandle, true);
+        if (rc)
+        {
+            error(
+                "Failed to delete host PDR with record handle '{RECORD_HANDLE}', response code '{RC}'",
+                "RECORD_HANDLE", recordHandle, "RC", rc);
+            continue;
+        }
+        changeJournal.record(PLDM_RECORDS_DELETED, recordHandle);
+    }
+}
+
 void HostPDRHandler::_fetchPDR(sdeventplus::source::EventBase& /*source*/)
 {
     getHostPDR();
@@ -193,7 +238,8 @@ void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_GET_PDR,
         std::move(requestMsg),
-        std::bind_front(&HostPDRHandler::processHostPDRs, this));
+        std::bind_front(&HostPDRHandler::processHostPDRs, this),
+        pldm::requester::RequestPriority::Bulk);
     if (rc)
     {
         error(
@@ -228,9 +274,24 @@ void HostPDRHandler::mergeEntityAssociations(
     if (oemPlatformHandler &&
         oemPlatformHandler->checkRecordHandleInRange(record_handle))
     {
-        // Adding the remote range PDRs to the repo before merging it
-        uint32_t handle = record_handle;
-        pldm_pdr_add(repo, pdr.data(), size, true, 0xFFFF, &handle);
+        // Adding the remote range PDRs to the repo before merging it, a
+        // record the host modified replaces the one fetched before
+        uint8_t operation = PLDM_RECORDS_ADDED;
+        uint8_t* data = nullptr;
+        uint32_t dataSize{};
+        uint32_t nextRecordHandle{};
+        if (pldm_pdr_find_record(repo, record_handle, &data, &dataSize,
+                                 &nextRecordHandle) &&
+            !pdrRepo.removeRecord(record_handle, true))
+        {
+            operation = PLDM_RECORDS_MODIFIED;
+        }
+        responder::pdr_utils::PdrEntry pdrEntry{};
+        pdrEntry.data = const_cast<uint8_t*>(pdr.data());
+        pdrEntry.size = size;
+        pdrEntry.handle.recordHandle = record_handle;
+        auto handle = pdrRepo.addRemoteRecord(pdrEntry, 0xFFFF);
+        changeJournal.record(operation, handle);
     }
 
     pldm_entity_association_pdr_extract(pdr.data(), pdr.size(), &numEntities,
@@ -294,22 +355,35 @@ void HostPDRHandler::mergeEntityAssociations(
         else
         {
             int rc = 0;
+            uint32_t newRecordHandle = 0;
             if (oemPlatformHandler)
             {
                 auto record = oemPlatformHandler->fetchLastBMCRecord(repo);
 
                 uint32_t record_handle =
                     pldm_pdr_get_record_handle(repo, record);
+                newRecordHandle = record_handle + 1;
 
-                rc =
-                    pldm_entity_association_pdr_add_from_node_with_record_handle(
-                        node, repo, &entities, numEntities, true,
-                        TERMINUS_HANDLE, (record_handle + 1));
+                rc = pdrRepo.addRecords([&](pldm_pdr* bmcRepo) {
+                    return pldm_entity_association_pdr_add_from_node_with_record_handle(
+                        node, bmcRepo, &entities, numEntities, true,
+                        TERMINUS_HANDLE, newRecordHandle);
+                });
             }
             else
             {
-                rc = pldm_entity_association_pdr_add_from_node(
-                    node, repo, &entities, numEntities, true, TERMINUS_HANDLE);
+                rc = pdrRepo.addRecords([&](pldm_pdr* bmcRepo) {
+                    return pldm_entity_association_pdr_add_from_node(
+                        node, bmcRepo, &entities, numEntities, true,
+                        TERMINUS_HANDLE);
+                });
+                if (!rc)
+                {
+                    // The merged PDR is appended to the end of the repo
+                    auto record = pldm_pdr_find_last_in_range(
+                        repo, 0, std::numeric_limits<uint32_t>::max());
+                    newRecordHandle = pldm_pdr_get_record_handle(repo, record);
+                }
             }
 
             if (rc)
@@ -318,69 +392,44 @@ void HostPDRHandler::mergeEntityAssociations(
                     "Failed to add entity association PDR from node, response code '{RC}'",
                     "RC", rc);
             }
+            else
+            {
+                changeJournal.record(PLDM_RECORDS_ADDED, newRecordHandle);
+            }
         }
     }
     free(entities);
 }
 
-void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
-                                               uint8_t eventDataFormat)
+void HostPDRHandler::sendPDRRepositoryChgEvent()
 {
-    assert(eventDataFormat == FORMAT_IS_PDR_HANDLES);
-
-    // Extract from the PDR repo record handles of PDRs we want the host
-    // to pull up.
-    std::vector<uint8_t> eventDataOps{PLDM_RECORDS_ADDED};
-    std::vector<uint8_t> numsOfChangeEntries(1);
-    std::vector<std::vector<ChangeEntry>> changeEntries(
-        numsOfChangeEntries.size());
-    for (auto pdrType : pdrTypes)
-    {
-        const pldm_pdr_record* record{};
-        do
-        {
-            record = pldm_pdr_find_record_by_type(repo, pdrType, record,
-                                                  nullptr, nullptr);
-            if (record && pldm_pdr_record_is_remote(record))
-            {
-                changeEntries[0].push_back(
-                    pldm_pdr_get_record_handle(repo, record));
-            }
-        } while (record);
-    }
-    if (changeEntries.empty())
+    auto changeNumber = changeJournal.getChangeNumber();
+    if (changeNumber == lastNotifiedChangeNumber)
     {
         return;
     }
-    numsOfChangeEntries[0] = changeEntries[0].size();
-
-    // Encode PLDM platform event msg to indicate a PDR repo change.
-    size_t maxSize = PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH +
-                     PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
-                     changeEntries[0].size() * sizeof(uint32_t);
-    std::vector<uint8_t> eventDataVec{};
-    eventDataVec.resize(maxSize);
-    auto eventData =
-        reinterpret_cast<struct pldm_pdr_repository_chg_event_data*>(
-            eventDataVec.data());
-    size_t actualSize{};
-    auto firstEntry = changeEntries[0].data();
-    auto rc = encode_pldm_pdr_repository_chg_event_data(
-        eventDataFormat, 1, eventDataOps.data(), numsOfChangeEntries.data(),
-        &firstEntry, eventData, &actualSize, maxSize);
-    if (rc != PLDM_SUCCESS)
+
+    // The journal is only trimmed once the host acknowledged the event, a
+    // change that failed to be sent goes out with the next event
+    auto changeSet = changeJournal.getChangesSince(lastNotifiedChangeNumber);
+    sendPDRRepositoryChgEventData(encodeChangeSet(changeSet), changeNumber);
+}
+
+void HostPDRHandler::sendPDRRepositoryChgEventData(
+    std::vector<uint8_t>&& eventDataVec, uint32_t changeNumber)
+{
+    if (eventDataVec.empty())
     {
-        error(
-            "Failed to encode pldm pdr repository change event data, response code '{RC}'",
-            "RC", rc);
         return;
     }
+
+    size_t actualSize = eventDataVec.size();
     auto instanceId = instanceIdDb.next(mctp_eid);
     std::vector<uint8_t> requestMsg(
         sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
         actualSize);
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-    rc = encode_platform_event_message_req(
+    auto rc = encode_platform_event_message_req(
         instanceId, 1, TERMINUS_ID, PLDM_PDR_REPOSITORY_CHG_EVENT,
         eventDataVec.data(), actualSize, request,
         actualSize + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES);
@@ -393,9 +442,9 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
         return;
     }
 
-    auto platformEventMessageResponseHandler = [](mctp_eid_t /*eid*/,
-                                                  const pldm_msg* response,
-                                                  size_t respMsgLen) {
+    auto platformEventMessageResponseHandler =
+        [this, changeNumber](mctp_eid_t /*eid*/, const pldm_msg* response,
+                             size_t respMsgLen) {
         if (response == nullptr || !respMsgLen)
         {
             error(
@@ -413,12 +462,22 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
             error(
                 "Failed to decode platform event message response, response code '{RC}' and completion code '{CC}'",
                 "RC", rc, "CC", completionCode);
+            return;
+        }
+
+        // An event acknowledged after a later one, or after the host went
+        // off and the journal was cleared, trims nothing
+        if (changeNumber > lastNotifiedChangeNumber)
+        {
+            lastNotifiedChangeNumber = changeNumber;
+            changeJournal.trim(changeNumber);
         }
     };
 
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
-        std::move(requestMsg), std::move(platformEventMessageResponseHandler));
+        std::move(requestMsg), std::move(platformEventMessageResponseHandler),
+        pldm::requester::RequestPriority::Event);
     if (rc)
     {
         error(
@@ -601,6 +660,7 @@ void HostPDRHandler::processHostPDRs(
                 // if the TLPDR is invalid update the repo accordingly
                 if (!tlValid)
                 {
+                    // Updated in place, the indexed record stays valid
                     pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid,
                                            tlValid);
 
@@ -614,13 +674,11 @@ void HostPDRHandler::processHostPDRs(
                 }
                 else
                 {
-                    rc = pldm_pdr_add(repo, pdr.data(), respCount, true,
-                                      pdrTerminusHandle, &rh);
-                    if (rc)
-                    {
-                        // pldm_pdr_add() assert()ed on failure to add a PDR.
-                        throw std::runtime_error("Failed to add PDR");
-                    }
+                    responder::pdr_utils::PdrEntry pdrEntry{};
+                    pdrEntry.data = pdr.data();
+                    pdrEntry.size = respCount;
+                    pdrEntry.handle.recordHandle = rh;
+                    rh = pdrRepo.addRemoteRecord(pdrEntry, pdrTerminusHandle);
                 }
             }
         }
@@ -677,9 +735,7 @@ void HostPDRHandler::_processPDRRepoChgEvent(
     sdeventplus::source::EventBase& /*source */)
 {
     deferredPDRRepoChgEvent.reset();
-    this->sendPDRRepositoryChgEvent(
-        std::vector<uint8_t>(1, PLDM_PDR_ENTITY_ASSOCIATION),
-        FORMAT_IS_PDR_HANDLES);
+    this->sendPDRRepositoryChgEvent();
 }
 
 void HostPDRHandler::_processFetchPDREvent(
@@ -972,7 +1028,8 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_FRU, PLDM_GET_FRU_RECORD_TABLE_METADATA,
         std::move(requestMsg),
-        std::move(getFruRecordTableMetadataResponseHandler));
+        std::move(getFruRecordTableMetadataResponseHandler),
+        pldm::requester::RequestPriority::Bulk);
     if (rc != PLDM_SUCCESS)
     {
         error(
@@ -986,7 +1043,9 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
 void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
                                                uint16_t totalTableRecords)
 {
-    fruRecordData.clear();
+    ++remoteFRUTable.id;
+    remoteFRUTable.pending.clear();
+    remoteFRUTable.objectsByRSI.clear();
 
     if (!totalTableRecords)
     {
@@ -994,6 +1053,38 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
         return;
     }
 
+    // Index the FRU record sets by entity, then the objects by FRU record
+    // set, so the records are matched to their objects as they arrive
+    std::map<std::tuple<uint16_t, uint16_t, uint16_t>, uint16_t> rsiByEntity;
+    for (const auto& pdr : fruRecordSetPDRs)
+    {
+        auto fruPdr = reinterpret_cast<const pldm_pdr_fru_record_set*>(
+            pdr.data() + sizeof(pldm_pdr_hdr));
+        rsiByEntity.emplace(std::tuple(fruPdr->entity_type,
+                                       fruPdr->entity_instance,
+                                       fruPdr->container_id),
+                            fruPdr->fru_rsi);
+    }
+    for (const auto& [path, node] : objPathMap)
+    {
+        pldm_entity entity = pldm_entity_extract(node);
+        auto rsi = rsiByEntity.find(std::tuple(entity.entity_type,
+                                               entity.entity_instance_num,
+                                               entity.entity_container_id));
+        if (rsi != rsiByEntity.end())
+        {
+            remoteFRUTable.objectsByRSI[rsi->second].emplace_back(
+                path.string());
+        }
+    }
+
+    remoteFRUTable.recordsLeft = totalTableRecords;
+    getFRURecordTablePart(0, PLDM_GET_FIRSTPART);
+}
+
+void HostPDRHandler::getFRURecordTablePart(uint32_t dataTransferHandle,
+                                           uint8_t transferOpFlag)
+{
     auto instanceId = instanceIdDb.next(mctp_eid);
     std::vector<uint8_t> requestMsg(
         sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
@@ -1001,7 +1092,7 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
     // send the getFruRecordTable command
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
     auto rc = encode_get_fru_record_table_req(
-        instanceId, 0, PLDM_GET_FIRSTPART, request,
+        instanceId, dataTransferHandle, transferOpFlag, request,
         requestMsg.size() - sizeof(pldm_msg_hdr));
     if (rc != PLDM_SUCCESS)
     {
@@ -1012,16 +1103,20 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
         return;
     }
 
-    auto getFruRecordTableResponseHandler = [totalTableRecords, this,
-                                             fruRecordSetPDRs](
-                                                mctp_eid_t /*eid*/,
-                                                const pldm_msg* response,
-                                                size_t respMsgLen) {
+    auto getFruRecordTableResponseHandler =
+        [this, transferId = remoteFRUTable.id,
+         dataTransferHandle](mctp_eid_t /*eid*/, const pldm_msg* response,
+                             size_t respMsgLen) {
         if (response == nullptr || !respMsgLen)
         {
             error("Failed to receive response for the get fru record table");
             return;
         }
+        if (transferId != remoteFRUTable.id)
+        {
+            // the table is being fetched again
+            return;
+        }
 
         uint8_t cc = 0;
         uint32_t next_data_transfer_handle = 0;
@@ -1043,85 +1138,109 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
             return;
         }
 
-        fruRecordData = responder::pdr_utils::parseFruRecordTable(
-            fru_record_table_data.data(), fru_record_table_length);
-
-        if (totalTableRecords != fruRecordData.size())
+        // Publish the records of the part, a record cut at the end of the
+        // part is completed by the next one
+        auto& pending = remoteFRUTable.pending;
+        pending.insert(pending.end(), fru_record_table_data.begin(),
+                       fru_record_table_data.begin() +
+                           fru_record_table_length);
+        std::vector<responder::pdr_utils::FruRecordDataFormat> records;
+        auto parsed = responder::pdr_utils::parseFruRecords(
+            pending, remoteFRUTable.recordsLeft, records);
+        pending.erase(pending.begin(), pending.begin() + parsed);
+        remoteFRUTable.recordsLeft -= records.size();
+        this->setFRUDataOnDBus(records);
+
+        if (!remoteFRUTable.recordsLeft)
         {
-            fruRecordData.clear();
+            // what is left is the pad bytes and the checksum
+            pending.clear();
+            return;
+        }
 
-            error("Failed to parse fru record data format.");
+        if ((transfer_flag == PLDM_START || transfer_flag == PLDM_MIDDLE) &&
+            next_data_transfer_handle != dataTransferHandle)
+        {
+            this->getFRURecordTablePart(next_data_transfer_handle,
+                                        PLDM_GET_NEXTPART);
             return;
         }
 
-        this->setFRUDataOnDBus(fruRecordSetPDRs, fruRecordData);
+        error(
+            "Failed to parse fru record data format, '{COUNT}' records missing",
+            "COUNT", remoteFRUTable.recordsLeft);
+        pending.clear();
     };
 
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_FRU, PLDM_GET_FRU_RECORD_TABLE,
-        std::move(requestMsg), std::move(getFruRecordTableResponseHandler));
+        std::move(requestMsg), std::move(getFruRecordTableResponseHandler),
+        pldm::requester::RequestPriority::Bulk);
     if (rc != PLDM_SUCCESS)
     {
         error("Failed to send the the set state effecter states request");
     }
 }
 
-std::optional<uint16_t> HostPDRHandler::getRSI(const PDRList& fruRecordSetPDRs,
-                                               const pldm_entity& entity)
-{
-    for (const auto& pdr : fruRecordSetPDRs)
-    {
-        auto fruPdr = reinterpret_cast<const pldm_pdr_fru_record_set*>(
-            const_cast<uint8_t*>(pdr.data()) + sizeof(pldm_pdr_hdr));
-
-        if (fruPdr->entity_type == entity.entity_type &&
-            fruPdr->entity_instance == entity.entity_instance_num &&
-            fruPdr->container_id == entity.entity_container_id)
-        {
-            return fruPdr->fru_rsi;
-        }
-    }
-
-    return std::nullopt;
-}
-
 void HostPDRHandler::setFRUDataOnDBus(
-    [[maybe_unused]] const PDRList& fruRecordSetPDRs,
     [[maybe_unused]] const std::vector<
         responder::pdr_utils::FruRecordDataFormat>& fruRecordData)
 {
 #ifdef OEM_IBM
-    for (const auto& entity : objPathMap)
+    for (const auto& data : fruRecordData)
     {
-        pldm_entity node = pldm_entity_extract(entity.second);
-        auto fruRSI = getRSI(fruRecordSetPDRs, node);
-
-        for (const auto& data : fruRecordData)
+        auto objects = remoteFRUTable.objectsByRSI.find(data.fruRSI);
+        if (objects == remoteFRUTable.objectsByRSI.end() ||
+            data.fruRecType != PLDM_FRU_RECORD_TYPE_OEM)
         {
-            if (!fruRSI || *fruRSI != data.fruRSI)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            if (data.fruRecType == PLDM_FRU_RECORD_TYPE_OEM)
+        for (const auto& tlv : data.fruTLV)
+        {
+            if (tlv.fruFieldType == PLDM_OEM_FRU_FIELD_TYPE_LOCATION_CODE)
             {
-                for (const auto& tlv : data.fruTLV)
+                std::string locationCode(
+                    reinterpret_cast<const char*>(tlv.fruFieldValue.data()),
+                    tlv.fruFieldLen);
+                for (const auto& path : objects->second)
                 {
-                    if (tlv.fruFieldType ==
-                        PLDM_OEM_FRU_FIELD_TYPE_LOCATION_CODE)
-                    {
-                        CustomDBus::getCustomDBus().setLocationCode(
-                            entity.first,
-                            std::string(reinterpret_cast<const char*>(
-                                            tlv.fruFieldValue.data()),
-                                        tlv.fruFieldLen));
-                    }
+                    pendingLocationCodes[path] = locationCode;
                 }
             }
         }
     }
+
+    if (!pendingLocationCodes.empty() && !deferredFRUPublishEvent)
+    {
+        deferredFRUPublishEvent = std::make_unique<sdeventplus::source::Defer>(
+            event, std::bind(std::mem_fn(&HostPDRHandler::publishFRUData),
+                             this, std::placeholders::_1));
+    }
 #endif
 }
+
+void HostPDRHandler::publishFRUData(
+    sdeventplus::source::EventBase& /*source */)
+{
+    // The deferred source runs again on the next event loop iteration, after
+    // the other events, until every object is published
+    auto it = pendingLocationCodes.begin();
+    for (size_t count = 0;
+         count < fruPublishBatchSize && it != pendingLocationCodes.end();
+         ++count)
+    {
+        CustomDBus::getCustomDBus().setLocationCode(it->first,
+                                                    std::move(it->second));
+        it = pendingLocationCodes.erase(it);
+    }
+
+    if (pendingLocationCodes.empty())
+    {
+        deferredFRUPublishEvent.reset();
+    }
+}
+
 void HostPDRHandler::createDbusObjects(const PDRList& fruRecordSetPDRs)
 {
     // TODO: Creating and Refreshing dbus hosted by remote PLDM entity Fru PDRs
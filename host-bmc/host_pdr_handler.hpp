@@ -5,6 +5,7 @@
 #include "common/utils.hpp"
 #include "libpldmresponder/event_parser.hpp"
 #include "libpldmresponder/oem_handler.hpp"
+#include "libpldmresponder/pdr_change_journal.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "requester/handler.hpp"
 #include "utils.hpp"
@@ -104,14 +105,28 @@ class HostPDRHandler
 
     void fetchPDR(PDRRecordHandles&& recordHandles);
 
-    /** @brief Send a PLDM event to host firmware containing a list of record
-     *  handles of PDRs that the host firmware has to fetch.
-     *  @param[in] pdrTypes - list of PDR types that need to be looked up in the
-     *                        BMC repo
-     *  @param[in] eventDataFormat - format for PDRRepositoryChgEvent in DSP0248
+    /** @brief delete the host PDRs that the host firmware reported as deleted
+     *         in a PDR repository change event
+     *  @param[in] recordHandles - list of record handles pointing to host's
+     *             PDRs that need to be removed from the BMC's repo.
+     */
+    void deletePDR(const PDRRecordHandles& recordHandles);
+
+    /** @brief Send a PLDM event to host firmware containing the records
+     *  added, deleted and modified in the BMC repo since the last event, as
+     *  tracked by the change journal.
      */
-    void sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
-                                   uint8_t eventDataFormat);
+    void sendPDRRepositoryChgEvent();
+
+    /** @brief Get the journal of changes made to the BMC repo that the host
+     *  firmware has to be notified about
+     *
+     *  @return reference to the change journal
+     */
+    responder::pdr_utils::ChangeJournal& getChangeJournal()
+    {
+        return changeJournal;
+    }
 
     /** @brief Lookup host sensor info corresponding to requested SensorEntry
      *
@@ -218,6 +233,15 @@ class HostPDRHandler
     void processHostPDRs(mctp_eid_t eid, const pldm_msg* response,
                          size_t respMsgLen);
 
+    /** @brief Encode and send a PDR repository change event to the host
+     *  @param[in] eventDataVec - encoded PDR repository change event data
+     *  @param[in] changeNumber - change number of the last journalled change
+     *             in the event, the journal is trimmed to it once the host
+     *             acknowledged the event
+     */
+    void sendPDRRepositoryChgEventData(std::vector<uint8_t>&& eventDataVec,
+                                       uint32_t changeNumber);
+
     /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
      *  @param[in] source - sdeventplus event source
      */
@@ -236,17 +260,23 @@ class HostPDRHandler
      */
     void getFRURecordTableMetadataByRemote(const PDRList& fruRecordSetPDRs);
 
-    /** @brief Set Location Code in the dbus objects
+    /** @brief Queue the Location Code of the dbus objects of FRU records
+     *         received from the remote PLDM terminus, to be published by
+     *         publishFRUData
      *
-     *  @param[in] fruRecordSetPDRs - the Fru Record set PDR's
      *  @param[in] fruRecordData - the Fru Record Data
      */
-
     void setFRUDataOnDBus(
-        const PDRList& fruRecordSetPDRs,
         const std::vector<responder::pdr_utils::FruRecordDataFormat>&
             fruRecordData);
 
+    /** @brief Publish a batch of the queued FRU properties on D-Bus, one
+     *         batch per event loop iteration
+     *
+     *  @param[in] source - sdeventplus event source
+     */
+    void publishFRUData(sdeventplus::source::EventBase& source);
+
     /** @brief Get FRU record table by remote PLDM terminus
      *
      *  @param[in] fruRecordSetPDRs  - the Fru Record set PDR's
@@ -256,6 +286,16 @@ class HostPDRHandler
     void getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
                                    uint16_t totalTableRecords);
 
+    /** @brief Get a part of the FRU record table by remote PLDM terminus, the
+     *         records of the part are published before the next part is
+     *         requested
+     *
+     *  @param[in] dataTransferHandle - data transfer handle of the part
+     *  @param[in] transferOpFlag - PLDM_GET_FIRSTPART or PLDM_GET_NEXTPART
+     */
+    void getFRURecordTablePart(uint32_t dataTransferHandle,
+                               uint8_t transferOpFlag);
+
     /** @brief Create Dbus objects by remote PLDM entity Fru PDRs
      *
      *  @param[in] fruRecordSetPDRs - fru record set pdr
@@ -264,14 +304,6 @@ class HostPDRHandler
      */
     void createDbusObjects(const PDRList& fruRecordSetPDRs);
 
-    /** @brief Get FRU Record Set Identifier from FRU Record data Format
-     *  @param[in] fruRecordSetPDRs - fru record set pdr
-     *  @param[in] entity           - PLDM entity information
-     *  @return
-     */
-    std::optional<uint16_t> getRSI(const PDRList& fruRecordSetPDRs,
-                                   const pldm_entity& entity);
-
     /** @brief MCTP EID of host firmware */
     uint8_t mctp_eid;
     /** @brief reference of main event loop of pldmd, primarily used to schedule
@@ -280,6 +312,10 @@ class HostPDRHandler
     sdeventplus::Event& event;
     /** @brief pointer to BMC's primary PDR repo, host PDRs are added here */
     pldm_pdr* repo;
+    /** @brief wrapper of the BMC's primary PDR repo, through which the host
+     *  PDRs are added and removed
+     */
+    responder::pdr_utils::Repo pdrRepo;
 
     pldm::responder::events::StateSensorHandler stateSensorHandler;
     /** @brief Pointer to BMC's and Host's entity association tree */
@@ -297,6 +333,7 @@ class HostPDRHandler
     std::unique_ptr<sdeventplus::source::Defer> pdrFetchEvent;
     std::unique_ptr<sdeventplus::source::Defer> deferredFetchPDREvent;
     std::unique_ptr<sdeventplus::source::Defer> deferredPDRRepoChgEvent;
+    std::unique_ptr<sdeventplus::source::Defer> deferredFRUPublishEvent;
 
     /** @brief list of PDR record handles pointing to host's PDRs */
     PDRRecordHandles pdrRecordHandles;
@@ -307,6 +344,14 @@ class HostPDRHandler
     /** @brief list of PDR record handles modified pointing to host PDRs */
     PDRRecordHandles modifiedPDRRecordHandles;
 
+    /** @brief journal of the changes made to the BMC repo, used to notify
+     *  the host of just the records that changed
+     */
+    responder::pdr_utils::ChangeJournal changeJournal;
+
+    /** @brief change number of the last change the host acknowledged */
+    uint32_t lastNotifiedChangeNumber = 0;
+
     /** @brief D-Bus property changed signal match */
     std::unique_ptr<sdbusplus::bus::match_t> hostOffMatch;
 
@@ -333,9 +378,38 @@ class HostPDRHandler
      */
     pldm::utils::EntityAssociations entityAssociations;
 
-    /** @brief the vector of FRU Record Data Format
+    /** @struct RemoteFRUTable
+     *  @brief State of the transfer of the FRU record table of the remote
+     *         PLDM terminus
      */
-    std::vector<responder::pdr_utils::FruRecordDataFormat> fruRecordData;
+    struct RemoteFRUTable
+    {
+        /** @brief object paths of the entities of each FRU record set */
+        std::map<uint16_t, std::vector<std::string>> objectsByRSI;
+        /** @brief number of records not received yet */
+        size_t recordsLeft = 0;
+        /** @brief data received and not parsed yet, the start of a record
+         *         cut at the end of a part
+         */
+        std::vector<uint8_t> pending;
+        /** @brief incremented for each transfer, so the responses of an
+         *         abandoned transfer are dropped
+         */
+        uint32_t id = 0;
+    };
+
+    /** @brief the transfer of the FRU record table of the host */
+    RemoteFRUTable remoteFRUTable;
+
+    /** @brief Location Codes of the host FRUs waiting to be published, by
+     *         object path
+     */
+    std::map<std::string, std::string> pendingLocationCodes;
+
+    /** @brief number of objects whose FRU properties are published per event
+     *         loop iteration
+     */
+    static constexpr size_t fruPublishBatchSize = 32;
 
     /** @OEM platform handler */
     pldm::responder::oem_platform::Handler* oemPlatformHandler = nullptr;
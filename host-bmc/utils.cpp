@@ -4,6 +4,8 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace pldm::utils;
 
@@ -13,159 +15,166 @@ namespace hostbmc
 {
 namespace utils
 {
-Entities getParentEntites(const EntityAssociations& entityAssoc)
+namespace
 {
-    Entities parents{};
-    for (const auto& et : entityAssoc)
+
+/** @brief Key of an entity in the entity associations, its type, instance
+ *         number and remote container ID
+ */
+uint64_t entityKey(pldm_entity_node* node)
+{
+    pldm_entity entity = pldm_entity_extract(node);
+    return (uint64_t(entity.entity_type) << 32) |
+           (uint64_t(entity.entity_instance_num) << 16) |
+           pldm_entity_node_get_remote_container_id(node);
+}
+
+/** @class EntityPathBuilder
+ *
+ *  Builds the D-Bus object paths of the host entities in one walk of the
+ *  entity associations. The associations are indexed by their parent entity
+ *  and the inventory paths already on D-Bus are fetched with one mapper
+ *  call, instead of a lookup per entity.
+ */
+class EntityPathBuilder
+{
+  public:
+    EntityPathBuilder(
+        const EntityAssociations& entityAssoc, const EntityMaps& entityMaps,
+        ObjectPathMaps& objPathMap,
+        pldm::responder::oem_platform::Handler* oemPlatformHandler) :
+        entityMaps(entityMaps), objPathMap(objPathMap),
+        oemPlatformHandler(oemPlatformHandler)
     {
-        parents.push_back(et[0]);
+        for (const auto& ev : entityAssoc)
+        {
+            children[entityKey(ev[0])].push_back(&ev);
+        }
+
+        try
+        {
+            auto paths = pldm::utils::DBusHandler().getSubTreePaths(
+                inventoryPath, 0, {});
+            inventoryPaths.insert(paths.begin(), paths.end());
+        }
+        catch (const std::exception& e)
+        {
+            lg2::info(
+                "Failed to get the inventory object paths, error - {ERROR}",
+                "ERROR", e);
+        }
     }
 
-    bool found = false;
-    for (auto it = parents.begin(); it != parents.end();
-         it = found ? parents.erase(it) : std::next(it))
+    /** @brief The parent entities of the associations, the entities that
+     *         are not the child of another association
+     */
+    Entities getParentEntities(const EntityAssociations& entityAssoc) const
     {
-        uint16_t parent_contained_id =
-            pldm_entity_node_get_remote_container_id(*it);
-        found = false;
-        for (const auto& evs : entityAssoc)
+        std::unordered_set<uint64_t> childKeys{};
+        for (const auto& ev : entityAssoc)
         {
-            for (size_t i = 1; i < evs.size() && !found; i++)
+            for (size_t i = 1; i < ev.size(); i++)
             {
-                uint16_t node_contained_id =
-                    pldm_entity_node_get_remote_container_id(evs[i]);
-
-                pldm_entity parent_entity = pldm_entity_extract(*it);
-                pldm_entity node_entity = pldm_entity_extract(evs[i]);
-
-                if (node_entity.entity_type == parent_entity.entity_type &&
-                    node_entity.entity_instance_num ==
-                        parent_entity.entity_instance_num &&
-                    node_contained_id == parent_contained_id)
-                {
-                    found = true;
-                }
+                childKeys.insert(entityKey(ev[i]));
             }
-            if (found)
+        }
+
+        Entities parents{};
+        for (const auto& ev : entityAssoc)
+        {
+            if (!childKeys.contains(entityKey(ev[0])))
             {
-                break;
+                parents.push_back(ev[0]);
             }
         }
+        return parents;
     }
 
-    return parents;
-}
-
-void addObjectPathEntityAssociations(
-    const EntityAssociations& entityAssoc, pldm_entity_node* entity,
-    const fs::path& path, ObjectPathMaps& objPathMap, EntityMaps entityMaps,
-    pldm::responder::oem_platform::Handler* oemPlatformHandler)
-{
-    if (entity == nullptr)
-    {
-        return;
-    }
-
-    bool found = false;
-    pldm_entity node_entity = pldm_entity_extract(entity);
-    if (!entityMaps.contains(node_entity.entity_type))
+    /** @brief Add the object paths of an entity and of its descendants
+     *
+     *  @param[in] entity - the entity
+     *  @param[in] path - object path of the parent of the entity
+     */
+    void addObjectPaths(pldm_entity_node* entity, const fs::path& path)
     {
-        // entityMaps doesn't contain entity type which are not required to
-        // build entity object path, so returning from here because this is a
-        // expected behaviour
-        return;
-    }
-
-    std::string entityName = entityMaps.at(node_entity.entity_type);
-    for (const auto& ev : entityAssoc)
-    {
-        pldm_entity ev_entity = pldm_entity_extract(ev[0]);
-        if (ev_entity.entity_instance_num == node_entity.entity_instance_num &&
-            ev_entity.entity_type == node_entity.entity_type)
+        if (entity == nullptr)
         {
-            uint16_t node_contained_id =
-                pldm_entity_node_get_remote_container_id(ev[0]);
-            uint16_t entity_contained_id =
-                pldm_entity_node_get_remote_container_id(entity);
+            return;
+        }
 
-            if (node_contained_id != entity_contained_id)
-            {
-                continue;
-            }
+        pldm_entity node_entity = pldm_entity_extract(entity);
+        auto entityName = entityMaps.find(node_entity.entity_type);
+        if (entityName == entityMaps.end())
+        {
+            // entityMaps doesn't contain entity type which are not required
+            // to build entity object path, so returning from here because
+            // this is a expected behaviour
+            return;
+        }
 
-            fs::path p =
-                path /
-                fs::path{entityName +
-                         std::to_string(node_entity.entity_instance_num)};
-            std::string entity_path = p.string();
-            if (oemPlatformHandler)
-            {
-                oemPlatformHandler->updateOemDbusPaths(entity_path);
-            }
-            try
-            {
-                pldm::utils::DBusHandler().getService(entity_path.c_str(),
-                                                      nullptr);
-                // If the entity obtained from the remote PLDM terminal is not
-                // in the MAP, or there is no auxiliary name PDR, add it
-                // directly. Otherwise, check whether the DBus service of
-                // entity_path exists, and overwrite the entity if it does not
-                // exist.
-                if (objPathMap.contains(entity_path))
-                {
-                    objPathMap[entity_path] = entity;
-                }
-            }
-            catch (const std::exception&)
-            {
-                objPathMap[entity_path] = entity;
-            }
+        fs::path p = path /
+                     fs::path{entityName->second +
+                              std::to_string(node_entity.entity_instance_num)};
+        addObjectPath(p.string(), entity);
 
-            for (size_t i = 1; i < ev.size(); i++)
+        auto associations = children.find(entityKey(entity));
+        if (associations == children.end())
+        {
+            return;
+        }
+        for (const auto* ev : associations->second)
+        {
+            for (size_t i = 1; i < ev->size(); i++)
             {
-                addObjectPathEntityAssociations(entityAssoc, ev[i], p,
-                                                objPathMap, entityMaps,
-                                                oemPlatformHandler);
+                addObjectPaths((*ev)[i], p);
             }
-            found = true;
         }
     }
 
-    if (!found)
+  private:
+    void addObjectPath(std::string entityPath, pldm_entity_node* entity)
     {
-        std::string dbusPath =
-            path / fs::path{entityName +
-                            std::to_string(node_entity.entity_instance_num)};
         if (oemPlatformHandler)
         {
-            oemPlatformHandler->updateOemDbusPaths(dbusPath);
-        }
-        try
-        {
-            pldm::utils::DBusHandler().getService(dbusPath.c_str(), nullptr);
-            if (objPathMap.contains(dbusPath))
-            {
-                objPathMap[dbusPath] = entity;
-            }
+            oemPlatformHandler->updateOemDbusPaths(entityPath);
         }
-        catch (const std::exception&)
+        // If the entity obtained from the remote PLDM terminal is not in the
+        // MAP, or there is no auxiliary name PDR, add it directly. Otherwise,
+        // check whether the DBus service of entity_path exists, and overwrite
+        // the entity if it does not exist.
+        if (!inventoryPaths.contains(entityPath) ||
+            objPathMap.contains(entityPath))
         {
-            objPathMap[dbusPath] = entity;
+            objPathMap[entityPath] = entity;
         }
     }
-}
+
+    const EntityMaps& entityMaps;
+    ObjectPathMaps& objPathMap;
+    pldm::responder::oem_platform::Handler* oemPlatformHandler;
+
+    /** @brief Associations indexed by the key of their parent entity */
+    std::unordered_map<uint64_t, std::vector<const Entities*>> children;
+
+    /** @brief Inventory object paths on D-Bus */
+    std::unordered_set<std::string> inventoryPaths;
+};
+
+} // namespace
 
 void updateEntityAssociation(
     const EntityAssociations& entityAssoc,
     pldm_entity_association_tree* entityTree, ObjectPathMaps& objPathMap,
-    EntityMaps entityMaps,
+    const EntityMaps& entityMaps,
     pldm::responder::oem_platform::Handler* oemPlatformHandler)
 {
+    EntityPathBuilder builder(entityAssoc, entityMaps, objPathMap,
+                              oemPlatformHandler);
     std::vector<pldm_entity_node*> parentsEntity =
-        getParentEntites(entityAssoc);
+        builder.getParentEntities(entityAssoc);
     for (const auto& entity : parentsEntity)
     {
-        fs::path path{"/xyz/openbmc_project/inventory"};
+        fs::path path{inventoryPath};
         std::deque<std::string> paths{};
         pldm_entity node_entity = pldm_entity_extract(entity);
         auto node = pldm_entity_association_tree_find_with_locality(
@@ -214,8 +223,7 @@ void updateEntityAssociation(
             paths.pop_back();
         }
 
-        addObjectPathEntityAssociations(entityAssoc, entity, path, objPathMap,
-                                        entityMaps, oemPlatformHandler);
+        builder.addObjectPaths(entity, path);
     }
 }
 
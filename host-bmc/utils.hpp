@@ -31,7 +31,8 @@ namespace utils
 void updateEntityAssociation(
     const pldm::utils::EntityAssociations& entityAssoc,
     pldm_entity_association_tree* entityTree,
-    pldm::utils::ObjectPathMaps& objPathMap, pldm::utils::EntityMaps entityMaps,
+    pldm::utils::ObjectPathMaps& objPathMap,
+    const pldm::utils::EntityMaps& entityMaps,
     pldm::responder::oem_platform::Handler* oemPlatformHandler);
 
 /** @brief Parsing entity to DBus string mapping from json file
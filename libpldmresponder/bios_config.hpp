@@ -158,6 +158,11 @@ class BIOSConfig
     const fs::path jsonDir;
     const fs::path tableDir;
     pldm::utils::DBusHandler* const dbusHandler;
+
+    /** @brief Accessed only from the event loop thread, the BIOS tables are
+     *         rebuilt on D-Bus property changes, which is why the BIOS
+     *         commands stay off the responder worker pool
+     */
     BaseBIOSTable baseBIOSTableMaps;
 
     /** @brief MCTP EID of host firmware */
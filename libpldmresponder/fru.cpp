@@ -1,6 +1,7 @@
 #include "fru.hpp"
 
 #include "common/utils.hpp"
+#include "host-bmc/host_pdr_handler.hpp"
 
 #include <libpldm/entity.h>
 #include <libpldm/utils.h>
@@ -9,9 +10,14 @@
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <optional>
+#include <ranges>
 #include <set>
+#include <span>
 #include <stack>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -137,6 +143,26 @@ void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
     }
 }
 
+bool FruImpl::isPresent(const dbus::InterfaceMap& interfaces)
+{
+    static constexpr auto presentInterface =
+        "xyz.openbmc_project.Inventory.Item";
+    static constexpr auto presentProperty = "Present";
+
+    auto itemIntf = interfaces.find(presentInterface);
+    if (itemIntf == interfaces.end())
+    {
+        return false;
+    }
+    auto present = itemIntf->second.find(presentProperty);
+    if (present == itemIntf->second.end())
+    {
+        return false;
+    }
+    auto value = std::get_if<bool>(&present->second);
+    return value && *value;
+}
+
 void FruImpl::buildFRUTable()
 {
     if (isBuilt)
@@ -144,13 +170,34 @@ void FruImpl::buildFRUTable()
         return;
     }
 
+    dbus::ObjectValueTree inventory;
+    try
+    {
+        inventory = pldm::utils::DBusHandler::getInventoryObjects<
+            pldm::utils::DBusHandler>();
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to build FRU table due to inventory lookup, error - {ERROR}",
+            "ERROR", e);
+        return;
+    }
+    buildFRUTable(std::move(inventory));
+}
+
+void FruImpl::buildFRUTable(dbus::ObjectValueTree inventory)
+{
+    if (isBuilt)
+    {
+        return;
+    }
+
     fru_parser::DBusLookupInfo dbusInfo;
 
     try
     {
         dbusInfo = parser.inventoryLookup();
-        objects = pldm::utils::DBusHandler::getInventoryObjects<
-            pldm::utils::DBusHandler>();
     }
     catch (const std::exception& e)
     {
@@ -159,41 +206,30 @@ void FruImpl::buildFRUTable()
             "ERROR", e);
         return;
     }
+    objects = std::move(inventory);
 
-    auto itemIntfsLookup = std::get<2>(dbusInfo);
+    const auto& itemIntfsLookup = std::get<2>(dbusInfo);
 
     for (const auto& object : objects)
     {
         const auto& interfaces = object.second;
+        // the presence is read from the inventory snapshot, instead of a
+        // D-Bus call per object
+        if (!isPresent(interfaces))
+        {
+            continue;
+        }
         for (const auto& interface : interfaces)
         {
             if (itemIntfsLookup.contains(interface.first))
             {
-                // checking fru present property is available or not.
-                if (!pldm::utils::checkForFruPresence(object.first.str))
-                {
-                    continue;
-                }
 
                 // An exception will be thrown by getRecordInfo, if the item
                 // D-Bus interface name specified in FRU_Master.json does
                 // not have corresponding config jsons
                 try
                 {
-                    updateAssociationTree(objects, object.first.str);
-                    pldm_entity entity{};
-                    if (objToEntityNode.contains(object.first.str))
-                    {
-                        pldm_entity_node* node =
-                            objToEntityNode.at(object.first.str);
-
-                        entity = pldm_entity_extract(node);
-                    }
-
-                    auto recordInfos = parser.getRecordInfo(interface.first);
-                    populateRecords(interfaces, recordInfos, entity);
-
-                    associatedEntityMap.emplace(object.first, entity);
+                    addFru(object.first.str, interfaces, interface.first);
                     break;
                 }
                 catch (const std::exception& e)
@@ -206,9 +242,12 @@ void FruImpl::buildFRUTable()
             }
         }
     }
+    rebuildTable();
 
-    int rc = pldm_entity_association_pdr_add(entityTree, pdrRepo, false,
-                                             TERMINUS_HANDLE);
+    int rc = repo.addRecords([this](pldm_pdr* bmcRepo) {
+        return pldm_entity_association_pdr_add(entityTree, bmcRepo, false,
+                                               TERMINUS_HANDLE);
+    });
     if (rc < 0)
     {
         // pldm_entity_assocation_pdr_add() assert()ed on failure
@@ -219,9 +258,400 @@ void FruImpl::buildFRUTable()
 
     // save a copy of bmc's entity association tree
     pldm_entity_association_tree_copy_root(entityTree, bmcEntityTree);
+    saveEntityNodes();
 
     isBuilt = true;
 }
+
+pdr_utils::ChangeSet FruImpl::updateFRUTable()
+{
+    if (!isBuilt)
+    {
+        // the host fetches the whole repository after the first build
+        buildFRUTable();
+        return {};
+    }
+
+    dbus::ObjectValueTree inventory;
+    try
+    {
+        inventory = pldm::utils::DBusHandler::refreshInventoryObjects<
+            pldm::utils::DBusHandler>();
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to update FRU table due to inventory lookup, error - {ERROR}",
+            "ERROR", e);
+        return {};
+    }
+    return updateFRUTable(std::move(inventory));
+}
+
+pdr_utils::ChangeSet FruImpl::updateFRUTable(dbus::ObjectValueTree inventory)
+{
+    pdr_utils::ChangeSet changes{};
+    if (!isBuilt)
+    {
+        buildFRUTable(std::move(inventory));
+        return changes;
+    }
+
+    fru_parser::DBusLookupInfo dbusInfo;
+    try
+    {
+        dbusInfo = parser.inventoryLookup();
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to update FRU table due to inventory lookup, error - {ERROR}",
+            "ERROR", e);
+        return changes;
+    }
+    auto previous = std::exchange(objects, std::move(inventory));
+
+    const auto& itemIntfsLookup = std::get<2>(dbusInfo);
+    resolveEntityNodes();
+    bool tableChanged = false;
+
+    // The entities whose entity association PDRs are rebuilt once the FRUs
+    // are added and removed
+    std::set<dbus::ObjectPath> containers;
+
+    // Drop the FRUs removed from the inventory or no longer present
+    std::vector<dbus::ObjectPath> removed;
+    for (auto it = recordSets.begin(); it != recordSets.end();)
+    {
+        auto object = objects.find(it->first);
+        if (object != objects.end() && isPresent(object->second))
+        {
+            ++it;
+            continue;
+        }
+
+        auto recordHandle = it->second.pdrRecordHandle;
+        int rc = repo.removeRecord(recordHandle, false);
+        if (rc)
+        {
+            error(
+                "Failed to delete FRU record set PDR with record handle '{RECORD_HANDLE}', response code '{RC}'",
+                "RECORD_HANDLE", recordHandle, "RC", rc);
+        }
+        else
+        {
+            changes[PLDM_RECORDS_DELETED].push_back(recordHandle);
+        }
+        associatedEntityMap.erase(it->first);
+        removed.emplace_back(it->first);
+        it = recordSets.erase(it);
+        tableChanged = true;
+    }
+
+    // The removed FRUs are taken out of the entity association tree, the
+    // deepest first so their nodes are leaves by then
+    for (const auto& path : std::views::reverse(removed))
+    {
+        removeEntityNodes(path, changes, containers);
+    }
+
+    for (const auto& [path, interfaces] : objects)
+    {
+        if (!isPresent(interfaces))
+        {
+            continue;
+        }
+        auto item = std::ranges::find_if(interfaces, [&](const auto& intf) {
+            return itemIntfsLookup.contains(intf.first);
+        });
+        if (item == interfaces.end())
+        {
+            continue;
+        }
+
+        try
+        {
+            auto recordSet = recordSets.find(path.str);
+            if (recordSet != recordSets.end())
+            {
+                // Re-encode the records of the FRUs whose properties changed,
+                // their FRU record set PDR stays the same
+                auto old = previous.find(path);
+                if (old != previous.end() && old->second == interfaces)
+                {
+                    continue;
+                }
+
+                std::vector<uint8_t> records;
+                auto count = encodeRecords(
+                    interfaces, parser.getRecordInfo(item->first),
+                    associatedEntityMap.at(path.str), recordSet->second.rsi,
+                    records);
+                if (records != recordSet->second.records)
+                {
+                    recordSet->second.records = std::move(records);
+                    recordSet->second.numRecords = count;
+                    tableChanged = true;
+                }
+                continue;
+            }
+
+            std::set<dbus::ObjectPath> knownNodes;
+            for (const auto& node : objToEntityNode)
+            {
+                knownNodes.emplace(node.first);
+            }
+
+            addFru(path.str, interfaces, item->first);
+            if (!recordSets.contains(path.str))
+            {
+                continue;
+            }
+            tableChanged = true;
+            changes[PLDM_RECORDS_ADDED].push_back(
+                recordSets.at(path.str).pdrRecordHandle);
+
+            for (const auto& [nodePath, node] : objToEntityNode)
+            {
+                if (!knownNodes.contains(nodePath))
+                {
+                    copyToBmcEntityTree(nodePath);
+                    containers.emplace(pldm::utils::findParent(nodePath));
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to update the FRU records of '{PATH}', error - {ERROR}",
+                "PATH", path.str, "ERROR", e);
+        }
+    }
+
+    for (const auto& container : containers)
+    {
+        updateEntityAssociationPDR(container, changes);
+    }
+
+    if (tableChanged)
+    {
+        rebuildTable();
+    }
+    saveEntityNodes();
+
+    return changes;
+}
+
+void FruImpl::addFru(const dbus::ObjectPath& path,
+                     const dbus::InterfaceMap& interfaces,
+                     const std::string& itemInterface)
+{
+    updateAssociationTree(objects, path);
+    pldm_entity entity{};
+    if (objToEntityNode.contains(path))
+    {
+        pldm_entity_node* node = objToEntityNode.at(path);
+
+        entity = pldm_entity_extract(node);
+    }
+
+    auto recordInfos = parser.getRecordInfo(itemInterface);
+    populateRecords(path, interfaces, recordInfos, entity);
+
+    associatedEntityMap.emplace(path, entity);
+}
+
+void FruImpl::removeEntityNodes(const dbus::ObjectPath& path,
+                                pdr_utils::ChangeSet& changes,
+                                std::set<dbus::ObjectPath>& containers)
+{
+    auto node = objToEntityNode.find(path);
+    if (node == objToEntityNode.end())
+    {
+        return;
+    }
+
+    // The nodes under the FRU are removed with it, unless a FRU is left
+    // under them
+    auto prefix = path + '/';
+    std::vector<dbus::ObjectPath> nodePaths;
+    for (auto it = objToEntityNode.lower_bound(prefix);
+         it != objToEntityNode.end() && it->first.starts_with(prefix); ++it)
+    {
+        if (recordSets.contains(it->first))
+        {
+            return;
+        }
+        nodePaths.emplace_back(it->first);
+    }
+
+    for (const auto& nodePath : std::views::reverse(nodePaths))
+    {
+        removeEntityNode(nodePath, changes);
+    }
+
+    // Entities of the host may have been merged under the node
+    if (pldm_entity_get_num_children(node->second,
+                                     PLDM_ENTITY_ASSOCIAION_PHYSICAL) ||
+        pldm_entity_get_num_children(node->second,
+                                     PLDM_ENTITY_ASSOCIAION_LOGICAL))
+    {
+        containers.emplace(path);
+        return;
+    }
+
+    removeEntityNode(path, changes);
+    containers.emplace(pldm::utils::findParent(path));
+}
+
+void FruImpl::removeEntityNode(const dbus::ObjectPath& path,
+                               pdr_utils::ChangeSet& changes)
+{
+    pldm_entity entity = pldm_entity_extract(objToEntityNode.at(path));
+    removeEntityAssociationPDRs(entity, changes);
+    pldm_entity_association_tree_delete_node(entityTree, &entity);
+    pldm_entity_association_tree_delete_node(bmcEntityTree, &entity);
+    objToEntityNode.erase(path);
+}
+
+void FruImpl::removeEntityAssociationPDRs(const pldm_entity& container,
+                                          pdr_utils::ChangeSet& changes)
+{
+    std::vector<uint32_t> recordHandles;
+    const pldm_pdr_record* record = nullptr;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    do
+    {
+        record = pldm_pdr_find_record_by_type(
+            pdrRepo, PLDM_PDR_ENTITY_ASSOCIATION, record, &data, &size);
+        if (!record || pldm_pdr_record_is_remote(record))
+        {
+            continue;
+        }
+
+        size_t numEntities = 0;
+        pldm_entity* entities = nullptr;
+        pldm_entity_association_pdr_extract(data, size, &numEntities,
+                                            &entities);
+        if (numEntities &&
+            entities[0].entity_type == container.entity_type &&
+            entities[0].entity_instance_num == container.entity_instance_num &&
+            entities[0].entity_container_id == container.entity_container_id)
+        {
+            recordHandles.emplace_back(
+                pldm_pdr_get_record_handle(pdrRepo, record));
+        }
+        free(entities);
+    } while (record);
+
+    for (const auto& recordHandle : recordHandles)
+    {
+        int rc = repo.removeRecord(recordHandle, false);
+        if (rc)
+        {
+            error(
+                "Failed to delete entity association PDR with record handle '{RECORD_HANDLE}', response code '{RC}'",
+                "RECORD_HANDLE", recordHandle, "RC", rc);
+            continue;
+        }
+        changes[PLDM_RECORDS_DELETED].push_back(recordHandle);
+    }
+}
+
+void FruImpl::updateEntityAssociationPDR(const dbus::ObjectPath& path,
+                                         pdr_utils::ChangeSet& changes)
+{
+    auto node = objToEntityNode.find(path);
+    if (node == objToEntityNode.end())
+    {
+        // the root of the tree, or a removed entity
+        return;
+    }
+
+    pldm_entity entity = pldm_entity_extract(node->second);
+    removeEntityAssociationPDRs(entity, changes);
+
+    // The PDRs are appended to the end of the repo
+    auto last = pldm_pdr_find_last_in_range(
+        pdrRepo, 0, std::numeric_limits<uint32_t>::max());
+    pldm_entity* entities = &entity;
+    int rc = repo.addRecords([&node, &entities](pldm_pdr* bmcRepo) {
+        return pldm_entity_association_pdr_add_from_node(
+            node->second, bmcRepo, &entities, 1, false, TERMINUS_HANDLE);
+    });
+    if (rc)
+    {
+        error(
+            "Failed to add entity association PDR from node, response code '{RC}'",
+            "RC", rc);
+        return;
+    }
+
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t nextRecordHandle = 0;
+    auto record = last ? pldm_pdr_get_next_record(pdrRepo, last, &data, &size,
+                                                  &nextRecordHandle)
+                       : pldm_pdr_find_record(pdrRepo, 0, &data, &size,
+                                              &nextRecordHandle);
+    while (record)
+    {
+        changes[PLDM_RECORDS_ADDED].push_back(
+            pldm_pdr_get_record_handle(pdrRepo, record));
+        record = pldm_pdr_get_next_record(pdrRepo, record, &data, &size,
+                                          &nextRecordHandle);
+    }
+}
+
+void FruImpl::copyToBmcEntityTree(const dbus::ObjectPath& path)
+{
+    pldm_entity entity = pldm_entity_extract(objToEntityNode.at(path));
+    pldm_entity_node* bmcParent = nullptr;
+    auto parent = objToEntityNode.find(pldm::utils::findParent(path));
+    if (parent != objToEntityNode.end())
+    {
+        pldm_entity parentEntity = pldm_entity_extract(parent->second);
+        bmcParent = pldm_entity_association_tree_find_with_locality(
+            bmcEntityTree, &parentEntity, false);
+        if (!bmcParent)
+        {
+            error("Failed to find the parent of '{PATH}' in the BMC's tree",
+                  "PATH", path);
+            return;
+        }
+    }
+
+    pldm_entity_association_tree_add_entity(
+        bmcEntityTree, &entity, entity.entity_instance_num, bmcParent,
+        PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true,
+        entity.entity_container_id);
+}
+
+void FruImpl::saveEntityNodes()
+{
+    nodeEntities.clear();
+    for (const auto& [path, node] : objToEntityNode)
+    {
+        nodeEntities.emplace(path, pldm_entity_extract(node));
+    }
+}
+
+void FruImpl::resolveEntityNodes()
+{
+    // The host PDR handler restores the entity association tree from the
+    // BMC's copy when the host powers off, which frees the nodes
+    objToEntityNode.clear();
+    for (auto& [path, entity] : nodeEntities)
+    {
+        auto node = pldm_entity_association_tree_find_with_locality(
+            entityTree, &entity, false);
+        if (node)
+        {
+            objToEntityNode.emplace(path, node);
+        }
+    }
+}
 std::string FruImpl::populatefwVersion()
 {
     static constexpr auto fwFunctionalObjPath =
@@ -252,14 +682,45 @@ std::string FruImpl::populatefwVersion()
     return currentBmcVersion;
 }
 void FruImpl::populateRecords(
+    const dbus::ObjectPath& path,
     const pldm::responder::dbus::InterfaceMap& interfaces,
     const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity)
 {
-    // recordSetIdentifier for the FRU will be set when the first record gets
-    // added for the FRU
-    uint16_t recordSetIdentifier = 0;
-    auto numRecsCount = numRecs;
-    static uint32_t bmc_record_handle = 0;
+    // recordSetIdentifier for the FRU is taken only if records get added for
+    // the FRU
+    FruRecordSet recordSet{};
+    recordSet.rsi = rsi + 1;
+    recordSet.numRecords =
+        encodeRecords(interfaces, recordInfos, entity, recordSet.rsi,
+                      recordSet.records);
+    if (!recordSet.numRecords)
+    {
+        return;
+    }
+    nextRSI();
+
+    // the repo assigns the handles of the PDRs added after it was built
+    recordSet.pdrRecordHandle = isBuilt ? 0 : nextRecordHandle();
+    int rc = repo.addRecords([&recordSet, &entity](pldm_pdr* bmcRepo) {
+        return pldm_pdr_add_fru_record_set(
+            bmcRepo, TERMINUS_HANDLE, recordSet.rsi, entity.entity_type,
+            entity.entity_instance_num, entity.entity_container_id,
+            &recordSet.pdrRecordHandle);
+    });
+    if (rc)
+    {
+        // pldm_pdr_add_fru_record_set() assert()ed on failure
+        throw std::runtime_error("Failed to add PDR FRU record set");
+    }
+    recordSets[path] = std::move(recordSet);
+}
+
+uint16_t FruImpl::encodeRecords(
+    const pldm::responder::dbus::InterfaceMap& interfaces,
+    const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity,
+    uint16_t recordSetIdentifier, std::vector<uint8_t>& records)
+{
+    uint16_t count = 0;
 
     for (const auto& [recType, encType, fieldInfos] : recordInfos)
     {
@@ -318,71 +779,84 @@ void FruImpl::populateRecords(
 
         if (tlvs.size())
         {
-            if (numRecs == numRecsCount)
-            {
-                recordSetIdentifier = nextRSI();
-                bmc_record_handle = nextRecordHandle();
-                int rc = pldm_pdr_add_fru_record_set(
-                    pdrRepo, TERMINUS_HANDLE, recordSetIdentifier,
-                    entity.entity_type, entity.entity_instance_num,
-                    entity.entity_container_id, &bmc_record_handle);
-                if (rc)
-                {
-                    // pldm_pdr_add_fru_record_set() assert()ed on failure
-                    throw std::runtime_error(
-                        "Failed to add PDR FRU record set");
-                }
-            }
-            auto curSize = table.size();
-            table.resize(curSize + recHeaderSize + tlvs.size());
-            encode_fru_record(table.data(), table.size(), &curSize,
+            auto curSize = records.size();
+            records.resize(curSize + recHeaderSize + tlvs.size());
+            encode_fru_record(records.data(), records.size(), &curSize,
                               recordSetIdentifier, recType, numFRUFields,
                               encType, tlvs.data(), tlvs.size());
-            numRecs++;
+            count++;
         }
     }
+
+    return count;
 }
 
-std::vector<uint8_t> FruImpl::tableResize()
+void FruImpl::rebuildTable()
 {
-    std::vector<uint8_t> tempTable;
+    table.clear();
+    recordSetIndex.clear();
+    numRecs = 0;
+    for (const auto& [path, recordSet] : recordSets)
+    {
+        table.insert(table.end(), recordSet.records.begin(),
+                     recordSet.records.end());
+        numRecs += recordSet.numRecords;
+        recordSetIndex.emplace(recordSet.rsi, &recordSet);
+    }
 
+    // The table is padded and checksummed once per change, instead of for
+    // each GetFRURecordTable request
+    transferTable = table;
+    checksum = 0;
     if (table.size())
     {
-        std::copy(table.begin(), table.end(), std::back_inserter(tempTable));
-        padBytes = pldm::utils::getNumPadBytes(table.size());
-        tempTable.resize(tempTable.size() + padBytes, 0);
+        transferTable.resize(
+            table.size() + pldm::utils::getNumPadBytes(table.size()), 0);
+        checksum = crc32(transferTable.data(), transferTable.size());
     }
-    return tempTable;
+    transferTable.insert(transferTable.end(),
+                         reinterpret_cast<const uint8_t*>(&checksum),
+                         reinterpret_cast<const uint8_t*>(&checksum) +
+                             sizeof(checksum));
+    ++generation;
 }
 
-void FruImpl::getFRUTable(Response& response)
+uint32_t FruImpl::getFRUTable(uint32_t dataTransferHandle, size_t partSize,
+                              Response& response, uint8_t& transferFlag) const
 {
+    uint32_t offset = dataTransferHandle & handleOffsetMask;
+    size_t length = transferTable.size() - offset;
+    if (partSize)
+    {
+        length = std::min(length, partSize);
+    }
     auto hdrSize = response.size();
-    std::vector<uint8_t> tempTable;
+    response.resize(hdrSize + length, 0);
+    std::copy_n(transferTable.begin() + offset, length,
+                response.begin() + hdrSize);
 
-    if (table.size())
+    uint32_t nextOffset = offset + length;
+    bool last = nextOffset == transferTable.size();
+    if (offset == 0)
     {
-        tempTable = tableResize();
-        checksum = crc32(tempTable.data(), tempTable.size());
+        transferFlag = last ? PLDM_START_AND_END : PLDM_START;
+    }
+    else
+    {
+        transferFlag = last ? PLDM_END : PLDM_MIDDLE;
     }
-    response.resize(hdrSize + tempTable.size() + sizeof(checksum), 0);
-    std::copy(tempTable.begin(), tempTable.end(), response.begin() + hdrSize);
 
-    // Copy the checksum to response data
-    auto iter = response.begin() + hdrSize + tempTable.size();
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
+    return last ? 0 : (uint32_t{generation} << handleOffsetBits) | nextOffset;
 }
 
-void FruImpl::getFRURecordTableMetadata()
+bool FruImpl::isValidTransferHandle(uint32_t dataTransferHandle) const
 {
-    std::vector<uint8_t> tempTable;
-    if (table.size())
+    if (!dataTransferHandle)
     {
-        tempTable = tableResize();
-        checksum = crc32(tempTable.data(), tempTable.size());
+        return true;
     }
+    return (dataTransferHandle >> handleOffsetBits) == generation &&
+           (dataTransferHandle & handleOffsetMask) < transferTable.size();
 }
 
 int FruImpl::getFRURecordByOption(
@@ -394,16 +868,29 @@ int FruImpl::getFRURecordByOption(
     // FRU table is built lazily, build if not done.
     buildFRUTable();
 
+    // The records of a record set are looked up in the index, the record and
+    // field types are then filtered among its few records
+    std::span<const uint8_t> records = table;
+    if (recordSetIdentifer)
+    {
+        auto recordSet = recordSetIndex.find(recordSetIdentifer);
+        if (recordSet == recordSetIndex.end())
+        {
+            return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+        }
+        records = recordSet->second->records;
+    }
+
     /* 7 is sizeof(checksum,4) + padBytesMax(3)
      * We can not know size of the record table got by options in advance, but
-     * it must be less than the source table. So it's safe to use sizeof the
-     * source table + 7 as the buffer length
+     * it must be less than the source records. So it's safe to use sizeof the
+     * source records + 7 as the buffer length
      */
-    size_t recordTableSize = table.size() - padBytes + 7;
+    size_t recordTableSize = records.size() + 7;
     fruData.resize(recordTableSize, 0);
 
     int rc = get_fru_record_by_option(
-        table.data(), table.size() - padBytes, fruData.data(), &recordTableSize,
+        records.data(), records.size(), fruData.data(), &recordTableSize,
         recordSetIdentifer, recordType, fieldType);
 
     if (rc != PLDM_SUCCESS || recordTableSize == 0)
@@ -412,11 +899,11 @@ int FruImpl::getFRURecordByOption(
     }
 
     auto pads = pldm::utils::getNumPadBytes(recordTableSize);
-    crc32(fruData.data(), recordTableSize + pads);
+    sum recordsChecksum = crc32(fruData.data(), recordTableSize + pads);
 
     auto iter = fruData.begin() + recordTableSize + pads;
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
+    std::copy_n(reinterpret_cast<const uint8_t*>(&recordsChecksum),
+                sizeof(recordsChecksum), iter);
     fruData.resize(recordTableSize + pads + sizeof(sum));
 
     return PLDM_SUCCESS;
@@ -442,6 +929,78 @@ int FruImpl::setFRUTable(const std::vector<uint8_t>& fruData)
 
 namespace fru
 {
+void Handler::watchInventory(const sdeventplus::Event& event,
+                             sdbusplus::bus_t& bus)
+{
+    static constexpr auto inventoryPath = "/xyz/openbmc_project/inventory";
+
+    settleTimer = std::make_unique<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+        event, [this](auto&) {
+            settleTimer->setEnabled(false);
+            updateFRUTable();
+        });
+    settleTimer->restart(settleTime);
+    firstChange = std::chrono::steady_clock::now();
+
+    auto restartTimer = [this](sdbusplus::message_t&) {
+        using namespace std::chrono;
+        auto now = steady_clock::now();
+        if (!settleTimer->isEnabled())
+        {
+            firstChange = now;
+        }
+        // An inventory that keeps changing postpones the update up to
+        // maxSettleTime after its first change
+        auto left =
+            duration_cast<milliseconds>(firstChange + maxSettleTime - now);
+        settleTimer->restart(
+            std::clamp<milliseconds>(left, milliseconds::zero(), settleTime));
+    };
+    namespace rules = sdbusplus::bus::match::rules;
+    inventoryMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, rules::interfacesAdded(inventoryPath), restartTimer));
+    inventoryMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, rules::interfacesRemoved(inventoryPath), restartTimer));
+    inventoryMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus,
+        rules::type::signal() + rules::member("PropertiesChanged") +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::path_namespace(inventoryPath),
+        restartTimer));
+}
+
+void Handler::updateFRUTable()
+{
+    pdr_utils::ChangeSet changes;
+    try
+    {
+        changes = impl.updateFRUTable();
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to update the FRU table, error - {ERROR}", "ERROR", e);
+        return;
+    }
+    if (changes.empty())
+    {
+        return;
+    }
+
+    if (hostPDRHandler)
+    {
+        auto& changeJournal = hostPDRHandler->getChangeJournal();
+        for (const auto& [eventDataOperation, recordHandles] : changes)
+        {
+            for (const auto& recordHandle : recordHandles)
+            {
+                changeJournal.record(eventDataOperation, recordHandle);
+            }
+        }
+        hostPDRHandler->sendPDRRepositoryChgEvent();
+    }
+}
+
 Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
                                             size_t /*payloadLength*/)
 {
@@ -457,8 +1016,6 @@ Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
                       0);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
-    impl.getFRURecordTableMetadata();
-
     auto rc = encode_get_fru_record_table_metadata_resp(
         request->hdr.instance_id, PLDM_SUCCESS, major, minor, maxSize,
         impl.size(), impl.numRSI(), impl.numRecords(), impl.checkSum(),
@@ -482,20 +1039,45 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
     }
 
+    uint32_t dataTransferHandle{};
+    uint8_t transferOpFlag{};
+    auto rc = decode_get_fru_record_table_req(
+        request, payloadLength, &dataTransferHandle, &transferOpFlag);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    // The data transfer handle of a part is returned with the previous one,
+    // a transfer is restarted if the table changed in between
+    if (transferOpFlag == PLDM_GET_FIRSTPART)
+    {
+        dataTransferHandle = 0;
+    }
+    else if (transferOpFlag != PLDM_GET_NEXTPART)
+    {
+        return ccOnlyResponse(request, PLDM_FRU_INVALID_TRANSFER_FLAG);
+    }
+    if (!impl.isValidTransferHandle(dataTransferHandle))
+    {
+        return ccOnlyResponse(request, PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+    }
+
     Response response(
         sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    uint8_t transferFlag{};
+    auto nextDataTransferHandle = impl.getFRUTable(
+        dataTransferHandle, FRU_TABLE_TRANSFER_SIZE, response, transferFlag);
 
-    auto rc =
-        encode_get_fru_record_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                         0, PLDM_START_AND_END, responsePtr);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    rc = encode_get_fru_record_table_resp(request->hdr.instance_id,
+                                          PLDM_SUCCESS, nextDataTransferHandle,
+                                          transferFlag, responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
-    impl.getFRUTable(response);
-
     return response;
 }
 
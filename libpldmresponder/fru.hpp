@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fru_parser.hpp"
+#include "libpldmresponder/pdr_change_journal.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "oem_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -8,9 +9,15 @@
 #include <libpldm/fru.h>
 #include <libpldm/pdr.h>
 
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <variant>
 #include <vector>
@@ -18,6 +25,8 @@
 namespace pldm
 {
 
+class HostPDRHandler;
+
 namespace responder
 {
 
@@ -67,9 +76,12 @@ class FruImpl
             const std::filesystem::path& fruMasterJsonPath, pldm_pdr* pdrRepo,
             pldm_entity_association_tree* entityTree,
             pldm_entity_association_tree* bmcEntityTree) :
-        parser(configPath, fruMasterJsonPath), pdrRepo(pdrRepo),
+        parser(configPath, fruMasterJsonPath), pdrRepo(pdrRepo), repo(pdrRepo),
         entityTree(entityTree), bmcEntityTree(bmcEntityTree)
-    {}
+    {
+        // an empty table until it is built
+        rebuildTable();
+    }
 
     /** @brief Total length of the FRU table in bytes, this includes the pad
      *         bytes and the checksum.
@@ -96,7 +108,7 @@ class FruImpl
      */
     uint16_t numRSI() const
     {
-        return rsi;
+        return recordSets.size();
     }
 
     /** @brief The number of FRU records in the table
@@ -108,16 +120,39 @@ class FruImpl
         return numRecs;
     }
 
-    /** @brief Get the FRU table
+    /** @brief Get a part of the FRU table, padded and followed by its
+     *         checksum
+     *
+     *  @param[in] dataTransferHandle - data transfer handle of the part, 0
+     *                                  for the first part
+     *  @param[in] partSize - maximum size of the part, 0 for the rest of the
+     *                        table
+     *  @param[out] response - the part is appended to the response
+     *  @param[out] transferFlag - position of the part in the transfer
+     *
+     *  @return the data transfer handle of the next part, 0 for the last part
+     */
+    uint32_t getFRUTable(uint32_t dataTransferHandle, size_t partSize,
+                         Response& response, uint8_t& transferFlag) const;
+
+    /** @brief Check that a data transfer handle is 0 or was returned by
+     *         getFRUTable since the table last changed
+     *
+     *  @param[in] dataTransferHandle - data transfer handle of a request
      *
-     *  @param[out] - Populate response with the FRU table
+     *  @return true if the handle is the one of a part of the current table
      */
-    void getFRUTable(Response& response);
+    bool isValidTransferHandle(uint32_t dataTransferHandle) const;
 
-    /** @brief Get the Fru Table MetaData
+    /** @brief Length of the FRU table transfer, the padded table and its
+     *         checksum
      *
+     *  @return size of the transfer
      */
-    void getFRURecordTableMetadata();
+    uint32_t transferSize() const
+    {
+        return transferTable.size();
+    }
 
     /** @brief Get FRU Record Table By Option
      *  @param[out] response - Populate response with the FRU table got by
@@ -137,6 +172,31 @@ class FruImpl
      */
     void buildFRUTable();
 
+    /** @brief Build the FRU table from an inventory snapshot
+     *
+     *  @param[in] inventory - the inventory objects
+     */
+    void buildFRUTable(dbus::ObjectValueTree inventory);
+
+    /** @brief Bring the FRU table, the entity association tree, the FRU
+     *         record set PDRs and the entity association PDRs up to date with
+     *         the inventory. The FRUs removed from the inventory or no longer
+     *         present are dropped, the new ones are added and the records of
+     *         the changed ones re-encoded. Builds the table if it is not
+     *         built yet.
+     *
+     *  @return the PDRs added and deleted, to notify the host about
+     */
+    pdr_utils::ChangeSet updateFRUTable();
+
+    /** @brief Update the FRU table from an inventory snapshot
+     *
+     *  @param[in] inventory - the inventory objects
+     *
+     *  @return the PDRs added and deleted, to notify the host about
+     */
+    pdr_utils::ChangeSet updateFRUTable(dbus::ObjectValueTree inventory);
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -159,6 +219,15 @@ class FruImpl
     std::optional<pldm_entity>
         getEntityByObjectPath(const dbus::InterfaceMap& intfMaps);
 
+    /** @brief Check the Present property of a FRU in the inventory snapshot
+     *
+     *  @param[in] interfaces - D-Bus interfaces and the associated property
+     *                          values for the FRU
+     *
+     *  @return true if the FRU is present
+     */
+    static bool isPresent(const dbus::InterfaceMap& interfaces);
+
     /** @brief Update pldm entity to association tree
      *
      *  @param[in] objects - std::map The object value tree
@@ -185,12 +254,6 @@ class FruImpl
      */
     std::string populatefwVersion();
 
-    /* @brief Method to resize the table
-     *
-     * @return resized table
-     */
-    std::vector<uint8_t> tableResize();
-
     /* @brief set FRU Record Table
      *
      * @param[in] fruData - the data of the fru
@@ -219,16 +282,47 @@ class FruImpl
         return ++rh;
     }
 
+    /** @struct FruRecordSet
+     *
+     *  @brief The FRU records of an instance of FRU, and the handle of its
+     *         FRU record set PDR
+     */
+    struct FruRecordSet
+    {
+        uint16_t rsi = 0;
+        uint32_t pdrRecordHandle = 0;
+        uint16_t numRecords = 0;
+        std::vector<uint8_t> records;
+    };
+
     uint32_t rh = 0;
     uint16_t rsi = 0;
     uint16_t numRecs = 0;
-    uint8_t padBytes = 0;
     std::vector<uint8_t> table;
     uint32_t checksum = 0;
+
+    /** @brief The FRU table padded and followed by its checksum, as sent in
+     *         the GetFRURecordTable responses
+     */
+    std::vector<uint8_t> transferTable;
+
+    /** @brief The data transfer handles of the parts of the table carry the
+     *         generation of the table in their high byte and the offset of
+     *         the part in the low bytes, so a transfer started before the
+     *         table changed is not continued with the parts of the new one.
+     *         The tables sent in parts are limited to 16 MiB.
+     */
+    static constexpr uint32_t handleOffsetBits = 24;
+    static constexpr uint32_t handleOffsetMask = (1u << handleOffsetBits) - 1;
+
+    /** @brief Generation of the table, incremented when it changes */
+    uint8_t generation = 0;
+
     bool isBuilt = false;
 
     fru_parser::FruParser parser;
     pldm_pdr* pdrRepo;
+    pdr_utils::Repo repo;
     pldm_entity_association_tree* entityTree;
     pldm_entity_association_tree* bmcEntityTree;
     pldm::responder::oem_fru::Handler* oemFruHandler = nullptr;
@@ -236,18 +330,124 @@ class FruImpl
 
     std::map<dbus::ObjectPath, pldm_entity_node*> objToEntityNode{};
 
+    /** @brief FRU record sets by inventory object path, the FRU table is
+     *         their concatenation
+     */
+    std::map<dbus::ObjectPath, FruRecordSet> recordSets;
+
+    /** @brief FRU record sets by record set identifier */
+    std::map<uint16_t, const FruRecordSet*> recordSetIndex;
+
+    /** @brief Add an instance of FRU to the entity association tree and build
+     *         its FRU records and FRU record set PDR
+     *
+     *  @param[in] path - inventory object path of the FRU
+     *  @param[in] interfaces - D-Bus interfaces and the associated property
+     *                          values for the FRU
+     *  @param[in] itemInterface - item interface of the FRU in the FRU config
+     *
+     *  @throw std::exception if the FRU config or the PDR can't be added
+     */
+    void addFru(const dbus::ObjectPath& path,
+                const dbus::InterfaceMap& interfaces,
+                const std::string& itemInterface);
+
     /** @brief populateRecord builds the FRU records for an instance of FRU and
-     *         updates the FRU table with the FRU records.
+     *         adds its FRU record set PDR.
      *
+     *  @param[in] path - inventory object path of the FRU
      *  @param[in] interfaces - D-Bus interfaces and the associated property
      *                          values for the FRU
      *  @param[in] recordInfos - FRU record info to build the FRU records
      *  @param[in/out] entity - PLDM entity corresponding to FRU instance
      */
-    void populateRecords(const dbus::InterfaceMap& interfaces,
+    void populateRecords(const dbus::ObjectPath& path,
+                         const dbus::InterfaceMap& interfaces,
                          const fru_parser::FruRecordInfos& recordInfos,
                          const pldm_entity& entity);
 
+    /** @brief Encode the FRU records of an instance of FRU
+     *
+     *  @param[in] interfaces - D-Bus interfaces and the associated property
+     *                          values for the FRU
+     *  @param[in] recordInfos - FRU record info to build the FRU records
+     *  @param[in] entity - PLDM entity corresponding to FRU instance
+     *  @param[in] recordSetIdentifier - record set identifier of the FRU
+     *  @param[out] records - the encoded records
+     *
+     *  @return number of records encoded
+     */
+    uint16_t encodeRecords(const dbus::InterfaceMap& interfaces,
+                           const fru_parser::FruRecordInfos& recordInfos,
+                           const pldm_entity& entity,
+                           uint16_t recordSetIdentifier,
+                           std::vector<uint8_t>& records);
+
+    /** @brief Rebuild the FRU table, its checksum and the record set index
+     *         from the FRU record sets
+     */
+    void rebuildTable();
+
+    /** @brief Remove the entity node of a FRU removed after the FRU table
+     *         was built from the entity association trees, with the nodes
+     *         under it, unless a FRU is left under them
+     *
+     *  @param[in] path - inventory object path of the FRU
+     *  @param[out] changes - the entity association PDRs deleted
+     *  @param[out] containers - the entities whose entity association PDRs
+     *                           are to be rebuilt
+     */
+    void removeEntityNodes(const dbus::ObjectPath& path,
+                           pdr_utils::ChangeSet& changes,
+                           std::set<dbus::ObjectPath>& containers);
+
+    /** @brief Remove an entity node from the entity association trees, and
+     *         delete the entity association PDRs it is the container of
+     *
+     *  @param[in] path - inventory object path of the entity
+     *  @param[out] changes - the entity association PDRs deleted
+     */
+    void removeEntityNode(const dbus::ObjectPath& path,
+                          pdr_utils::ChangeSet& changes);
+
+    /** @brief Delete the BMC's entity association PDRs of a container
+     *
+     *  @param[in] container - the container entity
+     *  @param[out] changes - the PDRs deleted
+     */
+    void removeEntityAssociationPDRs(const pldm_entity& container,
+                                     pdr_utils::ChangeSet& changes);
+
+    /** @brief Rebuild the entity association PDRs of an entity whose
+     *         children were added or removed after the FRU table was built
+     *
+     *  @param[in] path - inventory object path of the entity
+     *  @param[out] changes - the PDRs deleted and added
+     */
+    void updateEntityAssociationPDR(const dbus::ObjectPath& path,
+                                    pdr_utils::ChangeSet& changes);
+
+    /** @brief Add an entity node created after the FRU table was built to
+     *         the copy of the BMC's entity association tree, so it is kept
+     *         when the host PDR handler restores the tree from the copy
+     *
+     *  @param[in] path - inventory object path of the entity
+     */
+    void copyToBmcEntityTree(const dbus::ObjectPath& path);
+
+    /** @brief Save the entities of objToEntityNode, to look the nodes up again
+     *         with resolveEntityNodes
+     */
+    void saveEntityNodes();
+
+    /** @brief Look the nodes of objToEntityNode up again in the entity
+     *         association tree, which may have been restored since
+     */
+    void resolveEntityNodes();
+
+    /** @brief The entities of objToEntityNode as of the last table update */
+    std::map<dbus::ObjectPath, pldm_entity> nodeEntities;
+
     /** @brief Associate sensor/effecter to FRU entity
      */
     dbus::AssociatedEntityMap associatedEntityMap;
@@ -314,6 +514,31 @@ class Handler : public CmdHandler
         impl.buildFRUTable();
     }
 
+    /** @brief Build the FRU table from the event loop once the inventory
+     *         settles, so the first FRU or GetPDR command of the host doesn't
+     *         wait for it, and keep it up to date as FRUs are plugged and
+     *         unplugged. The inventory is settled when no interface is added
+     *         or removed and no property changes for settleTime, or at
+     *         the latest maxSettleTime after its first change. A command
+     *         handled before the first build still builds the table on
+     *         demand. The host is sent a PDR repository change event with
+     *         the PDRs added and deleted by each update.
+     *
+     *  @param[in] event - event loop the table is maintained from
+     *  @param[in] bus - bus the inventory is watched on
+     */
+    void watchInventory(const sdeventplus::Event& event,
+                        sdbusplus::bus_t& bus);
+
+    /** @brief Time without inventory changes before the FRU table is updated
+     */
+    static constexpr std::chrono::seconds settleTime{5};
+
+    /** @brief Time after the first inventory change after which the FRU
+     *         table is updated, even if the inventory keeps changing
+     */
+    static constexpr std::chrono::seconds maxSettleTime{30};
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -354,10 +579,38 @@ class Handler : public CmdHandler
         impl.setOemFruHandler(handler);
     }
 
+    /* @brief Method to set the host PDR handler, which notifies the host of
+     *        the PDRs changed by the FRU table updates
+     *
+     * @param[in] handler - host PDR handler
+     */
+    void setHostPDRHandler(HostPDRHandler* handler)
+    {
+        hostPDRHandler = handler;
+    }
+
     using Table = std::vector<uint8_t>;
 
   private:
+    /** @brief Update the FRU table and notify the host of the changed PDRs */
+    void updateFRUTable();
+
     FruImpl impl;
+
+    HostPDRHandler* hostPDRHandler = nullptr;
+
+    /** @brief Delays the FRU table update until the inventory settles */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        settleTimer;
+
+    /** @brief Time of the first inventory change not in the FRU table yet */
+    std::chrono::steady_clock::time_point firstChange;
+
+    /** @brief Restart settleTimer when interfaces are added to or removed
+     *         from the inventory, or its properties change
+     */
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> inventoryMatches;
 };
 
 } // namespace fru
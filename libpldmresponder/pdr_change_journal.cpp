@@ -0,0 +1,155 @@
+#include "pdr_change_journal.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+uint32_t ChangeJournal::record(uint8_t operation, RecordHandle recordHandle)
+{
+    journal.emplace_back(ChangeRecord{++changeNumber, operation, recordHandle});
+    return changeNumber;
+}
+
+void ChangeJournal::recordDiff(std::vector<RecordHandle> before,
+                               std::vector<RecordHandle> after)
+{
+    std::ranges::sort(before);
+    std::ranges::sort(after);
+
+    std::vector<RecordHandle> deleted;
+    std::ranges::set_difference(before, after, std::back_inserter(deleted));
+    for (const auto& recordHandle : deleted)
+    {
+        record(PLDM_RECORDS_DELETED, recordHandle);
+    }
+
+    std::vector<RecordHandle> added;
+    std::ranges::set_difference(after, before, std::back_inserter(added));
+    for (const auto& recordHandle : added)
+    {
+        record(PLDM_RECORDS_ADDED, recordHandle);
+    }
+}
+
+ChangeSet ChangeJournal::getChangesSince(uint32_t since) const
+{
+    // first and last operation seen for each record handle in the window
+    std::map<RecordHandle, std::pair<uint8_t, uint8_t>> ops;
+    auto it = std::ranges::upper_bound(journal, since, {},
+                                       &ChangeRecord::changeNumber);
+    for (; it != journal.end(); ++it)
+    {
+        auto [entry, inserted] = ops.try_emplace(
+            it->recordHandle, std::make_pair(it->operation, it->operation));
+        if (!inserted)
+        {
+            entry->second.second = it->operation;
+        }
+    }
+
+    ChangeSet changeSet{};
+    for (const auto& [recordHandle, firstAndLast] : ops)
+    {
+        const auto& [first, last] = firstAndLast;
+        if (first == PLDM_RECORDS_ADDED && last == PLDM_RECORDS_DELETED)
+        {
+            continue;
+        }
+
+        uint8_t operation = PLDM_RECORDS_MODIFIED;
+        if (first == PLDM_RECORDS_ADDED)
+        {
+            operation = PLDM_RECORDS_ADDED;
+        }
+        else if (last == PLDM_RECORDS_DELETED)
+        {
+            operation = PLDM_RECORDS_DELETED;
+        }
+        changeSet[operation].push_back(recordHandle);
+    }
+
+    return changeSet;
+}
+
+void ChangeJournal::trim(uint32_t upTo)
+{
+    while (!journal.empty() && journal.front().changeNumber <= upTo)
+    {
+        journal.pop_front();
+    }
+}
+
+std::vector<uint8_t> encodeChangeSet(const ChangeSet& changeSet)
+{
+    // The number of change entries in a change record is a uint8_t, split
+    // larger sets of the same operation into several change records.
+    constexpr size_t maxEntriesPerRecord = std::numeric_limits<uint8_t>::max();
+
+    std::vector<uint8_t> eventDataOps{};
+    std::vector<uint8_t> numsOfChangeEntries{};
+    std::vector<const uint32_t*> changeEntries{};
+    size_t totalEntries = 0;
+
+    for (const auto& [operation, recordHandles] : changeSet)
+    {
+        for (size_t offset = 0; offset < recordHandles.size();
+             offset += maxEntriesPerRecord)
+        {
+            eventDataOps.push_back(operation);
+            numsOfChangeEntries.push_back(static_cast<uint8_t>(std::min(
+                maxEntriesPerRecord, recordHandles.size() - offset)));
+            changeEntries.push_back(recordHandles.data() + offset);
+        }
+        totalEntries += recordHandles.size();
+    }
+
+    if (eventDataOps.empty())
+    {
+        return {};
+    }
+    if (eventDataOps.size() > std::numeric_limits<uint8_t>::max())
+    {
+        // The number of change records is a uint8_t too, have the peer
+        // refetch the whole repository
+        return {REFRESH_ENTIRE_REPOSITORY, 0};
+    }
+
+    size_t maxSize =
+        PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH +
+        eventDataOps.size() * PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
+        totalEntries * sizeof(uint32_t);
+    std::vector<uint8_t> eventDataVec(maxSize);
+    auto eventData =
+        reinterpret_cast<struct pldm_pdr_repository_chg_event_data*>(
+            eventDataVec.data());
+    size_t actualSize{};
+    auto rc = encode_pldm_pdr_repository_chg_event_data(
+        FORMAT_IS_PDR_HANDLES, eventDataOps.size(), eventDataOps.data(),
+        numsOfChangeEntries.data(), changeEntries.data(), eventData,
+        &actualSize, maxSize);
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to encode pldm pdr repository change event data, response code '{RC}'",
+            "RC", rc);
+        return {};
+    }
+    eventDataVec.resize(actualSize);
+
+    return eventDataVec;
+}
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "pdr_utils.hpp"
+
+#include <libpldm/platform.h>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+/** @struct ChangeRecord
+ *
+ *  An entry in the PDR change journal. Every add, delete or modify of a
+ *  record in the PDR repository is assigned a monotonically increasing change
+ *  number.
+ */
+struct ChangeRecord
+{
+    uint32_t changeNumber;
+    uint8_t operation;
+    RecordHandle recordHandle;
+};
+
+/** @brief Map of PDR repository change event operation (PLDM_RECORDS_ADDED,
+ *         PLDM_RECORDS_DELETED, PLDM_RECORDS_MODIFIED) to the record handles
+ *         affected by that operation
+ */
+using ChangeSet = std::map<uint8_t, std::vector<RecordHandle>>;
+
+/** @class ChangeJournal
+ *
+ *  @brief Tracks the changes made to a PDR repository so that a peer can be
+ *         sent the precise delta of records it has to add, delete or refetch
+ *         instead of rescanning the repository.
+ */
+class ChangeJournal
+{
+  public:
+    ChangeJournal() = default;
+    ChangeJournal(const ChangeJournal&) = delete;
+    ChangeJournal& operator=(const ChangeJournal&) = delete;
+    ChangeJournal(ChangeJournal&&) = default;
+    ChangeJournal& operator=(ChangeJournal&&) = default;
+    ~ChangeJournal() = default;
+
+    /** @brief Record a change to the PDR repository
+     *
+     *  @param[in] operation - PLDM_RECORDS_ADDED, PLDM_RECORDS_DELETED or
+     *                         PLDM_RECORDS_MODIFIED
+     *  @param[in] recordHandle - record handle of the changed PDR
+     *
+     *  @return uint32_t - the change number assigned to this change
+     */
+    uint32_t record(uint8_t operation, RecordHandle recordHandle);
+
+    /** @brief Record the records deleted from and added to a PDR repository
+     *         by a change made directly through libpldm, from the record
+     *         handles of the repository before and after the change
+     *
+     *  @param[in] before - record handles before the change
+     *  @param[in] after - record handles after the change
+     */
+    void recordDiff(std::vector<RecordHandle> before,
+                    std::vector<RecordHandle> after);
+
+    /** @brief Get the change number of the most recent change
+     *
+     *  @return uint32_t - last change number, 0 if nothing was journalled
+     */
+    uint32_t getChangeNumber() const
+    {
+        return changeNumber;
+    }
+
+    /** @brief Get the collapsed delta of the changes made after a change
+     *         number. A record added and deleted within the window is
+     *         dropped, a record deleted and re-added is reported as modified.
+     *
+     *  @param[in] since - the last change number already seen by the peer
+     *
+     *  @return ChangeSet - record handles per change operation
+     */
+    ChangeSet getChangesSince(uint32_t since) const;
+
+    /** @brief Drop the journal entries up to and including a change number,
+     *         typically once every peer has been sent those changes
+     *
+     *  @param[in] upTo - change number to trim to
+     */
+    void trim(uint32_t upTo);
+
+    /** @brief Drop all the journal entries. The change number is preserved
+     *         so that it stays monotonic across the repository lifetime.
+     */
+    void clear()
+    {
+        journal.clear();
+    }
+
+    /** @brief Check if the journal has no entries
+     *
+     *  @return bool - true if empty
+     */
+    bool empty() const
+    {
+        return journal.empty();
+    }
+
+  private:
+    /** @brief change number of the most recent journal entry */
+    uint32_t changeNumber = 0;
+
+    /** @brief journal entries, ordered by change number */
+    std::deque<ChangeRecord> journal;
+};
+
+/** @brief Encode a change set into the eventData of a PDR repository change
+ *         event with the FORMAT_IS_PDR_HANDLES event data format. One change
+ *         record is generated per non-empty change operation, split into
+ *         several change records of at most 255 entries each since the
+ *         number of change entries of a record is a uint8_t. A change set
+ *         needing more than 255 change records is encoded as a
+ *         REFRESH_ENTIRE_REPOSITORY event instead.
+ *
+ *  @param[in] changeSet - record handles per change operation
+ *
+ *  @return std::vector<uint8_t> - encoded eventData, empty if the change set
+ *          has no entries or encoding failed
+ */
+std::vector<uint8_t> encodeChangeSet(const ChangeSet& changeSet);
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
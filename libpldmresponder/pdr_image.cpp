@@ -0,0 +1,556 @@
+#include "pdr_image.hpp"
+
+#include <endian.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+namespace
+{
+
+/** @brief Version of the image layout
+ *
+ *  The image is the header (magic, version, key, last effecter and sensor
+ *  ids, number of records), the records as they are in the repository, each
+ *  preceded by its size, and then the effecter and the sensor D-Bus mapping
+ *  tables. Integers are in host byte order, the image is only read by the
+ *  BMC that wrote it.
+ */
+constexpr uint8_t imageVersion = 1;
+
+constexpr uint32_t imageMagic = 0x49524450; // "PDRI"
+
+/** @brief 64 bit FNV-1a hash of the PDR JSON inputs */
+class KeyHash
+{
+  public:
+    void update(std::span<const uint8_t> bytes)
+    {
+        for (auto byte : bytes)
+        {
+            hash = (hash ^ byte) * 0x100000001b3;
+        }
+    }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void update(T value)
+    {
+        update(std::span(reinterpret_cast<const uint8_t*>(&value),
+                         sizeof(value)));
+    }
+
+    void update(std::string_view str)
+    {
+        update(static_cast<uint64_t>(str.size()));
+        update(std::span(reinterpret_cast<const uint8_t*>(str.data()),
+                         str.size()));
+    }
+
+    uint64_t value() const
+    {
+        return hash;
+    }
+
+  private:
+    uint64_t hash = 0xcbf29ce484222325;
+};
+
+class ImageWriter
+{
+  public:
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    void put(T value)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        buf.insert(buf.end(), bytes, bytes + sizeof(value));
+    }
+
+    void put(std::span<const uint8_t> bytes)
+    {
+        buf.insert(buf.end(), bytes.begin(), bytes.end());
+    }
+
+    void put(std::string_view str)
+    {
+        put(static_cast<uint32_t>(str.size()));
+        put(std::span(reinterpret_cast<const uint8_t*>(str.data()),
+                      str.size()));
+    }
+
+    void put(const pldm::utils::PropertyValue& value)
+    {
+        put(static_cast<uint8_t>(value.index()));
+        std::visit(
+            [this](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
+                {
+                    put(static_cast<uint32_t>(v.size()));
+                    put(std::span(v));
+                }
+                else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+                {
+                    put(static_cast<uint32_t>(v.size()));
+                    for (const auto& str : v)
+                    {
+                        put(std::string_view(str));
+                    }
+                }
+                else if constexpr (std::is_same_v<T, std::string>)
+                {
+                    put(std::string_view(v));
+                }
+                else
+                {
+                    put(v);
+                }
+            },
+            value);
+    }
+
+    void put(const DbusObjMaps& objMaps)
+    {
+        put(static_cast<uint32_t>(objMaps.size()));
+        for (const auto& [id, objs] : objMaps)
+        {
+            const auto& [dbusMappings, dbusValMaps] = objs;
+            put(id);
+            put(static_cast<uint32_t>(dbusMappings.size()));
+            for (const auto& mapping : dbusMappings)
+            {
+                put(std::string_view(mapping.objectPath));
+                put(std::string_view(mapping.interface));
+                put(std::string_view(mapping.propertyName));
+                put(std::string_view(mapping.propertyType));
+            }
+            put(static_cast<uint32_t>(dbusValMaps.size()));
+            for (const auto& valMap : dbusValMaps)
+            {
+                put(static_cast<uint32_t>(valMap.size()));
+                for (const auto& [state, value] : valMap)
+                {
+                    put(state);
+                    put(value);
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> buf;
+};
+
+/** @brief Reads the image in place, every read fails once the image is
+ *         exhausted
+ */
+class ImageReader
+{
+  public:
+    explicit ImageReader(std::span<const uint8_t> image) : image(image) {}
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    bool get(T& value)
+    {
+        if (image.size() - offset < sizeof(value))
+        {
+            return false;
+        }
+        std::memcpy(&value, image.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return true;
+    }
+
+    bool get(size_t size, std::span<const uint8_t>& bytes)
+    {
+        if (image.size() - offset < size)
+        {
+            return false;
+        }
+        bytes = image.subspan(offset, size);
+        offset += size;
+        return true;
+    }
+
+    bool get(std::string& str)
+    {
+        uint32_t size = 0;
+        std::span<const uint8_t> bytes;
+        if (!get(size) || !get(size, bytes))
+        {
+            return false;
+        }
+        str.assign(bytes.begin(), bytes.end());
+        return true;
+    }
+
+    template <typename T>
+    bool getAs(pldm::utils::PropertyValue& value)
+    {
+        T v{};
+        if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
+        {
+            uint32_t size = 0;
+            std::span<const uint8_t> bytes;
+            if (!get(size) || !get(size, bytes))
+            {
+                return false;
+            }
+            v.assign(bytes.begin(), bytes.end());
+        }
+        else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+        {
+            uint32_t count = 0;
+            if (!get(count) || count > remaining())
+            {
+                return false;
+            }
+            v.resize(count);
+            for (auto& str : v)
+            {
+                if (!get(str))
+                {
+                    return false;
+                }
+            }
+        }
+        else if (!get(v))
+        {
+            return false;
+        }
+        value = std::move(v);
+        return true;
+    }
+
+    template <size_t... I>
+    bool get(size_t index, pldm::utils::PropertyValue& value,
+             std::index_sequence<I...>)
+    {
+        return (
+            (index == I &&
+             getAs<std::variant_alternative_t<I, pldm::utils::PropertyValue>>(
+                 value)) ||
+            ...);
+    }
+
+    bool get(pldm::utils::PropertyValue& value)
+    {
+        uint8_t index = 0;
+        return get(index) &&
+               get(index, value,
+                   std::make_index_sequence<std::variant_size_v<
+                       pldm::utils::PropertyValue>>{});
+    }
+
+    bool get(DbusObjMaps& objMaps)
+    {
+        uint32_t numObjs = 0;
+        if (!get(numObjs))
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < numObjs; i++)
+        {
+            uint16_t id = 0;
+            uint32_t numMappings = 0;
+            if (!get(id) || !get(numMappings) || numMappings > remaining())
+            {
+                return false;
+            }
+            DbusMappings dbusMappings(numMappings);
+            for (auto& mapping : dbusMappings)
+            {
+                if (!get(mapping.objectPath) || !get(mapping.interface) ||
+                    !get(mapping.propertyName) || !get(mapping.propertyType))
+                {
+                    return false;
+                }
+            }
+
+            uint32_t numValMaps = 0;
+            if (!get(numValMaps) || numValMaps > remaining())
+            {
+                return false;
+            }
+            DbusValMaps dbusValMaps(numValMaps);
+            for (auto& valMap : dbusValMaps)
+            {
+                uint32_t numValues = 0;
+                if (!get(numValues))
+                {
+                    return false;
+                }
+                for (uint32_t j = 0; j < numValues; j++)
+                {
+                    State state{};
+                    pldm::utils::PropertyValue value{};
+                    if (!get(state) || !get(value))
+                    {
+                        return false;
+                    }
+                    valMap.emplace(state, std::move(value));
+                }
+            }
+            objMaps.insert_or_assign(
+                id, std::make_tuple(std::move(dbusMappings),
+                                    std::move(dbusValMaps)));
+        }
+        return true;
+    }
+
+    /** @brief Bytes left in the image, bounds the element counts read from
+     *         it before anything is allocated for them
+     */
+    size_t remaining() const
+    {
+        return image.size() - offset;
+    }
+
+  private:
+    std::span<const uint8_t> image;
+    size_t offset = 0;
+};
+
+} // namespace
+
+std::optional<uint64_t>
+    PdrImageCache::key(const std::vector<std::filesystem::path>& dirs,
+                       const EntityMap& entities)
+{
+    KeyHash hash;
+    hash.update(imageVersion);
+    // The PDRs a build generates from the same JSONs may differ
+    hash.update(std::string_view(PDR_IMAGE_BUILD_ID));
+    for (const auto& dir : dirs)
+    {
+        hash.update(std::string_view(dir.native()));
+
+        std::error_code ec;
+        std::vector<std::filesystem::path> files;
+        for (const auto& dirEntry :
+             std::filesystem::directory_iterator(dir, ec))
+        {
+            if (dirEntry.is_regular_file(ec))
+            {
+                files.push_back(dirEntry.path());
+            }
+        }
+        if (ec)
+        {
+            return std::nullopt;
+        }
+        std::ranges::sort(files);
+
+        for (const auto& file : files)
+        {
+            std::ifstream stream(file, std::ios::in | std::ios::binary);
+            if (!stream)
+            {
+                return std::nullopt;
+            }
+            std::vector<uint8_t> contents{
+                std::istreambuf_iterator<char>(stream),
+                std::istreambuf_iterator<char>()};
+            hash.update(std::string_view(file.native()));
+            hash.update(static_cast<uint64_t>(contents.size()));
+            hash.update(std::span(contents));
+        }
+    }
+
+    for (const auto& [path, entity] : entities)
+    {
+        hash.update(std::string_view(path));
+        hash.update(entity.entity_type);
+        hash.update(entity.entity_instance_num);
+        hash.update(entity.entity_container_id);
+    }
+
+    return hash.value();
+}
+
+bool PdrImageCache::load(uint64_t key, RepoInterface& repo, PdrImage& image,
+                         const ImageCheck& check) const
+{
+    auto path = imagePath();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+    pldm::utils::CustomFD imageFd(fd);
+
+    struct stat sb;
+    if (fstat(fd, &sb) == -1 || sb.st_size == 0)
+    {
+        return false;
+    }
+
+    void* imageInMemory =
+        mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, imageFd(), 0);
+    if (MAP_FAILED == imageInMemory)
+    {
+        error("mmap on PDR image '{PATH}' failed with error {RC}", "PATH",
+              path, "RC", -errno);
+        return false;
+    }
+    auto cleanup = [sb](void* imageInMemory) {
+        munmap(imageInMemory, sb.st_size);
+    };
+    std::unique_ptr<void, decltype(cleanup)> imagePtr(imageInMemory, cleanup);
+
+    ImageReader reader(std::span(static_cast<const uint8_t*>(imageInMemory),
+                                 static_cast<size_t>(sb.st_size)));
+
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint64_t imageKey = 0;
+    uint32_t numRecords = 0;
+    PdrImage cached{};
+    if (!reader.get(magic) || magic != imageMagic || !reader.get(version) ||
+        version != imageVersion || !reader.get(imageKey))
+    {
+        error("Ignoring corrupted PDR image {PATH}", "PATH", path);
+        return false;
+    }
+    if (imageKey != key)
+    {
+        // The PDR JSONs, the system type or the entity association changed
+        return false;
+    }
+
+    /* Check the whole image before the first record is added, a corrupted
+     * image leaves the repository untouched
+     */
+    std::vector<std::span<const uint8_t>> records;
+    bool valid = reader.get(cached.lastEffecterId) &&
+                 reader.get(cached.lastSensorId) && reader.get(numRecords) &&
+                 numRecords <= reader.remaining();
+    for (uint32_t i = 0; valid && i < numRecords; i++)
+    {
+        uint32_t size = 0;
+        std::span<const uint8_t> record;
+        valid = reader.get(size) && size >= sizeof(pldm_pdr_hdr) &&
+                reader.get(size, record);
+        if (valid)
+        {
+            auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(record.data());
+            valid = le16toh(hdr->length) == size - sizeof(pldm_pdr_hdr);
+            records.push_back(record);
+        }
+    }
+    valid = valid && reader.get(cached.effecterObjMaps) &&
+            reader.get(cached.sensorObjMaps) && !reader.remaining();
+    if (!valid)
+    {
+        error("Ignoring corrupted PDR image {PATH}", "PATH", path);
+        return false;
+    }
+    if (check && !check(cached))
+    {
+        info("Ignoring PDR image {PATH} of other D-Bus objects", "PATH", path);
+        return false;
+    }
+
+    for (const auto& record : records)
+    {
+        // pldm_pdr_add() copies the record out of the image
+        PdrEntry pdrEntry{};
+        pdrEntry.data = const_cast<uint8_t*>(record.data());
+        pdrEntry.size = record.size();
+        repo.addRecord(pdrEntry);
+    }
+    image = std::move(cached);
+
+    return true;
+}
+
+bool PdrImageCache::store(uint64_t key, const RepoInterface& repo,
+                          const std::vector<RecordHandle>& recordHandles,
+                          const PdrImage& image) const
+{
+    ImageWriter writer;
+    writer.put(imageMagic);
+    writer.put(imageVersion);
+    writer.put(key);
+    writer.put(image.lastEffecterId);
+    writer.put(image.lastSensorId);
+
+    writer.put(static_cast<uint32_t>(recordHandles.size()));
+    for (const auto& recordHandle : recordHandles)
+    {
+        PdrEntry pdrEntry{};
+        if (!repo.getRecordByHandle(recordHandle, pdrEntry))
+        {
+            error("Failed to find PDR with record handle {RECORD_HANDLE}",
+                  "RECORD_HANDLE", recordHandle);
+            return false;
+        }
+        writer.put(pdrEntry.size);
+        writer.put(std::span(pdrEntry.data, pdrEntry.size));
+    }
+    writer.put(image.effecterObjMaps);
+    writer.put(image.sensorObjMaps);
+
+    /* Write a temporary file and rename it, a start never maps a partial
+     * image
+     */
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    auto path = imagePath();
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::out | std::ios::binary |
+                                          std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(writer.buf.data()),
+                     writer.buf.size());
+        if (!stream)
+        {
+            error("Failed to write PDR image {PATH}", "PATH", tmpPath);
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        error("Failed to store PDR image {PATH}, {ERROR}", "PATH", path,
+              "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+void PdrImageCache::invalidate() const
+{
+    std::error_code ec;
+    std::filesystem::remove(imagePath(), ec);
+}
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
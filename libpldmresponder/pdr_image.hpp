@@ -0,0 +1,130 @@
+#pragma once
+
+#include "pdr_utils.hpp"
+
+#include <libpldm/pdr.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+namespace pdr_utils
+{
+
+/** @brief Map of effecter/sensor id to its D-Bus mappings and state to D-Bus
+ *         value maps
+ */
+using DbusObjMaps =
+    std::map<uint16_t, std::tuple<DbusMappings, DbusValMaps>>;
+
+/** @brief Map of D-Bus object path to the entity associated with it */
+using EntityMap = std::map<std::string, pldm_entity>;
+
+/** @struct PdrImage
+ *
+ *  The state built alongside the PDRs generated from the PDR JSONs, kept in
+ *  the PDR image with the records
+ */
+struct PdrImage
+{
+    DbusObjMaps effecterObjMaps{};
+    DbusObjMaps sensorObjMaps{};
+
+    /** @brief Last effecter/sensor id handed out to a generated PDR */
+    uint16_t lastEffecterId = 0;
+    uint16_t lastSensorId = 0;
+};
+
+/**
+ * @brief PdrImageCache
+ *
+ * Persists the PDRs generated from the platform PDR JSONs together with their
+ * D-Bus mapping tables as a binary image, so that the following starts map
+ * the image and add its records to the repository instead of parsing the
+ * JSONs and looking up every D-Bus object again. The image is keyed by a hash
+ * of the build of pldmd, the JSON files, the system type directory they are
+ * read from and the entity association the PDRs are built against, and is
+ * replaced as soon as any of them changes. The key doesn't cover the D-Bus
+ * objects of the mapping tables, the caller checks that they still exist
+ * before the image is used.
+ */
+class PdrImageCache
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] cacheDir - directory of the image, created on the first
+     *                        store
+     */
+    explicit PdrImageCache(std::filesystem::path cacheDir) :
+        cacheDir(std::move(cacheDir))
+    {}
+
+    /** @brief Compute the key of the PDRs generated from a set of PDR JSON
+     *         directories
+     *
+     *  @param[in] dirs - PDR JSON directories, the system specific one last
+     *  @param[in] entities - entities associated to the D-Bus objects
+     *  @return the key, std::nullopt if a JSON file can't be read
+     */
+    static std::optional<uint64_t>
+        key(const std::vector<std::filesystem::path>& dirs,
+            const EntityMap& entities);
+
+    /** @brief Check of the D-Bus mapping tables of an image, before its
+     *         records are added
+     */
+    using ImageCheck = std::function<bool(const PdrImage& image)>;
+
+    /** @brief Add the records of the cached image to a repository
+     *
+     *  @param[in] key - key of the PDRs to be generated
+     *  @param[in] repo - the PDR repository
+     *  @param[out] image - D-Bus mapping tables and ids of the records
+     *  @param[in] check - the image is only used if it passes the check
+     *  @return true if an image of that key was found and added, the
+     *          repository is left untouched otherwise
+     */
+    bool load(uint64_t key, RepoInterface& repo, PdrImage& image,
+              const ImageCheck& check = {}) const;
+
+    /** @brief Cache the PDRs generated from the JSONs
+     *
+     *  @param[in] key - key of the generated PDRs
+     *  @param[in] repo - the PDR repository
+     *  @param[in] recordHandles - handles of the generated PDRs, in
+     *                             repository order
+     *  @param[in] image - D-Bus mapping tables and ids of the records
+     *  @return true if the image was written
+     */
+    bool store(uint64_t key, const RepoInterface& repo,
+               const std::vector<RecordHandle>& recordHandles,
+               const PdrImage& image) const;
+
+    /** @brief Drop the cached image */
+    void invalidate() const;
+
+  private:
+    /** @brief Path of the image */
+    std::filesystem::path imagePath() const
+    {
+        return cacheDir / "pdr_image";
+    }
+
+    /** @brief Directory of the image */
+    std::filesystem::path cacheDir;
+};
+
+} // namespace pdr_utils
+} // namespace responder
+} // namespace pldm
@@ -220,6 +220,7 @@ void generateNumericEffecterPDR(const DBusInterface& dBusIntf, const Json& json,
                 "D-Bus object path does not exist for effecter ID '{EFFECTER_ID}', error - {ERROR}",
                 "EFFECTER_ID", static_cast<uint16_t>(pdr->effecter_id), "ERROR",
                 e);
+            handler.dbusLookupFailed();
         }
         dbusMappings.emplace_back(std::move(dbusMapping));
         pdr->effecter_id = handler.getNextEffecterId();
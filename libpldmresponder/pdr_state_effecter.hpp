@@ -159,6 +159,7 @@ void generateStateEffecterPDR(const DBusInterface& dBusIntf, const Json& json,
                 error(
                     "Failed to create effecter PDR, D-Bus object '{PATH}' returned error - {ERROR}",
                     "PATH", objectPath, "ERROR", e);
+                handler.dbusLookupFailed();
                 break;
             }
             dbusMappings.emplace_back(std::move(dbusMapping));
@@ -6,6 +6,7 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <climits>
+#include <limits>
 
 PHOSPHOR_LOG2_USING;
 
@@ -26,6 +27,27 @@ static constexpr uint8_t fruRecordDataFormatLength = 7;
 // // 2: 1byte FRU Field Type, 1byte FRU Field Length
 static constexpr uint8_t fruFieldTypeLength = 2;
 
+Repo::Repo(pldm_pdr* repo) : RepoInterface(repo), index(sharedIndex(repo)) {}
+
+std::shared_ptr<Repo::Index> Repo::sharedIndex(const pldm_pdr* repo)
+{
+    static std::unordered_map<const pldm_pdr*, std::weak_ptr<Index>> indexes;
+    std::erase_if(indexes,
+                  [](const auto& item) { return item.second.expired(); });
+
+    auto& weakIndex = indexes[repo];
+    auto index = weakIndex.lock();
+    if (!index)
+    {
+        index = std::make_shared<Index>();
+        weakIndex = index;
+    }
+    // A wrapper left over from a destroyed repo at the same address must not
+    // hand its records to this one
+    index->stale = true;
+    return index;
+}
+
 pldm_pdr* Repo::getPdr() const
 {
     return repo;
@@ -41,9 +63,59 @@ RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
         // pldm_pdr_add() assert()ed on failure to add PDR
         throw std::runtime_error("Failed to add PDR");
     }
+    indexAppendedRecords(1);
     return handle;
 }
 
+RecordHandle Repo::addRemoteRecord(const PdrEntry& pdrEntry,
+                                   uint16_t terminusHandle)
+{
+    uint32_t handle = pdrEntry.handle.recordHandle;
+    int rc = pldm_pdr_add(repo, pdrEntry.data, pdrEntry.size, true,
+                          terminusHandle, &handle);
+    if (rc)
+    {
+        // pldm_pdr_add() assert()ed on failure to add PDR
+        throw std::runtime_error("Failed to add PDR");
+    }
+    indexAppendedRecords(1);
+    return handle;
+}
+
+int Repo::addRecords(const std::function<int(pldm_pdr*)>& add)
+{
+    auto recordCount = pldm_pdr_get_record_count(repo);
+    int rc = add(repo);
+    auto addedCount = pldm_pdr_get_record_count(repo) - recordCount;
+    if (addedCount)
+    {
+        indexAppendedRecords(addedCount);
+    }
+    return rc;
+}
+
+int Repo::removeRecord(RecordHandle recordHandle, bool isRemote)
+{
+    int rc = pldm_pdr_delete_by_record_handle(repo, recordHandle, isRemote);
+    if (!rc)
+    {
+        index->stale = true;
+    }
+    return rc;
+}
+
+void Repo::removeRecordsByTerminus(uint16_t terminusHandle)
+{
+    pldm_pdr_remove_pdrs_by_terminus_handle(repo, terminusHandle);
+    index->stale = true;
+}
+
+void Repo::removeRemoteRecords()
+{
+    pldm_pdr_remove_remote_pdrs(repo);
+    index->stale = true;
+}
+
 const pldm_pdr_record* Repo::getFirstRecord(PdrEntry& pdrEntry)
 {
     constexpr uint32_t firstNum = 0;
@@ -89,6 +161,136 @@ bool Repo::empty()
     return !getRecordCount();
 }
 
+const pldm_pdr_record* Repo::getRecordByHandle(RecordHandle recordHandle,
+                                               PdrEntry& pdrEntry) const
+{
+    refreshIndex();
+
+    // Record handle 0 is the first record of the repository
+    if (!recordHandle)
+    {
+        uint8_t* pdrData = nullptr;
+        auto record =
+            pldm_pdr_find_record(getPdr(), recordHandle, &pdrData,
+                                 &pdrEntry.size,
+                                 &pdrEntry.handle.nextRecordHandle);
+        if (record)
+        {
+            pdrEntry.data = pdrData;
+        }
+        return record;
+    }
+
+    auto it = index->handles.find(recordHandle);
+    if (it == index->handles.end())
+    {
+        return nullptr;
+    }
+
+    pdrEntry = it->second.entry;
+    return it->second.record;
+}
+
+std::vector<PdrEntry> Repo::getRecordsByType(Type pdrType) const
+{
+    refreshIndex();
+
+    auto it = index->types.find(pdrType);
+    if (it == index->types.end())
+    {
+        return {};
+    }
+    return it->second;
+}
+
+void Repo::refreshIndex() const
+{
+    if (!index->stale)
+    {
+        return;
+    }
+
+    index->handles.clear();
+    index->types.clear();
+    index->lastRecord = nullptr;
+
+    PdrEntry pdrEntry{};
+    uint8_t* pdrData = nullptr;
+    auto record = pldm_pdr_find_record(repo, 0, &pdrData, &pdrEntry.size,
+                                       &pdrEntry.handle.nextRecordHandle);
+    while (record)
+    {
+        pdrEntry.data = pdrData;
+        auto recordHandle = pldm_pdr_get_record_handle(repo, record);
+        index->handles.try_emplace(recordHandle, IndexEntry{record, pdrEntry});
+
+        PdrEntry typeEntry = pdrEntry;
+        typeEntry.handle.recordHandle = recordHandle;
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdrData);
+        index->types[pdrHdr->type].emplace_back(typeEntry);
+
+        index->lastRecord = record;
+        pdrData = nullptr;
+        record = pldm_pdr_get_next_record(repo, record, &pdrData,
+                                          &pdrEntry.size,
+                                          &pdrEntry.handle.nextRecordHandle);
+    }
+
+    index->stale = false;
+}
+
+void Repo::indexAppendedRecords(uint32_t count)
+{
+    // Records added to the repo normally follow the last indexed record.
+    // Records inserted anywhere else leave fewer than count records after it,
+    // the index is rebuilt on the next lookup then.
+    if (index->stale || !index->lastRecord)
+    {
+        index->stale = true;
+        return;
+    }
+
+    std::vector<IndexEntry> appended;
+    auto record = index->lastRecord;
+    PdrEntry pdrEntry{};
+    uint8_t* pdrData = nullptr;
+    while (appended.size() < count)
+    {
+        record = pldm_pdr_get_next_record(repo, record, &pdrData,
+                                          &pdrEntry.size,
+                                          &pdrEntry.handle.nextRecordHandle);
+        if (!record)
+        {
+            index->stale = true;
+            return;
+        }
+        pdrEntry.data = pdrData;
+        appended.emplace_back(IndexEntry{record, pdrEntry});
+    }
+
+    auto lastRecordHandle = pldm_pdr_get_record_handle(repo, index->lastRecord);
+    auto last = index->handles.find(lastRecordHandle);
+    if (last != index->handles.end() &&
+        last->second.record == index->lastRecord)
+    {
+        last->second.entry.handle.nextRecordHandle =
+            pldm_pdr_get_record_handle(repo, appended.front().record);
+    }
+
+    for (const auto& [appendedRecord, entry] : appended)
+    {
+        auto recordHandle = pldm_pdr_get_record_handle(repo, appendedRecord);
+        index->handles.try_emplace(recordHandle,
+                                   IndexEntry{appendedRecord, entry});
+        PdrEntry typeEntry = entry;
+        typeEntry.handle.recordHandle = recordHandle;
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(entry.data);
+        index->types[pdrHdr->type].emplace_back(typeEntry);
+    }
+
+    index->lastRecord = appended.back().record;
+}
+
 StatestoDbusVal populateMapping(const std::string& type, const Json& dBusValues,
                                 const PossibleValues& pv)
 {
@@ -158,6 +360,19 @@ StatestoDbusVal populateMapping(const std::string& type, const Json& dBusValues,
     return valueMap;
 }
 
+std::vector<RecordHandle> getRecordHandles(RepoInterface& repo)
+{
+    std::vector<RecordHandle> recordHandles;
+    PdrEntry pdrEntry{};
+    auto record = repo.getFirstRecord(pdrEntry);
+    while (record)
+    {
+        recordHandles.emplace_back(repo.getRecordHandle(record));
+        record = repo.getNextRecord(record, pdrEntry);
+    }
+    return recordHandles;
+}
+
 std::tuple<TerminusHandle, SensorID, SensorInfo>
     parseStateSensorPDR(const std::vector<uint8_t>& stateSensorPdr)
 {
@@ -224,44 +439,65 @@ std::vector<FruRecordDataFormat>
     }
 
     std::vector<FruRecordDataFormat> frus;
+    parseFruRecords(std::span(fruData, fruLen),
+                    std::numeric_limits<size_t>::max(), frus);
+
+    return frus;
+}
+
+size_t parseFruRecords(std::span<const uint8_t> fruData, size_t maxRecords,
+                       std::vector<FruRecordDataFormat>& records)
+{
+    // 5: uint16_t(FRU Record Set Identifier), uint8_t(FRU Record Type),
+    // uint8_t(Number of FRU fields), uint8_t(Encoding Type for FRU fields)
+    constexpr size_t recordHeaderLength =
+        fruRecordDataFormatLength - fruFieldTypeLength;
 
-    size_t index = 0;
-    while (index < fruLen)
+    size_t parsed = 0;
+    for (size_t count = 0; count < maxRecords; ++count)
     {
-        FruRecordDataFormat fru;
+        auto record = fruData.subspan(parsed);
+        if (record.size() < recordHeaderLength)
+        {
+            break;
+        }
 
-        auto record = reinterpret_cast<const pldm_fru_record_data_format*>(
-            fruData + index);
-        fru.fruRSI = (int)le16toh(record->record_set_id);
-        fru.fruRecType = record->record_type;
-        fru.fruNum = record->num_fru_fields;
-        fru.fruEncodeType = record->encoding_type;
-
-        index += 5;
-
-        std::ranges::for_each(
-            std::views::iota(0, (int)record->num_fru_fields),
-            [fruData, &fru, &index](int) {
-                auto tlv = reinterpret_cast<const pldm_fru_record_tlv*>(
-                    fruData + index);
-                FruTLV frutlv;
-                frutlv.fruFieldType = tlv->type;
-                frutlv.fruFieldLen = tlv->length;
-                frutlv.fruFieldValue.resize(tlv->length);
-                for (const auto& i : std::views::iota(0, (int)tlv->length))
-                {
-                    memcpy(frutlv.fruFieldValue.data() + i, tlv->value + i, 1);
-                }
-                fru.fruTLV.push_back(frutlv);
+        FruRecordDataFormat fru;
+        fru.fruRSI = static_cast<uint16_t>(record[0] | (record[1] << 8));
+        fru.fruRecType = record[2];
+        fru.fruNum = record[3];
+        fru.fruEncodeType = record[4];
+
+        size_t index = recordHeaderLength;
+        bool complete = true;
+        for (uint8_t field = 0; field < fru.fruNum; ++field)
+        {
+            if (record.size() - index < fruFieldTypeLength ||
+                record.size() - index - fruFieldTypeLength < record[index + 1])
+            {
+                complete = false;
+                break;
+            }
 
-                // 2: 1byte FRU Field Type, 1byte FRU Field Length
-                index += fruFieldTypeLength + (unsigned)tlv->length;
-            });
+            FruTLV frutlv;
+            frutlv.fruFieldType = record[index];
+            frutlv.fruFieldLen = record[index + 1];
+            auto value = record.subspan(index + fruFieldTypeLength,
+                                        frutlv.fruFieldLen);
+            frutlv.fruFieldValue.assign(value.begin(), value.end());
+            index += fruFieldTypeLength + frutlv.fruFieldLen;
+            fru.fruTLV.push_back(std::move(frutlv));
+        }
+        if (!complete)
+        {
+            break;
+        }
 
-        frus.push_back(fru);
+        records.push_back(std::move(fru));
+        parsed += index;
     }
 
-    return frus;
+    return parsed;
 }
 
 size_t getEffecterDataSize(uint8_t effecterDataSize)
@@ -14,7 +14,11 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -185,6 +189,65 @@ class RepoInterface
      */
     virtual bool empty() = 0;
 
+    /** @brief Get a PDR record by its record handle
+     *
+     *  @param[in] recordHandle - record handle of the PDR record
+     *  @param[out] pdrEntry - PDR records entry(data, size, nextRecordHandle)
+     *
+     *  @return opaque pointer acting as PDR record handle, will be NULL if
+     *          record was not found
+     */
+    virtual const pldm_pdr_record* getRecordByHandle(
+        RecordHandle recordHandle, PdrEntry& pdrEntry) const = 0;
+
+    /** @brief Get all the PDR records of a PDR type, in repository order
+     *
+     *  @param[in] pdrType - the type of PDRs
+     *
+     *  @return std::vector<PdrEntry> - PDR records entries(data, size,
+     *          recordHandle)
+     */
+    virtual std::vector<PdrEntry> getRecordsByType(Type pdrType) const = 0;
+
+    /** @brief Add a PDR record of a remote terminus to a PDR repository
+     *
+     *  @param[in] pdrEntry - PDR records entry(data, size, recordHandle)
+     *  @param[in] terminusHandle - terminus handle of the PDR record
+     *
+     *  @return uint32_t - record handle assigned to PDR record
+     */
+    virtual RecordHandle addRemoteRecord(const PdrEntry& pdrEntry,
+                                         uint16_t terminusHandle) = 0;
+
+    /** @brief Add PDR records through a libpldm helper, such as the ones
+     *         adding the FRU record set and entity association PDRs
+     *
+     *  @param[in] add - adds the records to the pldm_pdr it is given
+     *
+     *  @return int - return code of the helper
+     */
+    virtual int addRecords(const std::function<int(pldm_pdr*)>& add) = 0;
+
+    /** @brief Remove a PDR record from a PDR repository
+     *
+     *  @param[in] recordHandle - record handle of the PDR record
+     *  @param[in] isRemote - true if the record belongs to a remote terminus
+     *
+     *  @return int - 0 on success, negative error code otherwise
+     */
+    virtual int removeRecord(RecordHandle recordHandle, bool isRemote) = 0;
+
+    /** @brief Remove the PDR records of a terminus from a PDR repository
+     *
+     *  @param[in] terminusHandle - terminus handle of the PDR records
+     */
+    virtual void removeRecordsByTerminus(uint16_t terminusHandle) = 0;
+
+    /** @brief Remove the PDR records of all the remote termini from a PDR
+     *         repository
+     */
+    virtual void removeRemoteRecords() = 0;
+
   protected:
     pldm_pdr* repo;
 };
@@ -199,7 +262,7 @@ class RepoInterface
 class Repo : public RepoInterface
 {
   public:
-    Repo(pldm_pdr* repo) : RepoInterface(repo) {}
+    Repo(pldm_pdr* repo);
 
     pldm_pdr* getPdr() const override;
 
@@ -215,8 +278,96 @@ class Repo : public RepoInterface
     uint32_t getRecordCount() override;
 
     bool empty() override;
+
+    const pldm_pdr_record* getRecordByHandle(RecordHandle recordHandle,
+                                             PdrEntry& pdrEntry) const override;
+
+    std::vector<PdrEntry> getRecordsByType(Type pdrType) const override;
+
+    RecordHandle addRemoteRecord(const PdrEntry& pdrEntry,
+                                 uint16_t terminusHandle) override;
+
+    int addRecords(const std::function<int(pldm_pdr*)>& add) override;
+
+    int removeRecord(RecordHandle recordHandle, bool isRemote) override;
+
+    void removeRecordsByTerminus(uint16_t terminusHandle) override;
+
+    void removeRemoteRecords() override;
+
+  private:
+    /** @struct IndexEntry
+     *  Record pointer and entry (data, size, nextRecordHandle) of a PDR
+     */
+    struct IndexEntry
+    {
+        const pldm_pdr_record* record;
+        PdrEntry entry;
+    };
+
+    /** @struct Index
+     *  Lookup index of a pldm_pdr, shared by all the Repo wrappers of it so
+     *  that a change made through one of them is seen by the others
+     */
+    struct Index
+    {
+        /** @brief Map of record handle to record. If the repo holds
+         *         duplicate record handles, the first one wins as in
+         *         pldm_pdr_find_record.
+         */
+        std::unordered_map<RecordHandle, IndexEntry> handles;
+
+        /** @brief Map of PDR type to the entries of that type, in repo
+         *         order
+         */
+        std::unordered_map<Type, std::vector<PdrEntry>> types;
+
+        /** @brief last record of the repo when the index was built */
+        const pldm_pdr_record* lastRecord = nullptr;
+
+        /** @brief true if the index has to be rebuilt before the next
+         *         lookup
+         */
+        bool stale = true;
+    };
+
+    /** @brief Get the index shared by the Repo wrappers of a pldm_pdr
+     *
+     *  @param[in] repo - the pldm_pdr
+     *
+     *  @return the index, to be rebuilt on the next lookup
+     */
+    static std::shared_ptr<Index> sharedIndex(const pldm_pdr* repo);
+
+    /** @brief Rebuild the lookup index with a single walk of the repository
+     *         if it is stale
+     */
+    void refreshIndex() const;
+
+    /** @brief Add the records following the last indexed record to the index
+     *         without rebuilding it
+     *
+     *  @param[in] count - number of records appended to the repo
+     */
+    void indexAppendedRecords(uint32_t count);
+
+    /** @brief Remove a deleted record from the index without rebuilding it
+     *
+     *  @param[in] recordHandle - record handle of the deleted record
+     */
+    void unindexRecord(RecordHandle recordHandle);
+
+    std::shared_ptr<Index> index;
 };
 
+/** @brief Get the handles of the records of a PDR repository
+ *
+ *  @param[in] repo - the PDR repository
+ *
+ *  @return std::vector<RecordHandle> - record handles, in repository order
+ */
+std::vector<RecordHandle> getRecordHandles(RepoInterface& repo);
+
 /** @brief Parse the State Sensor PDR and return the parsed sensor info which
  *         will be used to lookup the sensor info in the PlatformEventMessage
  *         command of sensorEvent type.
@@ -241,6 +392,21 @@ std::tuple<pldm::pdr::TerminusHandle, pldm::pdr::SensorID,
 std::vector<FruRecordDataFormat>
     parseFruRecordTable(const uint8_t* fruData, size_t fruLen);
 
+/** @brief Parse the FRU records at the start of a part of a FRU record table,
+ *         as it is received. A record cut at the end of the part is left for
+ *         the next part.
+ *
+ *  @param[in] fruData - the FRU record table data received and not parsed yet
+ *  @param[in] maxRecords - number of records left in the table, the pad bytes
+ *                          and the checksum following the last one are not
+ *                          parsed
+ *  @param[out] records - the records parsed are appended to it
+ *
+ *  @return number of bytes of fruData parsed
+ */
+size_t parseFruRecords(std::span<const uint8_t> fruData, size_t maxRecords,
+                       std::vector<FruRecordDataFormat>& records);
+
 /** @brief Return the size of data type based on the effecterDataSize enum value
  *
  *  @param[in] effecterDataSize - Bitwidth and format of setting effecter value
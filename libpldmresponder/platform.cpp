@@ -20,6 +20,10 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+
 PHOSPHOR_LOG2_USING;
 
 using namespace pldm::utils;
@@ -36,6 +40,57 @@ using InternalFailure =
     sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
 
 static const Json empty{};
+static const AssociatedEntityMap noEntities{};
+
+/** @brief Check that the D-Bus objects of the mapping tables of a PDR image
+ *         still implement their interfaces, with a single mapper lookup
+ */
+static bool dbusObjectsExist(const DBusHandler& dBusIntf,
+                             const PdrImage& image)
+{
+    std::set<std::pair<std::string, std::string>> objects;
+    std::set<std::string> interfaces;
+    for (const auto* objMaps : {&image.effecterObjMaps, &image.sensorObjMaps})
+    {
+        for (const auto& [id, objs] : *objMaps)
+        {
+            for (const auto& mapping : std::get<DbusMappings>(objs))
+            {
+                objects.emplace(mapping.objectPath, mapping.interface);
+                interfaces.emplace(mapping.interface);
+            }
+        }
+    }
+    if (objects.empty())
+    {
+        return true;
+    }
+
+    try
+    {
+        auto subtree = dBusIntf.getSubtree(
+            "/", 0, std::vector<std::string>(interfaces.begin(),
+                                             interfaces.end()));
+        for (const auto& [path, services] : subtree)
+        {
+            for (const auto& [service, serviceInterfaces] : services)
+            {
+                for (const auto& interface : serviceInterfaces)
+                {
+                    objects.erase({path, interface});
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to look up the D-Bus objects of the PDR image, error - {ERROR}",
+            "ERROR", e);
+        return false;
+    }
+    return objects.empty();
+}
 
 void Handler::addDbusObjMaps(
     uint16_t id,
@@ -78,6 +133,34 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
         }
     }
 
+    std::optional<uint64_t> imageKey;
+    if (pdrImageCache)
+    {
+        imageKey = PdrImageCache::key(
+            dir, fruHandler ? getAssociateEntityMap() : noEntities);
+        PdrImage image{};
+        auto check = [&dBusIntf](const PdrImage& image) {
+            return dbusObjectsExist(dBusIntf, image);
+        };
+        if (imageKey && pdrImageCache->load(*imageKey, repo, image, check))
+        {
+            effecterDbusObjMaps.merge(image.effecterObjMaps);
+            sensorDbusObjMaps.merge(image.sensorObjMaps);
+            nextEffecterId = std::max(nextEffecterId, image.lastEffecterId);
+            nextSensorId = std::max(nextSensorId, image.lastSensorId);
+            return;
+        }
+    }
+    // The PDR image only caches the records generated from the JSONs
+    std::set<RecordHandle> previousRecords;
+    if (imageKey)
+    {
+        std::ranges::copy(getRecordHandles(repo),
+                          std::inserter(previousRecords,
+                                        previousRecords.end()));
+    }
+    pdrImageComplete = true;
+
     // A map of PDR type to a lambda that handles creation of that PDR type.
     // The lambda essentially would parse the platform specific PDR JSONs to
     // generate the PDR structures. This function iterates through the map to
@@ -140,6 +223,7 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                 error(
                     "PDR config directory '{PATH}' does not exist or empty for '{TYPE}' pdr, error - {ERROR}",
                     "PATH", dirEntry.path(), "TYPE", pdrType, "ERROR", e);
+                pdrImageComplete = false;
             }
             catch (const Json::exception& e)
             {
@@ -148,6 +232,7 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                     "TYPE", pdrType, "ERROR", e);
                 pldm::utils::reportError(
                     "xyz.openbmc_project.PLDM.Error.Generate.PDRJsonFileParseFail");
+                pdrImageComplete = false;
             }
             catch (const std::exception& e)
             {
@@ -156,9 +241,26 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                     "TYPE", pdrType, "ERROR", e);
                 pldm::utils::reportError(
                     "xyz.openbmc_project.PLDM.Error.Generate.PDRJsonFileParseFail");
+                pdrImageComplete = false;
             }
         }
     }
+
+    // The PDRs are only cached when every D-Bus object was found and every
+    // JSON parsed, so that a failure is retried and reported on every start
+    if (imageKey && pdrImageComplete)
+    {
+        std::vector<RecordHandle> recordHandles;
+        std::ranges::copy_if(getRecordHandles(repo),
+                             std::back_inserter(recordHandles),
+                             [&previousRecords](RecordHandle recordHandle) {
+                                 return !previousRecords.contains(recordHandle);
+                             });
+        pdrImageCache->store(
+            *imageKey, repo, recordHandles,
+            PdrImage{effecterDbusObjMaps, sensorDbusObjMaps, nextEffecterId,
+                     nextSensorId});
+    }
 }
 
 Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
@@ -181,6 +283,12 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
 
     if (!pdrCreated)
     {
+        std::vector<RecordHandle> recordHandles;
+        if (hostPDRHandler)
+        {
+            recordHandles = getRecordHandles(pdrRepo);
+        }
+
         generateTerminusLocatorPDR(pdrRepo);
         if (platformConfigHandler)
         {
@@ -201,6 +309,11 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
             oemPlatformHandler->buildOEMPDR(pdrRepo);
         }
         generate(*dBusIntf, pdrJsonsDir, pdrRepo);
+        if (hostPDRHandler)
+        {
+            hostPDRHandler->getChangeJournal().recordDiff(
+                std::move(recordHandles), getRecordHandles(pdrRepo));
+        }
 
         pdrCreated = true;
 
@@ -536,6 +649,7 @@ int Handler::pldmPDRRepositoryChgEvent(
     }
 
     PDRRecordHandles pdrRecordHandles;
+    PDRRecordHandles deletedRecordHandles;
 
     if (eventDataFormat == FORMAT_IS_PDR_TYPES)
     {
@@ -581,6 +695,20 @@ int Handler::pldmPDRRepositoryChgEvent(
                     return rc;
                 }
             }
+            else if (eventDataOperation == PLDM_RECORDS_DELETED)
+            {
+                rc = getPDRRecordHandles(
+                    reinterpret_cast<const ChangeEntry*>(
+                        changeRecordData + dataOffset),
+                    changeRecordDataSize - dataOffset,
+                    static_cast<size_t>(numberOfChangeEntries),
+                    deletedRecordHandles);
+
+                if (rc != PLDM_SUCCESS)
+                {
+                    return rc;
+                }
+            }
 
             changeRecordData +=
                 dataOffset + (numberOfChangeEntries * sizeof(ChangeEntry));
@@ -603,8 +731,10 @@ int Handler::pldmPDRRepositoryChgEvent(
             {
                 if (std::get<0>(it->second) == tid)
                 {
-                    pldm_pdr_remove_pdrs_by_terminus_handle(pdrRepo.getPdr(),
-                                                            it->first);
+                    auto recordHandles = getRecordHandles(pdrRepo);
+                    pdrRepo.removeRecordsByTerminus(it->first);
+                    hostPDRHandler->getChangeJournal().recordDiff(
+                        std::move(recordHandles), getRecordHandles(pdrRepo));
                     hostPDRHandler->tlPDRInfo.erase(it++);
                 }
                 else
@@ -613,6 +743,16 @@ int Handler::pldmPDRRepositoryChgEvent(
                 }
             }
         }
+        if (!deletedRecordHandles.empty())
+        {
+            hostPDRHandler->deletePDR(deletedRecordHandles);
+            if (pdrRecordHandles.empty())
+            {
+                // Nothing to fetch, an empty list would refetch the whole
+                // host repo
+                return PLDM_SUCCESS;
+            }
+        }
         hostPDRHandler->fetchPDR(std::move(pdrRecordHandles));
     }
 
@@ -1022,7 +1162,8 @@ void Handler::setEventReceiver()
     };
     rc = handler->registerRequest(
         eid, instanceId, PLDM_PLATFORM, PLDM_SET_EVENT_RECEIVER,
-        std::move(requestMsg), std::move(processSetEventReceiverResponse));
+        std::move(requestMsg), std::move(processSetEventReceiverResponse),
+        pldm::requester::RequestPriority::Control);
 
     if (rc != PLDM_SUCCESS)
     {
@@ -6,6 +6,7 @@
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/host_pdr_handler.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/pdr_image.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform_config.hpp"
 #include "oem_handler.hpp"
@@ -19,6 +20,7 @@
 
 #include <cstdint>
 #include <map>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -65,6 +67,11 @@ class Handler : public CmdHandler
         handler(handler), event(event), pdrJsonDir(pdrJsonDir),
         pdrCreated(false), pdrJsonsDir({pdrJsonDir})
     {
+        if (fruHandler)
+        {
+            fruHandler->setHostPDRHandler(hostPDRHandler);
+        }
+
         if (!buildPDRLazily)
         {
             generateTerminusLocatorPDR(pdrRepo);
@@ -186,7 +193,27 @@ class Handler : public CmdHandler
         return ++nextSensorId;
     }
 
-    /** @brief Parse PDR JSONs and build PDR repository
+    /** @brief Note that a PDR was left out, or built without its D-Bus
+     *         mapping, because a D-Bus lookup failed. The PDRs generated are
+     *         then not cached, the lookup is retried on the next start.
+     */
+    void dbusLookupFailed()
+    {
+        pdrImageComplete = false;
+    }
+
+    /** @brief Cache the PDRs generated from the PDR JSONs in a binary image,
+     *         which the following starts load instead of parsing the JSONs
+     *
+     *  @param[in] cacheDir - directory of the PDR image
+     */
+    void enablePdrImageCache(const fs::path& cacheDir)
+    {
+        pdrImageCache.emplace(cacheDir);
+    }
+
+    /** @brief Parse PDR JSONs and build PDR repository, from the PDR image
+     *         when it is cached for the same JSONs
      *
      *  @param[in] dBusIntf - The interface object
      *  @param[in] dir - directory housing platform specific PDR JSON files
@@ -499,6 +526,9 @@ class Handler : public CmdHandler
   private:
     uint8_t eid;
     InstanceIdDb* instanceIdDb;
+    /* Owned by the event loop thread, the platform commands are never
+     * offloaded to the responder worker pool
+     */
     pdr_utils::Repo pdrRepo;
     uint16_t nextEffecterId{};
     uint16_t nextSensorId{};
@@ -515,6 +545,8 @@ class Handler : public CmdHandler
     fs::path pdrJsonDir;
     bool pdrCreated;
     std::vector<fs::path> pdrJsonsDir;
+    std::optional<pdr_utils::PdrImageCache> pdrImageCache;
+    bool pdrImageComplete = true;
     std::unique_ptr<sdeventplus::source::Defer> deferredGetPDREvent;
 };
 
@@ -4,9 +4,13 @@
 
 #include <config.h>
 #include <libpldm/pdr.h>
+#include <libpldm/utils.h>
 
 #include <sdbusplus/message.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include <gtest/gtest.h>
 
 TEST(FruParser, allScenarios)
@@ -182,3 +186,290 @@ TEST(FruImpl, entityByObjectPath)
     entityPtr = mockedFruHandler.getEntityByObjectPath(invalidIface);
     ASSERT_TRUE(!entityPtr);
 }
+
+TEST(FruImpl, isPresent)
+{
+    using namespace pldm::responder::dbus;
+    constexpr auto item = "xyz.openbmc_project.Inventory.Item";
+
+    InterfaceMap present = {{item, {{"Present", true}}}};
+    EXPECT_TRUE(pldm::responder::FruImpl::isPresent(present));
+
+    InterfaceMap absent = {{item, {{"Present", false}}}};
+    EXPECT_FALSE(pldm::responder::FruImpl::isPresent(absent));
+
+    InterfaceMap noProperty = {{item, {}}};
+    EXPECT_FALSE(pldm::responder::FruImpl::isPresent(noProperty));
+
+    InterfaceMap noItem = {{"xyz.openbmc_project.Inventory.Item.Chassis", {}}};
+    EXPECT_FALSE(pldm::responder::FruImpl::isPresent(noItem));
+}
+
+class TestFruImpl : public ::testing::Test
+{
+  protected:
+    /** @brief Inventory of a system with a chassis, the part number of the
+     *         chassis fills the FRU table past a few 40 byte parts
+     */
+    static pldm::responder::dbus::ObjectValueTree chassisInventory()
+    {
+        return {{sdbusplus::message::object_path(
+                     "/xyz/openbmc_project/inventory/system"),
+                 {{"xyz.openbmc_project.Inventory.Item.System", {}}}},
+                {chassisPath,
+                 {{"xyz.openbmc_project.Inventory.Item.Chassis", {}},
+                  {"xyz.openbmc_project.Inventory.Item", {{"Present", true}}},
+                  {"xyz.openbmc_project.Inventory.Decorator.Asset",
+                   {{"PartNumber", std::string(100, 'p')}}}}}};
+    }
+
+    static inline const sdbusplus::message::object_path chassisPath{
+        "/xyz/openbmc_project/inventory/system/chassis"};
+
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo{
+        pldm_pdr_init(), pldm_pdr_destroy};
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree{pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy};
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree{pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy};
+
+    pldm::responder::FruImpl fruImpl{
+        FRU_JSONS_DIR, "./fru_jsons/fru_master/fru_master.json", pdrRepo.get(),
+        entityTree.get(), bmcEntityTree.get()};
+};
+
+TEST_F(TestFruImpl, emptyTableTransfer)
+{
+    // Only the checksum is transferred until the table is built
+    EXPECT_EQ(fruImpl.transferSize(), sizeof(uint32_t));
+    pldm::Response response(3, 0);
+    uint8_t transferFlag{};
+    EXPECT_EQ(fruImpl.getFRUTable(0, 0, response, transferFlag), 0u);
+    EXPECT_EQ(transferFlag, PLDM_START_AND_END);
+    EXPECT_EQ(response, pldm::Response(3 + sizeof(uint32_t), 0));
+}
+
+TEST_F(TestFruImpl, updateFRUTable)
+{
+    using namespace pldm::responder::dbus;
+    static constexpr auto asset =
+        "xyz.openbmc_project.Inventory.Decorator.Asset";
+    auto fru = [](const std::string& itemInterface,
+                  const std::string& partNumber) {
+        return InterfaceMap{
+            {itemInterface, {}},
+            {"xyz.openbmc_project.Inventory.Item", {{"Present", true}}},
+            {asset, {{"PartNumber", partNumber}}}};
+    };
+
+    // the number of children of each BMC's entity association PDR of a
+    // container
+    auto associations = [&](const pldm_entity& container) {
+        std::vector<size_t> children;
+        const pldm_pdr_record* record = nullptr;
+        uint8_t* data = nullptr;
+        uint32_t size = 0;
+        while ((record = pldm_pdr_find_record_by_type(
+                    pdrRepo.get(), PLDM_PDR_ENTITY_ASSOCIATION, record, &data,
+                    &size)))
+        {
+            size_t numEntities = 0;
+            pldm_entity* entities = nullptr;
+            pldm_entity_association_pdr_extract(data, size, &numEntities,
+                                                &entities);
+            if (numEntities &&
+                entities[0].entity_type == container.entity_type &&
+                entities[0].entity_instance_num ==
+                    container.entity_instance_num &&
+                entities[0].entity_container_id ==
+                    container.entity_container_id)
+            {
+                children.emplace_back(numEntities - 1);
+            }
+            free(entities);
+        }
+        return children;
+    };
+
+    const std::string chassis = "/xyz/openbmc_project/inventory/system/chassis";
+    const auto motherboard = chassis + "/motherboard";
+    const auto cpu0 = motherboard + "/cpu0";
+    const auto cpu1 = motherboard + "/cpu1";
+    ObjectValueTree inventory{
+        {sdbusplus::message::object_path(
+             "/xyz/openbmc_project/inventory/system"),
+         {{"xyz.openbmc_project.Inventory.Item.System", {}}}},
+        {sdbusplus::message::object_path(chassis),
+         fru("xyz.openbmc_project.Inventory.Item.Chassis", "chassis")},
+        {sdbusplus::message::object_path(motherboard),
+         fru("xyz.openbmc_project.Inventory.Item.Board.Motherboard",
+             "motherboard")}};
+    fruImpl.buildFRUTable(inventory);
+    ASSERT_EQ(fruImpl.numRSI(), 2);
+    const auto& entities = fruImpl.getAssociateEntityMap();
+    auto motherboardEntity = entities.at(motherboard);
+    EXPECT_TRUE(associations(motherboardEntity).empty());
+    auto recordCount = pldm_pdr_get_record_count(pdrRepo.get());
+
+    // Nothing changed
+    EXPECT_TRUE(fruImpl.updateFRUTable(inventory).empty());
+    auto checksum = fruImpl.checkSum();
+
+    // A property changed, the records are re-encoded and no PDR changes
+    inventory.at(sdbusplus::message::object_path(chassis))
+        .at(asset)
+        .at("PartNumber") = std::string("chassis2");
+    EXPECT_TRUE(fruImpl.updateFRUTable(inventory).empty());
+    EXPECT_NE(fruImpl.checkSum(), checksum);
+    EXPECT_EQ(fruImpl.numRSI(), 2);
+    EXPECT_EQ(pldm_pdr_get_record_count(pdrRepo.get()), recordCount);
+
+    // A FRU added to the motherboard, its FRU record set PDR and the first
+    // entity association PDR of the motherboard are added
+    inventory.emplace(sdbusplus::message::object_path(cpu0),
+                      fru("xyz.openbmc_project.Inventory.Item.Cpu", "cpu0"));
+    auto changes = fruImpl.updateFRUTable(inventory);
+    EXPECT_FALSE(changes.contains(PLDM_RECORDS_DELETED));
+    ASSERT_EQ(changes[PLDM_RECORDS_ADDED].size(), 2);
+    EXPECT_EQ(fruImpl.numRSI(), 3);
+    EXPECT_EQ(associations(motherboardEntity), std::vector<size_t>{1});
+    auto cpu0Entity = entities.at(cpu0);
+    auto associationHandle = changes[PLDM_RECORDS_ADDED][1];
+
+    // A second FRU, the entity association PDR of the motherboard is replaced
+    // instead of duplicated
+    inventory.emplace(sdbusplus::message::object_path(cpu1),
+                      fru("xyz.openbmc_project.Inventory.Item.Cpu", "cpu1"));
+    changes = fruImpl.updateFRUTable(inventory);
+    EXPECT_EQ(changes[PLDM_RECORDS_DELETED],
+              std::vector<uint32_t>{associationHandle});
+    ASSERT_EQ(changes[PLDM_RECORDS_ADDED].size(), 2);
+    EXPECT_EQ(fruImpl.numRSI(), 4);
+    EXPECT_EQ(associations(motherboardEntity), std::vector<size_t>{2});
+    auto cpu1RecordSetHandle = changes[PLDM_RECORDS_ADDED][0];
+    associationHandle = changes[PLDM_RECORDS_ADDED][1];
+
+    // A FRU removed, it is taken out of the tree and the entity association
+    // PDR of the motherboard
+    inventory.erase(sdbusplus::message::object_path(cpu0));
+    changes = fruImpl.updateFRUTable(inventory);
+    ASSERT_EQ(changes[PLDM_RECORDS_DELETED].size(), 2);
+    EXPECT_EQ(changes[PLDM_RECORDS_DELETED][1], associationHandle);
+    ASSERT_EQ(changes[PLDM_RECORDS_ADDED].size(), 1);
+    EXPECT_EQ(fruImpl.numRSI(), 3);
+    EXPECT_FALSE(entities.contains(cpu0));
+    EXPECT_EQ(pldm_entity_association_tree_find(entityTree.get(), &cpu0Entity),
+              nullptr);
+    EXPECT_EQ(associations(motherboardEntity), std::vector<size_t>{1});
+    associationHandle = changes[PLDM_RECORDS_ADDED][0];
+
+    // The last FRU no longer present, the motherboard is left without an
+    // entity association PDR
+    inventory.at(sdbusplus::message::object_path(cpu1))
+        .at("xyz.openbmc_project.Inventory.Item")
+        .at("Present") = false;
+    changes = fruImpl.updateFRUTable(inventory);
+    EXPECT_EQ(changes[PLDM_RECORDS_DELETED],
+              std::vector<uint32_t>({cpu1RecordSetHandle, associationHandle}));
+    EXPECT_FALSE(changes.contains(PLDM_RECORDS_ADDED));
+    EXPECT_EQ(fruImpl.numRSI(), 2);
+    EXPECT_TRUE(associations(motherboardEntity).empty());
+    EXPECT_EQ(pldm_pdr_get_record_count(pdrRepo.get()), recordCount);
+}
+
+TEST_F(TestFruImpl, tableTransferInParts)
+{
+    fruImpl.buildFRUTable(chassisInventory());
+
+    // The whole table in one part
+    pldm::Response table;
+    uint8_t transferFlag{};
+    EXPECT_EQ(fruImpl.getFRUTable(0, 0, table, transferFlag), 0u);
+    EXPECT_EQ(transferFlag, PLDM_START_AND_END);
+    ASSERT_EQ(table.size(), fruImpl.transferSize());
+    auto checksum = fruImpl.checkSum();
+    EXPECT_EQ(crc32(table.data(), table.size() - sizeof(checksum)), checksum);
+    EXPECT_TRUE(std::equal(table.end() - sizeof(checksum), table.end(),
+                           reinterpret_cast<const uint8_t*>(&checksum)));
+
+    // The same table in parts of 40 bytes
+    constexpr size_t partSize = 40;
+    pldm::Response parts;
+    std::vector<uint8_t> transferFlags;
+    uint32_t dataTransferHandle = 0;
+    do
+    {
+        ASSERT_TRUE(fruImpl.isValidTransferHandle(dataTransferHandle));
+        dataTransferHandle = fruImpl.getFRUTable(dataTransferHandle, partSize,
+                                                 parts, transferFlag);
+        transferFlags.emplace_back(transferFlag);
+        ASSERT_LE(transferFlags.size(), table.size() / partSize + 1);
+    } while (dataTransferHandle);
+    EXPECT_EQ(parts, table);
+    ASSERT_GE(transferFlags.size(), 3u);
+    EXPECT_EQ(transferFlags.front(), PLDM_START);
+    EXPECT_EQ(transferFlags[1], PLDM_MIDDLE);
+    EXPECT_EQ(transferFlags.back(), PLDM_END);
+}
+
+TEST_F(TestFruImpl, staleTransferHandle)
+{
+    auto inventory = chassisInventory();
+    fruImpl.buildFRUTable(inventory);
+
+    pldm::Response response;
+    uint8_t transferFlag{};
+    auto dataTransferHandle = fruImpl.getFRUTable(0, 40, response,
+                                                  transferFlag);
+    ASSERT_NE(dataTransferHandle, 0u);
+    EXPECT_TRUE(fruImpl.isValidTransferHandle(dataTransferHandle));
+
+    // A handle past the end of the table
+    EXPECT_FALSE(fruImpl.isValidTransferHandle(
+        (dataTransferHandle & 0xff000000) | fruImpl.transferSize()));
+
+    // The handles of the parts of the table before it changed
+    inventory.at(chassisPath)
+        .at("xyz.openbmc_project.Inventory.Decorator.Asset")
+        .at("PartNumber") = std::string(100, 'q');
+    EXPECT_TRUE(fruImpl.updateFRUTable(inventory).empty());
+    EXPECT_FALSE(fruImpl.isValidTransferHandle(dataTransferHandle));
+    EXPECT_TRUE(fruImpl.isValidTransferHandle(0));
+}
+
+TEST(ParseFruRecords, recordsCutAcrossParts)
+{
+    using namespace pldm::responder::pdr_utils;
+
+    // two records of record set 1 and 2, followed by the pad and checksum
+    std::vector<uint8_t> table{0x01, 0x00, 0xfe, 0x01, 0x01, 0x02,
+                               0x03, 'a',  'b',  'c',  0x02, 0x00,
+                               0x01, 0x02, 0x01, 0x02, 0x01, 'x',
+                               0x03, 0x01, 'y',  0x00, 0x11, 0x22,
+                               0x33, 0x44};
+    std::vector<FruRecordDataFormat> records;
+
+    // the first part cuts the second record
+    auto parsed = parseFruRecords(std::span(table).first(15), 2, records);
+    EXPECT_EQ(parsed, 10u);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].fruRSI, 1);
+    EXPECT_EQ(records[0].fruRecType, 0xfe);
+    ASSERT_EQ(records[0].fruTLV.size(), 1u);
+    EXPECT_EQ(records[0].fruTLV[0].fruFieldType, 2);
+    EXPECT_EQ(records[0].fruTLV[0].fruFieldValue,
+              std::vector<uint8_t>({'a', 'b', 'c'}));
+
+    // the pad bytes and the checksum after the last record are not parsed
+    parsed = parseFruRecords(std::span(table).subspan(parsed), 1, records);
+    EXPECT_EQ(parsed, 11u);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].fruRSI, 2);
+    ASSERT_EQ(records[1].fruTLV.size(), 2u);
+    EXPECT_EQ(records[1].fruTLV[1].fruFieldType, 3);
+    EXPECT_EQ(records[1].fruTLV[1].fruFieldValue, std::vector<uint8_t>({'y'}));
+}
@@ -0,0 +1,194 @@
+#include "libpldmresponder/pdr_change_journal.hpp"
+
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::pdr_utils;
+
+TEST(ChangeJournal, changeNumberIsMonotonic)
+{
+    ChangeJournal journal;
+    EXPECT_EQ(journal.getChangeNumber(), 0);
+    EXPECT_TRUE(journal.empty());
+
+    EXPECT_EQ(journal.record(PLDM_RECORDS_ADDED, 10), 1);
+    EXPECT_EQ(journal.record(PLDM_RECORDS_MODIFIED, 11), 2);
+    EXPECT_EQ(journal.getChangeNumber(), 2);
+
+    journal.clear();
+    EXPECT_TRUE(journal.empty());
+    EXPECT_EQ(journal.record(PLDM_RECORDS_DELETED, 12), 3);
+}
+
+TEST(ChangeJournal, getChangesSinceCollapsesOperations)
+{
+    ChangeJournal journal;
+    journal.record(PLDM_RECORDS_ADDED, 1);
+    auto seen = journal.record(PLDM_RECORDS_ADDED, 2);
+
+    // added and deleted in the window, dropped
+    journal.record(PLDM_RECORDS_ADDED, 3);
+    journal.record(PLDM_RECORDS_DELETED, 3);
+    // deleted and re-added, modified
+    journal.record(PLDM_RECORDS_DELETED, 1);
+    journal.record(PLDM_RECORDS_ADDED, 1);
+    // modified and deleted, deleted
+    journal.record(PLDM_RECORDS_MODIFIED, 2);
+    journal.record(PLDM_RECORDS_DELETED, 2);
+    journal.record(PLDM_RECORDS_ADDED, 4);
+
+    auto changeSet = journal.getChangesSince(seen);
+    EXPECT_EQ(changeSet.size(), 3);
+    EXPECT_EQ(changeSet[PLDM_RECORDS_ADDED], std::vector<RecordHandle>{4});
+    EXPECT_EQ(changeSet[PLDM_RECORDS_DELETED], std::vector<RecordHandle>{2});
+    EXPECT_EQ(changeSet[PLDM_RECORDS_MODIFIED], std::vector<RecordHandle>{1});
+
+    changeSet = journal.getChangesSince(0);
+    EXPECT_EQ(changeSet.size(), 1);
+    EXPECT_EQ(changeSet[PLDM_RECORDS_ADDED],
+              (std::vector<RecordHandle>{1, 4}));
+
+    EXPECT_TRUE(journal.getChangesSince(journal.getChangeNumber()).empty());
+}
+
+TEST(ChangeJournal, trim)
+{
+    ChangeJournal journal;
+    journal.record(PLDM_RECORDS_ADDED, 1);
+    auto seen = journal.record(PLDM_RECORDS_ADDED, 2);
+    journal.record(PLDM_RECORDS_ADDED, 3);
+
+    journal.trim(seen);
+    auto changeSet = journal.getChangesSince(0);
+    EXPECT_EQ(changeSet[PLDM_RECORDS_ADDED], std::vector<RecordHandle>{3});
+
+    journal.trim(journal.getChangeNumber());
+    EXPECT_TRUE(journal.empty());
+}
+
+TEST(ChangeJournal, encodeChangeSet)
+{
+    EXPECT_TRUE(encodeChangeSet({}).empty());
+
+    ChangeSet changeSet{{PLDM_RECORDS_ADDED, {1, 2}},
+                        {PLDM_RECORDS_DELETED, {3}}};
+    auto eventData = encodeChangeSet(changeSet);
+    ASSERT_EQ(eventData.size(),
+              PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH +
+                  2 * PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
+                  3 * sizeof(uint32_t));
+
+    uint8_t eventDataFormat{};
+    uint8_t numberOfChangeRecords{};
+    size_t dataOffset{};
+    auto rc = decode_pldm_pdr_repository_chg_event_data(
+        eventData.data(), eventData.size(), &eventDataFormat,
+        &numberOfChangeRecords, &dataOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(eventDataFormat, FORMAT_IS_PDR_HANDLES);
+    EXPECT_EQ(numberOfChangeRecords, 2);
+
+    uint8_t eventDataOperation{};
+    uint8_t numberOfChangeEntries{};
+    size_t changeRecordOffset{};
+    rc = decode_pldm_pdr_repository_change_record_data(
+        eventData.data() + dataOffset, eventData.size() - dataOffset,
+        &eventDataOperation, &numberOfChangeEntries, &changeRecordOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(eventDataOperation, PLDM_RECORDS_ADDED);
+    EXPECT_EQ(numberOfChangeEntries, 2);
+}
+
+TEST(ChangeJournal, encodeChangeSetSplitsLargeRecords)
+{
+    ChangeSet changeSet{};
+    for (RecordHandle handle = 1; handle <= 300; ++handle)
+    {
+        changeSet[PLDM_RECORDS_ADDED].push_back(handle);
+    }
+    auto eventData = encodeChangeSet(changeSet);
+
+    uint8_t eventDataFormat{};
+    uint8_t numberOfChangeRecords{};
+    size_t dataOffset{};
+    auto rc = decode_pldm_pdr_repository_chg_event_data(
+        eventData.data(), eventData.size(), &eventDataFormat,
+        &numberOfChangeRecords, &dataOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(numberOfChangeRecords, 2);
+}
+
+TEST(ChangeJournal, encodeChangeSetRefreshesLargeSets)
+{
+    ChangeSet changeSet{};
+    for (RecordHandle handle = 1; handle <= 255 * 255 + 1; ++handle)
+    {
+        changeSet[PLDM_RECORDS_ADDED].push_back(handle);
+    }
+    EXPECT_EQ(encodeChangeSet(changeSet),
+              (std::vector<uint8_t>{REFRESH_ENTIRE_REPOSITORY, 0}));
+}
+
+TEST(ChangeJournal, removeTerminus)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr));
+    reinterpret_cast<pldm_pdr_hdr*>(pdr.data())->type = PLDM_STATE_SENSOR_PDR;
+
+    // Records of the terminus handles 1, 2, 1, 2
+    std::vector<RecordHandle> recordHandles;
+    for (uint16_t terminusHandle : {1, 2, 1, 2})
+    {
+        PdrEntry entry{};
+        entry.data = pdr.data();
+        entry.size = pdr.size();
+        recordHandles.push_back(repo.addRemoteRecord(entry, terminusHandle));
+    }
+
+    ChangeJournal journal;
+    journal.record(PLDM_RECORDS_ADDED, recordHandles[0]);
+    auto seen = journal.getChangeNumber();
+
+    auto before = getRecordHandles(repo);
+    repo.removeRecordsByTerminus(2);
+    journal.recordDiff(std::move(before), getRecordHandles(repo));
+
+    auto changeSet = journal.getChangesSince(seen);
+    ASSERT_EQ(changeSet.size(), 1);
+    EXPECT_EQ(changeSet[PLDM_RECORDS_DELETED],
+              (std::vector<RecordHandle>{recordHandles[1], recordHandles[3]}));
+
+    auto eventData = encodeChangeSet(changeSet);
+    uint8_t eventDataFormat{};
+    uint8_t numberOfChangeRecords{};
+    size_t dataOffset{};
+    auto rc = decode_pldm_pdr_repository_chg_event_data(
+        eventData.data(), eventData.size(), &eventDataFormat,
+        &numberOfChangeRecords, &dataOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(eventDataFormat, FORMAT_IS_PDR_HANDLES);
+    ASSERT_EQ(numberOfChangeRecords, 1);
+
+    uint8_t eventDataOperation{};
+    uint8_t numberOfChangeEntries{};
+    size_t changeRecordOffset{};
+    rc = decode_pldm_pdr_repository_change_record_data(
+        eventData.data() + dataOffset, eventData.size() - dataOffset,
+        &eventDataOperation, &numberOfChangeEntries, &changeRecordOffset);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(eventDataOperation, PLDM_RECORDS_DELETED);
+    ASSERT_EQ(numberOfChangeEntries, 2);
+
+    std::vector<RecordHandle> changeEntries(numberOfChangeEntries);
+    std::memcpy(changeEntries.data(),
+                eventData.data() + dataOffset + changeRecordOffset,
+                changeEntries.size() * sizeof(RecordHandle));
+    EXPECT_EQ(changeEntries, changeSet[PLDM_RECORDS_DELETED]);
+
+    pldm_pdr_destroy(pdrRepo);
+}
@@ -0,0 +1,246 @@
+#include "libpldmresponder/pdr_image.hpp"
+
+#include <libpldm/entity.h>
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <cstdlib>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::pdr_utils;
+
+class PdrImageTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_pdr_image.XXXXXX";
+        dir = std::filesystem::path(mkdtemp(tmpdir));
+        std::filesystem::create_directories(dir / "pdr");
+        writeJson(R"({"effecterPDRs": []})");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    void writeJson(const std::string& json)
+    {
+        std::ofstream(dir / "pdr" / "effecter.json") << json;
+    }
+
+    static RecordHandle addRecord(RepoInterface& repo, uint8_t type,
+                                  uint8_t fill, size_t payloadSize)
+    {
+        std::vector<uint8_t> record(sizeof(pldm_pdr_hdr) + payloadSize, fill);
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(record.data());
+        hdr->record_handle = 0;
+        hdr->version = 1;
+        hdr->type = type;
+        hdr->record_change_num = 0;
+        hdr->length = htole16(payloadSize);
+
+        PdrEntry pdrEntry{};
+        pdrEntry.data = record.data();
+        pdrEntry.size = record.size();
+        return repo.addRecord(pdrEntry);
+    }
+
+    static std::vector<std::vector<uint8_t>> records(RepoInterface& repo)
+    {
+        std::vector<std::vector<uint8_t>> records;
+        PdrEntry pdrEntry{};
+        auto record = repo.getFirstRecord(pdrEntry);
+        while (record)
+        {
+            records.emplace_back(pdrEntry.data, pdrEntry.data + pdrEntry.size);
+            record = repo.getNextRecord(record, pdrEntry);
+        }
+        return records;
+    }
+
+    static PdrImage makeImage()
+    {
+        PdrImage image{};
+        image.lastEffecterId = 1;
+        image.lastSensorId = 1;
+        image.effecterObjMaps.emplace(
+            1, std::make_tuple(
+                   DbusMappings{{"/xyz/openbmc_project/control/host0",
+                                 "xyz.openbmc_project.Control.Boot.Mode",
+                                 "BootMode", "string"}},
+                   DbusValMaps{{{1, std::string("Regular")},
+                                {2, std::string("Safe")}}}));
+        image.sensorObjMaps.emplace(
+            1, std::make_tuple(
+                   DbusMappings{{"/xyz/openbmc_project/state/host0",
+                                 "xyz.openbmc_project.State.Host",
+                                 "RequestedHostTransition", "bool"}},
+                   DbusValMaps{{{0, false}, {1, true}}}));
+        return image;
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(PdrImageTest, storeLoad)
+{
+    PdrImageCache cache(dir / "cache");
+    auto key = PdrImageCache::key({dir / "pdr"}, {});
+    ASSERT_TRUE(key.has_value());
+
+    auto generatedRepo = pldm_pdr_init();
+    Repo generated(generatedRepo);
+    // built before the JSON PDRs, like the terminus locator PDR
+    addRecord(generated, PLDM_TERMINUS_LOCATOR_PDR, 0xaa, 8);
+    std::vector<RecordHandle> recordHandles{
+        addRecord(generated, PLDM_STATE_EFFECTER_PDR, 0x11, 20),
+        addRecord(generated, PLDM_STATE_SENSOR_PDR, 0x22, 30)};
+    auto image = makeImage();
+    ASSERT_TRUE(cache.store(*key, generated, recordHandles, image));
+
+    auto loadedRepo = pldm_pdr_init();
+    Repo loaded(loadedRepo);
+    addRecord(loaded, PLDM_TERMINUS_LOCATOR_PDR, 0xaa, 8);
+    PdrImage cached{};
+    ASSERT_TRUE(cache.load(*key, loaded, cached));
+
+    EXPECT_EQ(records(generated), records(loaded));
+    EXPECT_EQ(cached.lastEffecterId, image.lastEffecterId);
+    EXPECT_EQ(cached.lastSensorId, image.lastSensorId);
+    ASSERT_EQ(cached.effecterObjMaps.size(), 1);
+    const auto& [mappings, valMaps] = cached.effecterObjMaps.at(1);
+    ASSERT_EQ(mappings.size(), 1);
+    EXPECT_EQ(mappings[0].objectPath, "/xyz/openbmc_project/control/host0");
+    EXPECT_EQ(mappings[0].propertyName, "BootMode");
+    EXPECT_EQ(valMaps, std::get<DbusValMaps>(image.effecterObjMaps.at(1)));
+    EXPECT_EQ(std::get<DbusValMaps>(cached.sensorObjMaps.at(1)),
+              std::get<DbusValMaps>(image.sensorObjMaps.at(1)));
+
+    pldm_pdr_destroy(generatedRepo);
+    pldm_pdr_destroy(loadedRepo);
+}
+
+TEST_F(PdrImageTest, keyChangesWithInputs)
+{
+    PdrImageCache cache(dir / "cache");
+    auto key = PdrImageCache::key({dir / "pdr"}, {});
+    ASSERT_TRUE(key.has_value());
+
+    auto generatedRepo = pldm_pdr_init();
+    Repo generated(generatedRepo);
+    auto recordHandle = addRecord(generated, PLDM_STATE_EFFECTER_PDR, 0x11, 20);
+    ASSERT_TRUE(cache.store(*key, generated, {recordHandle}, makeImage()));
+
+    EntityMap entities{{"/xyz/openbmc_project/inventory/system",
+                        pldm_entity{PLDM_ENTITY_SYSTEM_CHASSIS, 1, 0}}};
+    auto entityKey = PdrImageCache::key({dir / "pdr"}, entities);
+    EXPECT_NE(entityKey, key);
+
+    std::filesystem::create_directories(dir / "pdr" / "system");
+    auto systemKey = PdrImageCache::key({dir / "pdr", dir / "pdr" / "system"},
+                                        {});
+    EXPECT_NE(systemKey, key);
+
+    writeJson(R"({"effecterPDRs": [{"pdrType": 11}]})");
+    auto jsonKey = PdrImageCache::key({dir / "pdr"}, {});
+    EXPECT_NE(jsonKey, key);
+
+    auto loadedRepo = pldm_pdr_init();
+    Repo loaded(loadedRepo);
+    PdrImage cached{};
+    EXPECT_FALSE(cache.load(*jsonKey, loaded, cached));
+    EXPECT_TRUE(loaded.empty());
+
+    pldm_pdr_destroy(generatedRepo);
+    pldm_pdr_destroy(loadedRepo);
+}
+
+TEST_F(PdrImageTest, corruptedImage)
+{
+    PdrImageCache cache(dir / "cache");
+    auto key = PdrImageCache::key({dir / "pdr"}, {});
+    ASSERT_TRUE(key.has_value());
+
+    auto generatedRepo = pldm_pdr_init();
+    Repo generated(generatedRepo);
+    std::vector<RecordHandle> recordHandles{
+        addRecord(generated, PLDM_STATE_EFFECTER_PDR, 0x11, 20),
+        addRecord(generated, PLDM_STATE_SENSOR_PDR, 0x22, 30)};
+    ASSERT_TRUE(cache.store(*key, generated, recordHandles, makeImage()));
+
+    // truncate the sensor D-Bus mapping table
+    auto path = dir / "cache" / "pdr_image";
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    auto loadedRepo = pldm_pdr_init();
+    Repo loaded(loadedRepo);
+    PdrImage cached{};
+    EXPECT_FALSE(cache.load(*key, loaded, cached));
+    EXPECT_TRUE(loaded.empty());
+
+    cache.invalidate();
+    EXPECT_FALSE(std::filesystem::exists(path));
+
+    pldm_pdr_destroy(generatedRepo);
+    pldm_pdr_destroy(loadedRepo);
+}
+
+TEST_F(PdrImageTest, generatedRecordsOnly)
+{
+    PdrImageCache cache(dir / "cache");
+    auto key = PdrImageCache::key({dir / "pdr"}, {});
+    ASSERT_TRUE(key.has_value());
+
+    auto generatedRepo = pldm_pdr_init();
+    Repo generated(generatedRepo);
+    addRecord(generated, PLDM_TERMINUS_LOCATOR_PDR, 0xaa, 8);
+    auto recordHandle = addRecord(generated, PLDM_STATE_EFFECTER_PDR, 0x11, 20);
+    // added after the JSON PDRs by another handler
+    addRecord(generated, PLDM_PDR_FRU_RECORD_SET, 0x33, 10);
+    ASSERT_TRUE(cache.store(*key, generated, {recordHandle}, makeImage()));
+
+    auto loadedRepo = pldm_pdr_init();
+    Repo loaded(loadedRepo);
+    addRecord(loaded, PLDM_TERMINUS_LOCATOR_PDR, 0xaa, 8);
+    PdrImage cached{};
+    ASSERT_TRUE(cache.load(*key, loaded, cached));
+    auto loadedRecords = records(loaded);
+    ASSERT_EQ(loadedRecords.size(), 2);
+    EXPECT_EQ(loadedRecords[1], records(generated)[1]);
+
+    pldm_pdr_destroy(generatedRepo);
+    pldm_pdr_destroy(loadedRepo);
+}
+
+TEST_F(PdrImageTest, failedCheck)
+{
+    PdrImageCache cache(dir / "cache");
+    auto key = PdrImageCache::key({dir / "pdr"}, {});
+    ASSERT_TRUE(key.has_value());
+
+    auto generatedRepo = pldm_pdr_init();
+    Repo generated(generatedRepo);
+    auto recordHandle = addRecord(generated, PLDM_STATE_EFFECTER_PDR, 0x11, 20);
+    ASSERT_TRUE(cache.store(*key, generated, {recordHandle}, makeImage()));
+
+    // a D-Bus object of the mapping tables is gone
+    auto loadedRepo = pldm_pdr_init();
+    Repo loaded(loadedRepo);
+    PdrImage cached{};
+    bool checked = false;
+    EXPECT_FALSE(cache.load(*key, loaded, cached,
+                            [&checked](const PdrImage& image) {
+                                checked = true;
+                                return image.effecterObjMaps.empty();
+                            }));
+    EXPECT_TRUE(checked);
+    EXPECT_TRUE(loaded.empty());
+    EXPECT_TRUE(cached.effecterObjMaps.empty());
+
+    pldm_pdr_destroy(generatedRepo);
+    pldm_pdr_destroy(loadedRepo);
+}
@@ -780,6 +780,92 @@ TEST(TerminusLocatorPDR, BMCTerminusLocatorPDR)
     pldm_pdr_destroy(outPDRRepo);
 }
 
+TEST(PdrRepoIndex, lookupsTrackRepoChanges)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    auto makePdr = [](uint8_t type) {
+        std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr), 0);
+        reinterpret_cast<pldm_pdr_hdr*>(pdr.data())->type = type;
+        return pdr;
+    };
+
+    auto effecterPdr = makePdr(PLDM_STATE_EFFECTER_PDR);
+    auto sensorPdr = makePdr(PLDM_STATE_SENSOR_PDR);
+    PdrEntry entry{};
+    entry.data = effecterPdr.data();
+    entry.size = effecterPdr.size();
+    entry.handle.recordHandle = 0;
+    EXPECT_EQ(repo.addRecord(entry), 1);
+
+    PdrEntry e{};
+    ASSERT_NE(repo.getRecordByHandle(1, e), nullptr);
+    EXPECT_EQ(e.handle.nextRecordHandle, 0);
+
+    // Appended through the wrapper, the index is updated in place
+    entry.data = sensorPdr.data();
+    entry.size = sensorPdr.size();
+    entry.handle.recordHandle = 0;
+    EXPECT_EQ(repo.addRecord(entry), 2);
+    ASSERT_NE(repo.getRecordByHandle(1, e), nullptr);
+    EXPECT_EQ(e.handle.nextRecordHandle, 2);
+    ASSERT_NE(repo.getRecordByHandle(2, e), nullptr);
+    EXPECT_EQ(e.handle.nextRecordHandle, 0);
+
+    // Appended through a libpldm helper by another wrapper of the repo, the
+    // index shared by the wrappers follows
+    Repo other(pdrRepo);
+    uint32_t handle = 0;
+    auto rc = other.addRecords([&](pldm_pdr* bmcRepo) {
+        return pldm_pdr_add(bmcRepo, effecterPdr.data(), effecterPdr.size(),
+                            false, 1, &handle);
+    });
+    ASSERT_EQ(rc, 0);
+    ASSERT_NE(repo.getRecordByHandle(handle, e), nullptr);
+    ASSERT_NE(repo.getRecordByHandle(2, e), nullptr);
+    EXPECT_EQ(e.handle.nextRecordHandle, handle);
+    EXPECT_EQ(repo.getRecordByHandle(handle + 1, e), nullptr);
+
+    // Record handle 0 is the first record
+    ASSERT_NE(repo.getRecordByHandle(0, e), nullptr);
+    EXPECT_EQ(e.handle.nextRecordHandle, 2);
+
+    auto effecters = repo.getRecordsByType(PLDM_STATE_EFFECTER_PDR);
+    ASSERT_EQ(effecters.size(), 2);
+    EXPECT_EQ(effecters[0].handle.recordHandle, 1);
+    EXPECT_EQ(effecters[1].handle.recordHandle, handle);
+    EXPECT_EQ(repo.getRecordsByType(PLDM_STATE_SENSOR_PDR).size(), 1);
+    EXPECT_TRUE(repo.getRecordsByType(PLDM_NUMERIC_EFFECTER_PDR).empty());
+
+    // A record replaced by one of the same size, the index must not hand out
+    // the deleted one
+    ASSERT_EQ(other.removeRecord(handle, false), 0);
+    entry.data = sensorPdr.data();
+    entry.size = sensorPdr.size();
+    entry.handle.recordHandle = 0;
+    auto newHandle = other.addRecord(entry);
+    ASSERT_NE(repo.getRecordByHandle(2, e), nullptr);
+    EXPECT_EQ(e.handle.nextRecordHandle, newHandle);
+    ASSERT_NE(repo.getRecordByHandle(newHandle, e), nullptr);
+    EXPECT_EQ(reinterpret_cast<const pldm_pdr_hdr*>(e.data)->type,
+              PLDM_STATE_SENSOR_PDR);
+    EXPECT_EQ(repo.getRecordsByType(PLDM_STATE_EFFECTER_PDR).size(), 1);
+    EXPECT_EQ(repo.getRecordsByType(PLDM_STATE_SENSOR_PDR).size(), 2);
+
+    // Remote records removed, only the local ones are left
+    entry.data = effecterPdr.data();
+    entry.size = effecterPdr.size();
+    entry.handle.recordHandle = 0;
+    auto remoteHandle = other.addRemoteRecord(entry, 2);
+    ASSERT_NE(repo.getRecordByHandle(remoteHandle, e), nullptr);
+    other.removeRemoteRecords();
+    EXPECT_EQ(repo.getRecordByHandle(remoteHandle, e), nullptr);
+    EXPECT_EQ(repo.getRecordsByType(PLDM_STATE_EFFECTER_PDR).size(), 1);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(getStateSensorReadingsHandler, testGoodRequest)
 {
     MockdBusHandler mockedUtils;
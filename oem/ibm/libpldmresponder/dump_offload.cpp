@@ -0,0 +1,213 @@
+#include "dump_offload.hpp"
+
+#include "utils.hpp"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+using sdeventplus::source::Enabled;
+using sdeventplus::source::IO;
+
+bool DumpOffloadChannel::listen(const std::string& socketPath)
+{
+    this->socketPath = socketPath;
+    listenFd = utils::setupUnixSocket(socketPath);
+    if (listenFd < 0)
+    {
+        return false;
+    }
+
+    listenSource.emplace(event, listenFd, EPOLLIN,
+                         [this](IO&, int, uint32_t) { acceptConsumer(); });
+    connectTimer.emplace(event, [this](auto&) { connectTimedOut(); });
+    connectTimer->restartOnce(timeout);
+    return true;
+}
+
+void DumpOffloadChannel::acceptConsumer()
+{
+    auto fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return;
+        }
+        error(
+            "Failed to accept the dump consumer on '{PATH}', error number - {ERROR_NUM}",
+            "PATH", socketPath, "ERROR_NUM", errno);
+        fail();
+        return;
+    }
+
+    // Only one consumer streams the dump
+    connectTimer->setEnabled(false);
+    listenSource.reset();
+    close(listenFd);
+    listenFd = -1;
+
+    sockFd = fd;
+    sockSource.emplace(event, sockFd, EPOLLOUT,
+                       [this](IO&, int, uint32_t) { drain(); });
+    sockSource->set_enabled(buffer.empty() ? Enabled::Off : Enabled::On);
+}
+
+void DumpOffloadChannel::connectTimedOut()
+{
+    if (!failed && listenFd >= 0)
+    {
+        error("Dump consumer did not connect to '{PATH}'", "PATH", socketPath);
+        fail();
+    }
+}
+
+bool DumpOffloadChannel::ready(size_t length)
+{
+    return !failed &&
+           (bufferedBytes == 0 || bufferedBytes + length <= maxBufferedBytes);
+}
+
+bool DumpOffloadChannel::write(const char* buf, size_t length)
+{
+    if (failed)
+    {
+        return false;
+    }
+
+    size_t written = 0;
+    if (sockFd >= 0 && buffer.empty())
+    {
+        while (written < length)
+        {
+            auto rc =
+                send(sockFd, buf + written, length - written, MSG_NOSIGNAL);
+            if (rc < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    break;
+                }
+                error(
+                    "Failed to write to unix socket, error number - {ERROR_NUM}",
+                    "ERROR_NUM", errno);
+                fail();
+                return false;
+            }
+            written += rc;
+        }
+    }
+
+    if (written < length)
+    {
+        buffer.emplace_back(buf + written, buf + length);
+        bufferedBytes += length - written;
+        if (sockSource)
+        {
+            sockSource->set_enabled(Enabled::On);
+        }
+    }
+    return true;
+}
+
+void DumpOffloadChannel::drain()
+{
+    while (!buffer.empty())
+    {
+        auto& chunk = buffer.front();
+        auto rc = send(sockFd, chunk.data() + frontOffset,
+                       chunk.size() - frontOffset, MSG_NOSIGNAL);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return;
+            }
+            error("Failed to write to unix socket, error number - {ERROR_NUM}",
+                  "ERROR_NUM", errno);
+            fail();
+            return;
+        }
+
+        frontOffset += rc;
+        bufferedBytes -= rc;
+        if (frontOffset == chunk.size())
+        {
+            buffer.pop_front();
+            frontOffset = 0;
+        }
+    }
+
+    if (finishing)
+    {
+        closeSockets();
+    }
+    else
+    {
+        sockSource->set_enabled(Enabled::Off);
+    }
+}
+
+void DumpOffloadChannel::finish()
+{
+    finishing = true;
+    if (!bufferedBytes)
+    {
+        closeSockets();
+    }
+}
+
+bool DumpOffloadChannel::busy()
+{
+    return finishing && !failed && bufferedBytes;
+}
+
+void DumpOffloadChannel::fail()
+{
+    failed = true;
+    buffer.clear();
+    frontOffset = 0;
+    bufferedBytes = 0;
+    closeSockets();
+}
+
+void DumpOffloadChannel::closeSockets()
+{
+    // Disabled rather than destroyed, it may be the source being dispatched
+    if (connectTimer)
+    {
+        connectTimer->setEnabled(false);
+    }
+    listenSource.reset();
+    sockSource.reset();
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        listenFd = -1;
+    }
+    if (sockFd >= 0)
+    {
+        close(sockFd);
+        sockFd = -1;
+    }
+}
+
+} // namespace responder
+} // namespace pldm
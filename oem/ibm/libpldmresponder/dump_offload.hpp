@@ -0,0 +1,141 @@
+#pragma once
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class DumpOffloadChannel
+ *
+ *  @brief Streams a dump offloaded by the host to the Unix socket of the dump
+ *         consumer without blocking the event loop. The consumer is accepted
+ *         and the data is written from sd-event IO sources. The bytes the
+ *         socket doesn't take right away are kept in a bounded buffer, and
+ *         the host is asked to retry once the buffer is full.
+ */
+class DumpOffloadChannel
+{
+  public:
+    /** @brief Bytes buffered for the consumer before the host has to retry */
+    static constexpr size_t maxBufferedBytes = 16 * 1024 * 1024;
+
+    /** @brief Default time the consumer has to connect to the socket */
+    static constexpr std::chrono::milliseconds connectTimeout{5000};
+
+    DumpOffloadChannel() = delete;
+    DumpOffloadChannel(const DumpOffloadChannel&) = delete;
+    DumpOffloadChannel(DumpOffloadChannel&&) = delete;
+    DumpOffloadChannel& operator=(const DumpOffloadChannel&) = delete;
+    DumpOffloadChannel& operator=(DumpOffloadChannel&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the socket is served from
+     *  @param[in] timeout - time the consumer has to connect to the socket
+     */
+    explicit DumpOffloadChannel(
+        sdeventplus::Event& event,
+        std::chrono::milliseconds timeout = connectTimeout) :
+        event(event), timeout(timeout)
+    {}
+
+    ~DumpOffloadChannel()
+    {
+        closeSockets();
+    }
+
+    /** @brief Listen for the consumer on a Unix socket
+     *
+     *  @param[in] socketPath - path of the socket
+     *  @return true if the socket is listening
+     */
+    bool listen(const std::string& socketPath);
+
+    /** @brief Check whether a chunk of the dump can be taken now
+     *
+     *  @param[in] length - length of the chunk
+     *  @return true if the chunk fits in the buffer, false if the host has to
+     *          retry later or the channel failed
+     */
+    bool ready(size_t length);
+
+    /** @brief Write a chunk of the dump, straight to the socket when the
+     *         consumer keeps up and through the buffer otherwise
+     *
+     *  @param[in] buf - the chunk
+     *  @param[in] length - length of the chunk
+     *  @return false if the channel failed
+     */
+    bool write(const char* buf, size_t length);
+
+    /** @brief Close the channel once the buffered bytes are written */
+    void finish();
+
+    /** @brief Check whether a finished channel still has bytes to write */
+    bool busy();
+
+    bool isFinished() const
+    {
+        return finishing;
+    }
+
+    bool hasFailed() const
+    {
+        return failed;
+    }
+
+    const std::string& getSocketPath() const
+    {
+        return socketPath;
+    }
+
+  private:
+    /** @brief Accept the consumer, on the event loop */
+    void acceptConsumer();
+
+    /** @brief Write the buffered bytes, on the event loop */
+    void drain();
+
+    /** @brief Fail the channel as the consumer didn't connect in time, on
+     *         the event loop
+     */
+    void connectTimedOut();
+
+    /** @brief Drop the buffer and close the sockets */
+    void fail();
+
+    void closeSockets();
+
+    sdeventplus::Event event;
+    std::chrono::milliseconds timeout;
+    std::string socketPath;
+    int listenFd = -1; //!< listening socket, until the consumer connects
+    int sockFd = -1;   //!< socket of the consumer
+    std::optional<sdeventplus::source::IO> listenSource;
+    std::optional<sdeventplus::source::IO> sockSource;
+
+    /** @brief Armed while waiting for the consumer to connect */
+    std::optional<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        connectTimer;
+
+    std::deque<std::vector<char>> buffer; //!< chunks not written yet
+    size_t frontOffset = 0;   //!< bytes of the front chunk already written
+    size_t bufferedBytes = 0; //!< bytes in the buffer not written yet
+    bool finishing = false;
+    bool failed = false;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "file_session_cache.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace pldm
+{
+namespace responder
+{
+
+class FileHandler;
+
+/** @class FileHandlerRegistry
+ *
+ *  @brief Keeps the file handler of each transfer in progress, keyed by file
+ *         type and file handle, so the state a handler builds for the first
+ *         chunk of a transfer is there for the next ones. A handler is
+ *         dropped once its transfer is acked or it goes unused for
+ *         FileSessionCache::idleTimeout, unless its transfer is still in
+ *         progress.
+ */
+class FileHandlerRegistry
+{
+  public:
+    FileHandlerRegistry();
+    ~FileHandlerRegistry();
+    FileHandlerRegistry(const FileHandlerRegistry&) = delete;
+    FileHandlerRegistry& operator=(const FileHandlerRegistry&) = delete;
+
+    /** @brief Get the handler of a transfer, created on its first request
+     *
+     *  @param[in] fileType - type of file
+     *  @param[in] fileHandle - file handle
+     *  @return the handler, valid until the next call on the registry
+     *  @throw InternalFailure if the file type is not supported
+     */
+    FileHandler& get(uint16_t fileType, uint32_t fileHandle);
+
+    /** @brief Drop the handler of a transfer once it is acked
+     *
+     *  @param[in] fileType - type of file
+     *  @param[in] fileHandle - file handle
+     */
+    void release(uint16_t fileType, uint32_t fileHandle);
+
+  private:
+    static uint64_t sessionKey(uint16_t fileType, uint32_t fileHandle)
+    {
+        return (static_cast<uint64_t>(fileType) << 32) | fileHandle;
+    }
+
+    FileSessionCache<std::unique_ptr<FileHandler>> handlers;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -1,5 +1,6 @@
 #include "file_io.hpp"
 
+#include "dump_offload.hpp"
 #include "file_io_by_type.hpp"
 #include "file_table.hpp"
 #include "utils.hpp"
@@ -47,7 +48,8 @@ struct AspeedXdmaOp
 
 constexpr auto xdmaDev = "/dev/aspeed-xdma";
 
-int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
+int DMA::transferHostDataToChannel(DumpOffloadChannel& channel,
+                                   uint32_t length, uint64_t address)
 {
     static const size_t pageSize = getpagesize();
     uint32_t numPages = length / pageSize;
@@ -105,16 +107,12 @@ int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
         return rc;
     }
 
-    rc = writeToUnixSocket(fd, static_cast<const char*>(vgaMemPtr.get()),
-                           length);
-    if (rc < 0)
+    if (!channel.write(static_cast<const char*>(vgaMemPtr.get()), length))
     {
-        rc = -errno;
-        close(fd);
         error(
-            "Failed to write to Unix socket, closing socket for transferring remote terminus data to socket with response code '{RC}'",
-            "RC", rc);
-        return rc;
+            "Failed to write to Unix socket for transferring remote terminus data to socket at address '{ADDRESS}' and length '{LENGTH}'",
+            "ADDRESS", address, "LENGTH", length);
+        return -EIO;
     }
     return 0;
 }
@@ -372,7 +370,7 @@ Response Handler::readFileIntoMemory(const pldm_msg* request,
     }
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(FILE_TABLE_JSON);
+    auto table = buildFileTable(FILE_TABLE_JSON);
     FileEntry value{};
 
     try
@@ -486,7 +484,7 @@ Response Handler::writeFileFromMemory(const pldm_msg* request,
     }
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(FILE_TABLE_JSON);
+    auto table = buildFileTable(FILE_TABLE_JSON);
     FileEntry value{};
 
     try
@@ -637,7 +635,7 @@ Response Handler::readFile(const pldm_msg* request, size_t payloadLength)
     }
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(FILE_TABLE_JSON);
+    auto table = buildFileTable(FILE_TABLE_JSON);
     FileEntry value{};
 
     try
@@ -741,7 +739,7 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
     }
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(FILE_TABLE_JSON);
+    auto table = buildFileTable(FILE_TABLE_JSON);
     FileEntry value{};
 
     try
@@ -802,7 +800,8 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
 
 Response rwFileByTypeIntoMemory(uint8_t cmd, const pldm_msg* request,
                                 size_t payloadLength,
-                                oem_platform::Handler* oemPlatformHandler)
+                                oem_platform::Handler* oemPlatformHandler,
+                                FileHandlerRegistry& fileHandlers)
 {
     Response response(
         sizeof(pldm_msg_hdr) + PLDM_RW_FILE_BY_TYPE_MEM_RESP_BYTES, 0);
@@ -848,10 +847,10 @@ Response rwFileByTypeIntoMemory(uint8_t cmd, const pldm_msg* request,
         return response;
     }
 
-    std::unique_ptr<FileHandler> handler{};
+    FileHandler* handler{};
     try
     {
-        handler = getHandlerByType(fileType, fileHandle);
+        handler = &fileHandlers.get(fileType, fileHandle);
     }
     catch (const InternalFailure& e)
     {
@@ -877,14 +876,16 @@ Response Handler::writeFileByTypeFromMemory(const pldm_msg* request,
                                             size_t payloadLength)
 {
     return rwFileByTypeIntoMemory(PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY, request,
-                                  payloadLength, oemPlatformHandler);
+                                  payloadLength, oemPlatformHandler,
+                                  fileHandlers);
 }
 
 Response Handler::readFileByTypeIntoMemory(const pldm_msg* request,
                                            size_t payloadLength)
 {
     return rwFileByTypeIntoMemory(PLDM_READ_FILE_BY_TYPE_INTO_MEMORY, request,
-                                  payloadLength, oemPlatformHandler);
+                                  payloadLength, oemPlatformHandler,
+                                  fileHandlers);
 }
 
 Response Handler::writeFileByType(const pldm_msg* request, size_t payloadLength)
@@ -920,10 +921,10 @@ Response Handler::writeFileByType(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    std::unique_ptr<FileHandler> handler{};
+    FileHandler* handler{};
     try
     {
-        handler = getHandlerByType(fileType, fileHandle);
+        handler = &fileHandlers.get(fileType, fileHandle);
     }
     catch (const InternalFailure& e)
     {
@@ -977,10 +978,10 @@ Response Handler::readFileByType(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    std::unique_ptr<FileHandler> handler{};
+    FileHandler* handler{};
     try
     {
-        handler = getHandlerByType(fileType, fileHandle);
+        handler = &fileHandlers.get(fileType, fileHandle);
     }
     catch (const InternalFailure& e)
     {
@@ -1026,10 +1027,10 @@ Response Handler::fileAck(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    std::unique_ptr<FileHandler> handler{};
+    FileHandler* handler{};
     try
     {
-        handler = getHandlerByType(fileType, fileHandle);
+        handler = &fileHandlers.get(fileType, fileHandle);
     }
 
     catch (const InternalFailure& e)
@@ -1042,6 +1043,7 @@ Response Handler::fileAck(const pldm_msg* request, size_t payloadLength)
     }
 
     rc = handler->fileAck(fileStatus);
+    fileHandlers.release(fileType, fileHandle);
     encodeFileAckResponseHandler(request->hdr.instance_id, rc, responsePtr);
     return response;
 }
@@ -1120,10 +1122,10 @@ Response Handler::newFileAvailable(const pldm_msg* request,
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    std::unique_ptr<FileHandler> handler{};
+    FileHandler* handler{};
     try
     {
-        handler = getHandlerByType(fileType, fileHandle);
+        handler = &fileHandlers.get(fileType, fileHandle);
     }
     catch (const InternalFailure& e)
     {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/utils.hpp"
+#include "file_handler_registry.hpp"
 #include "oem/ibm/requester/dbus_to_file_handler.hpp"
 #include "oem_ibm_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -27,6 +28,8 @@ namespace pldm
 {
 namespace responder
 {
+class DumpOffloadChannel;
+
 namespace dma
 {
 // The minimum data size of dma transfer in bytes
@@ -62,15 +65,17 @@ class DMA
     int transferDataHost(int fd, uint32_t offset, uint32_t length,
                          uint64_t address, bool upstream);
 
-    /** @brief API to transfer data on to unix socket from host using DMA
+    /** @brief API to transfer data on to a dump offload channel from host
+     *         using DMA
      *
-     * @param[in] path     - pathname of the file to transfer data from or to
+     * @param[in] channel  - offload channel of the dump
      * @param[in] length   - length of the data to transfer
      * @param[in] address  - DMA address on the host
      *
      * @return returns 0 on success, negative errno on failure
      */
-    int transferHostDataToSocket(int fd, uint32_t length, uint64_t address);
+    int transferHostDataToChannel(DumpOffloadChannel& channel, uint32_t length,
+                                  uint64_t address);
 };
 
 /** @brief Transfer the data between BMC and host using DMA.
@@ -232,6 +237,12 @@ class Handler : public CmdHandler
                 return this->newFileAvailable(request, payloadLength);
             });
 
+        // ReadFile and WriteFile only touch the file table and the files.
+        // The DMA, code update and state sensor paths use the shared D-Bus
+        // connection and the event loop, so they stay on the event loop
+        offloadable.emplace(PLDM_READ_FILE);
+        offloadable.emplace(PLDM_WRITE_FILE);
+
         resDumpMatcher = std::make_unique<sdbusplus::bus::match_t>(
             pldm::utils::DBusHandler::getBus(),
             sdbusplus::bus::match::rules::interfacesAdded() +
@@ -417,6 +428,8 @@ class Handler : public CmdHandler
 
   private:
     oem_platform::Handler* oemPlatformHandler;
+    FileHandlerRegistry fileHandlers; //!< handlers of the transfers by type
+                                      //!< in progress
     using DBusInterfaceAdded = std::vector<std::pair<
         std::string,
         std::vector<std::pair<std::string, std::variant<std::string>>>>>;
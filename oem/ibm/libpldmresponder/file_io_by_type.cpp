@@ -1,6 +1,7 @@
 #include "file_io_by_type.hpp"
 
 #include "common/utils.hpp"
+#include "file_handler_registry.hpp"
 #include "file_io_type_cert.hpp"
 #include "file_io_type_dump.hpp"
 #include "file_io_type_lid.hpp"
@@ -52,14 +53,14 @@ int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
     return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
-int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
-                                          uint64_t address)
+int FileHandler::transferFileDataToChannel(DumpOffloadChannel& channel,
+                                           uint32_t& length, uint64_t address)
 {
     dma::DMA xdmaInterface;
     while (length > dma::maxSize)
     {
-        auto rc =
-            xdmaInterface.transferHostDataToSocket(fd, dma::maxSize, address);
+        auto rc = xdmaInterface.transferHostDataToChannel(channel, dma::maxSize,
+                                                          address);
         if (rc < 0)
         {
             return PLDM_ERROR;
@@ -67,7 +68,7 @@ int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
         length -= dma::maxSize;
         address += dma::maxSize;
     }
-    auto rc = xdmaInterface.transferHostDataToSocket(fd, length, address);
+    auto rc = xdmaInterface.transferHostDataToChannel(channel, length, address);
     return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
@@ -184,6 +185,29 @@ std::unique_ptr<FileHandler>
     return nullptr;
 }
 
+FileHandlerRegistry::FileHandlerRegistry() :
+    handlers([](const std::unique_ptr<FileHandler>& handler) {
+        return handler && handler->transferInProgress();
+    })
+{}
+
+FileHandlerRegistry::~FileHandlerRegistry() = default;
+
+FileHandler& FileHandlerRegistry::get(uint16_t fileType, uint32_t fileHandle)
+{
+    auto key = sessionKey(fileType, fileHandle);
+    if (auto handler = handlers.find(key))
+    {
+        return **handler;
+    }
+    return *handlers.insert(key, getHandlerByType(fileType, fileHandle));
+}
+
+void FileHandlerRegistry::release(uint16_t fileType, uint32_t fileHandle)
+{
+    handlers.erase(sessionKey(fileType, fileHandle));
+}
+
 int FileHandler::readFile(const std::string& filePath, uint32_t offset,
                           uint32_t& length, Response& response)
 {
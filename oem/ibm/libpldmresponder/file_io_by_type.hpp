@@ -79,6 +79,16 @@ class FileHandler
      */
     virtual int newFileAvailable(uint64_t length) = 0;
 
+    /** @brief Check if the handler holds the state of a transfer that has not
+     *  completed yet, the registry keeps such a handler over the idle ones
+     *
+     *  @return true if a transfer is in progress
+     */
+    virtual bool transferInProgress() const
+    {
+        return false;
+    }
+
     /** @brief Method to read an oem file type's content into the PLDM response.
      *  @param[in] filePath - file to read from
      *  @param[in] offset - offset to read
@@ -109,8 +119,8 @@ class FileHandler
     virtual int transferFileData(int fd, bool upstream, uint32_t offset,
                                  uint32_t& length, uint64_t address);
 
-    virtual int transferFileDataToSocket(int fd, uint32_t& length,
-                                         uint64_t address);
+    virtual int transferFileDataToChannel(DumpOffloadChannel& channel,
+                                          uint32_t& length, uint64_t address);
 
     /** @brief Constructor to create a FileHandler object
      */
@@ -38,7 +38,7 @@ static constexpr auto resDumpEntry = "com.ibm.Dump.Entry.Resource";
 // resource dumps.
 static constexpr auto resDumpDirPath = "/var/lib/pldm/resourcedump/1";
 
-int DumpHandler::fd = -1;
+std::unique_ptr<DumpOffloadChannel> DumpHandler::channel;
 namespace fs = std::filesystem;
 
 std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
@@ -47,6 +47,11 @@ std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
         "xyz.openbmc_project.Dump.Manager";
     static constexpr auto DUMP_MANAGER_PATH = "/xyz/openbmc_project/dump";
 
+    if (fileHandle == this->fileHandle && !dumpEntryPath.empty())
+    {
+        return dumpEntryPath;
+    }
+
     // Stores the current resource dump entry path
     std::string curResDumpEntryPath{};
 
@@ -92,6 +97,10 @@ std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
                         if (fileHandle == dumpId)
                         {
                             curResDumpEntryPath = object.first.str;
+                            if (fileHandle == this->fileHandle)
+                            {
+                                dumpEntryPath = curResDumpEntryPath;
+                            }
                             return curResDumpEntryPath;
                         }
                     }
@@ -167,42 +176,83 @@ std::string DumpHandler::getOffloadUri(uint32_t fileHandle)
     return socketInterface;
 }
 
-int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
-                                 oem_platform::Handler* /*oemPlatformHandler*/)
+int DumpHandler::reserveChannel(uint32_t length)
 {
-    if (DumpHandler::fd == -1)
+    if (channel && channel->isFinished())
+    {
+        // The consumer of the previous dump is still reading it
+        if (channel->busy())
+        {
+            return PLDM_ERROR_NOT_READY;
+        }
+        channel.reset();
+    }
+
+    if (!channel)
     {
         auto socketInterface = getOffloadUri(fileHandle);
-        int sock = setupUnixSocket(socketInterface);
-        if (sock < 0)
+        auto event = sdeventplus::Event::get_default();
+        channel = std::make_unique<DumpOffloadChannel>(event);
+        if (!channel->listen(socketInterface))
         {
-            sock = -errno;
-            close(DumpHandler::fd);
             error(
-                "Failed to setup Unix socket while write from memory for interface '{INTERFACE}', response code '{SOCKET_RC}'",
-                "INTERFACE", socketInterface, "SOCKET_RC", sock);
-            std::remove(socketInterface.c_str());
+                "Failed to setup Unix socket while write from memory for interface '{INTERFACE}', error number - {ERROR_NUM}",
+                "INTERFACE", socketInterface, "ERROR_NUM", errno);
+            closeChannel();
+            return PLDM_ERROR;
+        }
+    }
+
+    if (!channel->ready(length))
+    {
+        if (channel->hasFailed())
+        {
+            closeChannel();
             return PLDM_ERROR;
         }
+        return PLDM_ERROR_NOT_READY;
+    }
+    return PLDM_SUCCESS;
+}
 
-        DumpHandler::fd = sock;
+void DumpHandler::closeChannel()
+{
+    std::remove(channel->getSocketPath().c_str());
+    channel.reset();
+}
+
+int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
+                                 oem_platform::Handler* /*oemPlatformHandler*/)
+{
+    auto rc = reserveChannel(length);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    rc = transferFileDataToChannel(*channel, length, address);
+    if (rc != PLDM_SUCCESS && channel->hasFailed())
+    {
+        closeChannel();
     }
-    return transferFileDataToSocket(DumpHandler::fd, length, address);
+    return rc;
 }
 
 int DumpHandler::write(const char* buffer, uint32_t, uint32_t& length,
                        oem_platform::Handler* /*oemPlatformHandler*/)
 {
-    int rc = writeToUnixSocket(DumpHandler::fd, buffer, length);
-    if (rc < 0)
+    auto rc = reserveChannel(length);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    if (!channel->write(buffer, length))
     {
-        rc = -errno;
-        close(DumpHandler::fd);
-        auto socketInterface = getOffloadUri(fileHandle);
-        std::remove(socketInterface.c_str());
         error(
-            "Failed to do dump write to Unix socket for interface '{INTERFACE}', response code '{RC}'",
-            "INTERFACE", socketInterface, "RC", rc);
+            "Failed to do dump write to Unix socket for interface '{INTERFACE}'",
+            "INTERFACE", channel->getSocketPath());
+        closeChannel();
         return PLDM_ERROR;
     }
 
@@ -212,6 +262,8 @@ int DumpHandler::write(const char* buffer, uint32_t, uint32_t& length,
 int DumpHandler::fileAck(uint8_t fileStatus)
 {
     auto path = findDumpObjPath(fileHandle);
+    // The transfer ends with the ack, the entry may be deleted below
+    dumpEntryPath.clear();
     if (dumpType == PLDM_FILE_TYPE_RESOURCE_DUMP_PARMS)
     {
         if (fileStatus != PLDM_SUCCESS)
@@ -310,10 +362,10 @@ int DumpHandler::fileAck(uint8_t fileStatus)
 
             auto socketInterface = getOffloadUri(fileHandle);
             std::remove(socketInterface.c_str());
-            if (DumpHandler::fd >= 0)
+            if (channel)
             {
-                close(DumpHandler::fd);
-                DumpHandler::fd = -1;
+                // The bytes the consumer hasn't read yet are still written
+                channel->finish();
             }
         }
         return PLDM_SUCCESS;
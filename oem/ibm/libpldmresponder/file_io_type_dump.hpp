@@ -1,7 +1,11 @@
 #pragma once
 
+#include "dump_offload.hpp"
 #include "file_io_by_type.hpp"
 
+#include <memory>
+#include <string>
+
 namespace pldm
 {
 namespace responder
@@ -48,8 +52,23 @@ class DumpHandler : public FileHandler
     ~DumpHandler() {}
 
   private:
-    static int fd;     //!< fd to manage the dump offload to bmc
-    uint16_t dumpType; //!< type of the dump
+    /** @brief Open the offload channel if needed and check that it can take
+     *         a chunk of the dump
+     *
+     *  @param[in] length - length of the chunk
+     *  @return PLDM_SUCCESS, PLDM_ERROR_NOT_READY if the host has to retry
+     *          the chunk later, PLDM_ERROR if the channel failed
+     */
+    int reserveChannel(uint32_t length);
+
+    /** @brief Drop the offload channel after a failure */
+    void closeChannel();
+
+    /** @brief channel to manage the dump offload to bmc */
+    static std::unique_ptr<DumpOffloadChannel> channel;
+    uint16_t dumpType;         //!< type of the dump
+    std::string dumpEntryPath; //!< object path of the dump entry, looked up
+                               //!< for the first chunk of the transfer
 };
 
 } // namespace responder
@@ -43,13 +43,14 @@ class LidHandler : public FileHandler
         auto patch = fs::path(patchDir) / lidName;
         if (fs::is_regular_file(patch))
         {
-            lidPath = patch;
+            installedLidPath = patch;
             isPatchDir = true;
         }
         else
         {
-            lidPath = std::move(dir) + '/' + lidName;
+            installedLidPath = std::move(dir) + '/' + lidName;
         }
+        lidPath = installedLidPath;
     }
 
     /** @brief Method to construct the LID path based on current boot side
@@ -58,6 +59,7 @@ class LidHandler : public FileHandler
      */
     bool constructLIDPath(oem_platform::Handler* oemPlatformHandler)
     {
+        lidPath = installedLidPath;
         if (oemPlatformHandler != nullptr)
         {
             pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
@@ -98,15 +100,25 @@ class LidHandler : public FileHandler
                                 uint64_t address,
                                 oem_platform::Handler* oemPlatformHandler)
     {
+        if (lidType == PLDM_FILE_TYPE_LID_MARKER &&
+            length > markerLIDremainingSize)
+        {
+            error(
+                "Marker LID write of length '{LENGTH}' exceeds the remaining size '{SIZE}' announced by NewFileAvailable",
+                "LENGTH", length, "SIZE", markerLIDremainingSize);
+            return PLDM_ERROR;
+        }
+        lidPath = installedLidPath;
         int rc = PLDM_SUCCESS;
         bool codeUpdateInProgress = false;
+        CodeUpdate* codeUpdate = nullptr;
         if (oemPlatformHandler != nullptr)
         {
             pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
                 dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
                     oemPlatformHandler);
-            codeUpdateInProgress =
-                oemIbmPlatformHandler->codeUpdate->isCodeUpdateInProgress();
+            codeUpdate = oemIbmPlatformHandler->codeUpdate;
+            codeUpdateInProgress = codeUpdate->isCodeUpdateInProgress();
             if (codeUpdateInProgress || lidType == PLDM_FILE_TYPE_LID_MARKER)
             {
                 std::string dir = LID_STAGING_DIR;
@@ -162,7 +174,7 @@ class LidHandler : public FileHandler
         }
         else if (codeUpdateInProgress)
         {
-            rc = processCodeUpdateLid(lidPath);
+            rc = codeUpdate->processCodeUpdateLid(lidPath, offset, length);
         }
         return rc;
     }
@@ -181,15 +193,25 @@ class LidHandler : public FileHandler
     virtual int write(const char* buffer, uint32_t offset, uint32_t& length,
                       oem_platform::Handler* oemPlatformHandler)
     {
+        if (lidType == PLDM_FILE_TYPE_LID_MARKER &&
+            length > markerLIDremainingSize)
+        {
+            error(
+                "Marker LID write of length '{LENGTH}' exceeds the remaining size '{SIZE}' announced by NewFileAvailable",
+                "LENGTH", length, "SIZE", markerLIDremainingSize);
+            return PLDM_ERROR;
+        }
+        lidPath = installedLidPath;
         int rc = PLDM_SUCCESS;
         bool codeUpdateInProgress = false;
+        CodeUpdate* codeUpdate = nullptr;
         if (oemPlatformHandler != nullptr)
         {
             pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
                 dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
                     oemPlatformHandler);
-            codeUpdateInProgress =
-                oemIbmPlatformHandler->codeUpdate->isCodeUpdateInProgress();
+            codeUpdate = oemIbmPlatformHandler->codeUpdate;
+            codeUpdateInProgress = codeUpdate->isCodeUpdateInProgress();
             if (codeUpdateInProgress || lidType == PLDM_FILE_TYPE_LID_MARKER)
             {
                 std::string dir = LID_STAGING_DIR;
@@ -276,7 +298,7 @@ class LidHandler : public FileHandler
         }
         else if (codeUpdateInProgress)
         {
-            rc = processCodeUpdateLid(lidPath);
+            rc = codeUpdate->processCodeUpdateLid(lidPath, offset, length);
         }
 
         return rc;
@@ -308,15 +330,25 @@ class LidHandler : public FileHandler
         return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
     }
 
+    virtual bool transferInProgress() const
+    {
+        return lidType == PLDM_FILE_TYPE_LID_MARKER && markerLIDremainingSize;
+    }
+
     /** @brief LidHandler destructor
      */
     ~LidHandler() {}
 
   protected:
+    std::string installedLidPath; //!< path of the LID outside of an update,
+                                  //!< the handler is kept across chunks
     std::string lidPath;
     std::string sideToRead;
     bool isPatchDir;
-    static inline MarkerLIDremainingSize markerLIDremainingSize;
+    /** @brief Marker LID bytes still to be written, the registry keeps the
+     *         handler until they are
+     */
+    MarkerLIDremainingSize markerLIDremainingSize = 0;
     uint8_t lidType;
 };
 
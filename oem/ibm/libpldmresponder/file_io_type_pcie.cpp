@@ -5,7 +5,10 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -73,159 +76,169 @@ constexpr auto slotLocationDataMemberSize = 2;
 namespace fs = std::filesystem;
 
 std::unordered_map<uint16_t, bool> PCIeInfoHandler::receivedFiles;
-std::unordered_map<LinkId, std::tuple<LinkStatus, linkTypeData, LinkSpeed,
-                                      LinkWidth, PcieHostBridgeLoc, LocalPort,
-                                      RemotePort, IoSlotLocation, LinkId>>
-    PCIeInfoHandler::topologyInformation;
-std::unordered_map<
-    CableLinkNum, std::tuple<LinkId, LocalPortLocCode, IoSlotLocationCode,
-                             CablePartNum, CableLength, CableType, CableStatus>>
-    PCIeInfoHandler::cableInformation;
-std::unordered_map<LinkId, linkTypeData> PCIeInfoHandler::linkTypeInfo;
+PCIeTopology PCIeInfoHandler::topology;
 
-PCIeInfoHandler::PCIeInfoHandler(uint32_t fileHandle, uint16_t fileType) :
-    FileHandler(fileHandle), infoType(fileType)
+namespace
 {
-    receivedFiles.emplace(infoType, false);
-}
 
-int PCIeInfoHandler::writeFromMemory(
-    uint32_t offset, uint32_t length, uint64_t address,
-    oem_platform::Handler* /*oemPlatformHandler*/)
+/** @class BlobView
+ *
+ *  @brief Bounds checked view of a file received from the host. The
+ *         structures are copied out of the file one at a time and the
+ *         location codes are viewed in place.
+ */
+class BlobView
 {
-    if (!fs::exists(pciePath))
-    {
-        fs::create_directories(pciePath);
-        fs::permissions(pciePath,
-                        fs::perms::others_read | fs::perms::owner_write);
-    }
+  public:
+    explicit BlobView(std::span<const uint8_t> data) : data(data) {}
 
-    fs::path infoFile(fs::path(pciePath) / topologyFile);
-    if (infoType == PLDM_FILE_TYPE_CABLE_INFO)
+    bool fits(size_t offset, size_t size) const
     {
-        infoFile = (fs::path(pciePath) / cableInfoFile);
+        return offset <= data.size() && size <= data.size() - offset;
     }
 
-    try
+    /** @brief Read the fixed part of a structure
+     *
+     *  @param[in] offset - offset of the structure
+     *  @param[in] size - size of the fixed part
+     *  @return the structure, std::nullopt if it doesn't fit in the file
+     */
+    template <typename T>
+    std::optional<T> read(size_t offset, size_t size = sizeof(T)) const
     {
-        std::ofstream pcieData(infoFile, std::ios::out | std::ios::binary);
-        auto rc = transferFileData(infoFile, false, offset, length, address);
-        if (rc != PLDM_SUCCESS)
+        if (!fits(offset, size))
         {
-            error("TransferFileData failed in PCIeTopology with error {ERROR}",
-                  "ERROR", rc);
-            return rc;
+            return std::nullopt;
         }
-        return PLDM_SUCCESS;
-    }
-    catch (const std::exception& e)
-    {
-        error("Create/Write data to the File type {TYPE}, failed {ERROR}",
-              "TYPE", infoType, "ERROR", e);
-        return PLDM_ERROR;
-    }
-}
-
-int PCIeInfoHandler::write(const char* buffer, uint32_t, uint32_t& length,
-                           oem_platform::Handler* /*oemPlatformHandler*/)
-{
-    fs::path infoFile(fs::path(pciePath) / topologyFile);
-    if (infoType == PLDM_FILE_TYPE_CABLE_INFO)
-    {
-        infoFile = (fs::path(pciePath) / cableInfoFile);
+        T value{};
+        std::memcpy(&value, data.data() + offset, size);
+        return value;
     }
 
-    try
+    /** @brief View a string of the file
+     *
+     *  @param[in] offset - offset of the string
+     *  @param[in] size - size of the string
+     *  @return the string, std::nullopt if it doesn't fit in the file
+     */
+    std::optional<std::string_view> string(size_t offset, size_t size) const
     {
-        std::ofstream pcieData(infoFile, std::ios::out | std::ios::binary |
-                                             std::ios::app);
-
-        if (!buffer)
+        if (!fits(offset, size))
         {
-            pcieData.write(buffer, length);
+            return std::nullopt;
         }
-        pcieData.close();
-    }
-    catch (const std::exception& e)
-    {
-        error("Create/Write data to the File type {TYPE}, failed {ERROR}",
-              "TYPE", infoType, "ERROR", e);
-        return PLDM_ERROR;
+        return std::string_view(
+            reinterpret_cast<const char*>(data.data()) + offset, size);
     }
 
-    return PLDM_SUCCESS;
-}
-
-int PCIeInfoHandler::fileAck(uint8_t /*fileStatus*/)
+  private:
+    std::span<const uint8_t> data;
+};
+
+// Size of the fixed part of the link and cable entries, without the location
+// codes that follow them
+constexpr size_t linkEntrySize = offsetof(pcieLinkEntry, pciLinkEntryLocCode);
+constexpr size_t cableEntrySize =
+    offsetof(pcieLinkCableAttr, cableAttrLocCode);
+
+// The PCIe links follow the total size, the number of links and a reserved
+// field of the topology file
+constexpr size_t topologyHeaderSize = 8;
+
+// The cables follow the response length, the number of cables and a reserved
+// field of the cable information file
+constexpr size_t cableHeaderSize = offsetof(cableAttributesList,
+                                            pciLinkCableAttr);
+
+// Offset of the first cable in the cable information file, as laid out by
+// the host firmware
+constexpr size_t firstCableOffset = sizeof(cableAttributesList) - 1;
+
+/** @brief Get the path of the file a type of information is received in,
+ *         and create its directory if needed
+ *
+ *  @param[in] infoType - type of the information
+ *  @return the path of the file
+ */
+fs::path getInfoFile(uint16_t infoType)
 {
-    receivedFiles[infoType] = true;
-    try
+    if (!fs::exists(pciePath))
     {
-        if (receivedFiles.at(PLDM_FILE_TYPE_CABLE_INFO) &&
-            receivedFiles.at(PLDM_FILE_TYPE_PCIE_TOPOLOGY))
-        {
-            receivedFiles.clear();
-            // parse the topology data and cache the information
-            // for further processing
-            parseTopologyData();
-        }
+        fs::create_directories(pciePath);
+        fs::permissions(pciePath,
+                        fs::perms::others_read | fs::perms::owner_write);
     }
-    catch (const std::out_of_range& e)
+
+    if (infoType == PLDM_FILE_TYPE_CABLE_INFO)
     {
-        info("Received only one of the topology file");
+        return fs::path(pciePath) / cableInfoFile;
     }
-    return PLDM_SUCCESS;
+    return fs::path(pciePath) / topologyFile;
 }
 
-void PCIeInfoHandler::parseTopologyData()
+/** @brief Memory map a file received from the host and run a parser over it
+ *
+ *  @param[in] path - the file
+ *  @param[in] parser - the parser, called with the contents of the file
+ *  @return false if the file can't be mapped or the parser failed
+ */
+template <typename Parser>
+bool parseFile(const fs::path& path, Parser parser)
 {
-    int fd = open((fs::path(pciePath) / topologyFile).string().c_str(),
-                  O_RDONLY, S_IRUSR | S_IWUSR);
+    int fd = open(path.string().c_str(), O_RDONLY);
     if (fd == -1)
     {
-        perror("Topology file not present");
-        return;
+        error("Failed to open file '{PATH}', error number - {ERROR_NUM}",
+              "PATH", path, "ERROR_NUM", errno);
+        return false;
     }
-    pldm::utils::CustomFD topologyFd(fd);
-    // Reading the statistics of the topology file, to get the size.
-    // stat sb is the out parameter provided to fstat
+    pldm::utils::CustomFD fileFd(fd);
+
     struct stat sb;
     if (fstat(fd, &sb) == -1)
     {
-        perror("Could not get topology file size");
-        return;
+        error("Failed to get the size of file '{PATH}'", "PATH", path);
+        return false;
     }
-
     if (sb.st_size == 0)
     {
-        error("Topology file Size is 0");
-        return;
+        error("File '{PATH}' is empty", "PATH", path);
+        return false;
     }
 
-    auto topologyCleanup = [sb](void* fileInMemory) {
-        munmap(fileInMemory, sb.st_size);
-    };
-
-    // memory map the topology file into pldm memory
     void* fileInMemory =
-        mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, topologyFd(), 0);
+        mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fileFd(), 0);
     if (MAP_FAILED == fileInMemory)
     {
-        error("mmap on topology file failed with error {RC}", "RC", -errno);
-        return;
+        error("mmap on file '{PATH}' failed with error {RC}", "PATH", path,
+              "RC", -errno);
+        return false;
     }
+    auto cleanup = [sb](void* fileInMemory) {
+        munmap(fileInMemory, sb.st_size);
+    };
+    std::unique_ptr<void, decltype(cleanup)> filePtr(fileInMemory, cleanup);
 
-    std::unique_ptr<void, decltype(topologyCleanup)> topologyPtr(
-        fileInMemory, topologyCleanup);
+    return parser(std::span(static_cast<const uint8_t*>(fileInMemory),
+                            static_cast<size_t>(sb.st_size)));
+}
+
+} // namespace
 
-    auto pcieLinkList = reinterpret_cast<struct topologyBlob*>(fileInMemory);
-    uint16_t numOfLinks = 0;
-    if (!pcieLinkList)
+LocCodeId LocationCodes::intern(std::string_view code)
+{
+    if (auto it = ids.find(code); it != ids.end())
     {
-        error("Parsing of topology file failed : pcieLinkList is null");
-        return;
+        return it->second;
     }
+    auto id = static_cast<LocCodeId>(codes.size());
+    const auto& stored = codes.emplace_back(code);
+    ids.emplace(stored, id);
+    return id;
+}
 
+bool parseTopology(std::span<const uint8_t> data, PCIeTopology& topology)
+{
     // The elements in the structure that were being parsed from the obtained
     // files via write() and writeFromMemory() were written by IBM enterprise
     // host firmware which runs on big-endian format. The DMA engine in BMC
@@ -238,278 +251,313 @@ void PCIeInfoHandler::parseTopologyData()
     // since pldm application runs on BMC which could be little/big endian, its
     // essential to swap the endianness to agreed big-endian format (htobe)
     // before using the data.
-
-    numOfLinks = htobe16(pcieLinkList->numPcieLinkEntries);
-
-    // To fetch the PCIe link from the topology data, moving the pointer
-    // by 8 bytes based on the size of other elements of the structure
-    struct pcieLinkEntry* singleEntryData =
-        reinterpret_cast<struct pcieLinkEntry*>(
-            reinterpret_cast<uint8_t*>(pcieLinkList) + 8);
-
-    if (!singleEntryData)
+    BlobView blob(data);
+    auto header = blob.read<topologyBlob>(0, topologyHeaderSize);
+    if (!header)
     {
-        error("Parsing of topology file failed : single_link is null");
-        return;
+        error("Topology file is smaller than its header");
+        return false;
     }
+    uint16_t numOfLinks = be16toh(header->numPcieLinkEntries);
 
-    auto singleEntryDataCharStream = reinterpret_cast<char*>(singleEntryData);
+    auto& links = topology.links;
+    auto& locationCodes = topology.locationCodes;
 
-    // iterate over every pcie link and get the link specific attributes
-    for ([[maybe_unused]] const auto& link :
-         std::views::iota(0) | std::views::take(numOfLinks))
+    size_t entryOffset = topologyHeaderSize;
+    for (uint16_t link = 0; link < numOfLinks; link++)
     {
-        // get the link id
-        auto linkId = htobe16(singleEntryData->linkId);
-
-        // get parent link id
-        auto parentLinkId = htobe16(singleEntryData->parentLinkId);
-
-        // get link status
-        auto linkStatus = singleEntryData->linkStatus;
-
-        // get link type
-        auto type = singleEntryData->linkType;
-        if (type != pldm::responder::linkTypeData::Unknown)
+        auto entry = blob.read<pcieLinkEntry>(entryOffset, linkEntrySize);
+        if (!entry)
         {
-            linkTypeInfo[linkId] = type;
+            error("Topology file is truncated at link {LINK}", "LINK", link);
+            return false;
         }
 
-        // get link speed
-        auto linkSpeed = singleEntryData->linkSpeed;
-
-        // get link width
-        auto width = singleEntryData->linkWidth;
-
-        // get the PCIe Host Bridge Location
-        size_t pcieLocCodeSize = singleEntryData->pcieHostBridgeLocCodeSize;
-        std::vector<char> pcieHostBridgeLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->pcieHostBridgeLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->pcieHostBridgeLocCodeOff) +
-                static_cast<int>(pcieLocCodeSize));
-        std::string pcieHostBridgeLocationCode(pcieHostBridgeLocation.begin(),
-                                               pcieHostBridgeLocation.end());
-
-        // get the local port - top location
-        size_t localTopPortLocSize = singleEntryData->topLocalPortLocCodeSize;
-        std::vector<char> localTopPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topLocalPortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topLocalPortLocCodeOff) +
-                static_cast<int>(localTopPortLocSize));
-        std::string localTopPortLocationCode(localTopPortLocation.begin(),
-                                             localTopPortLocation.end());
-
-        // get the local port - bottom location
-        size_t localBottomPortLocSize =
-            singleEntryData->bottomLocalPortLocCodeSize;
-        std::vector<char> localBottomPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomLocalPortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomLocalPortLocCodeOff) +
-                static_cast<int>(localBottomPortLocSize));
-        std::string localBottomPortLocationCode(localBottomPortLocation.begin(),
-                                                localBottomPortLocation.end());
-
-        // get the remote port - top location
-        size_t remoteTopPortLocSize = singleEntryData->topRemotePortLocCodeSize;
-        std::vector<char> remoteTopPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topRemotePortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topRemotePortLocCodeOff) +
-                static_cast<int>(remoteTopPortLocSize));
-        std::string remoteTopPortLocationCode(remoteTopPortLocation.begin(),
-                                              remoteTopPortLocation.end());
-
-        // get the remote port - bottom location
-        size_t remoteBottomLocSize =
-            singleEntryData->bottomRemotePortLocCodeSize;
-        std::vector<char> remoteBottomPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomRemotePortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomRemotePortLocCodeOff) +
-                static_cast<int>(remoteBottomLocSize));
-        std::string remoteBottomPortLocationCode(
-            remoteBottomPortLocation.begin(), remoteBottomPortLocation.end());
-
-        struct slotLocCode* slotData = reinterpret_cast<struct slotLocCode*>(
-            (reinterpret_cast<uint8_t*>(singleEntryData)) +
-            htobe16(singleEntryData->slotLocCodesOffset));
-        if (!slotData)
+        auto locCode = [&](uint16_t offset,
+                           uint8_t size) -> std::optional<LocCodeId> {
+            auto code = blob.string(entryOffset + be16toh(offset), size);
+            if (!code)
+            {
+                return std::nullopt;
+            }
+            return locationCodes.intern(*code);
+        };
+        auto hostBridge = locCode(entry->pcieHostBridgeLocCodeOff,
+                                  entry->pcieHostBridgeLocCodeSize);
+        auto localTop = locCode(entry->topLocalPortLocCodeOff,
+                                entry->topLocalPortLocCodeSize);
+        auto localBottom = locCode(entry->bottomLocalPortLocCodeOff,
+                                   entry->bottomLocalPortLocCodeSize);
+        auto remoteTop = locCode(entry->topRemotePortLocCodeOff,
+                                 entry->topRemotePortLocCodeSize);
+        auto remoteBottom = locCode(entry->bottomRemotePortLocCodeOff,
+                                    entry->bottomRemotePortLocCodeSize);
+        if (!hostBridge || !localTop || !localBottom || !remoteTop ||
+            !remoteBottom)
         {
-            error("Parsing the topology file failed : slotData is null");
-            return;
+            error("Location code of link {LINK} is out of the topology file",
+                  "LINK", link);
+            return false;
         }
-        // get the Slot location code common part
-        size_t numOfSlots = slotData->numSlotLocCodes;
-        size_t slotLocCodeCompartSize = slotData->slotLocCodesCmnPrtSize;
-        std::vector<char> slotLocation(
-            reinterpret_cast<char*>(slotData->slotLocCodesCmnPrt),
-            (reinterpret_cast<char*>(slotData->slotLocCodesCmnPrt) +
-             static_cast<int>(slotLocCodeCompartSize)));
-        std::string slotLocationCode(slotLocation.begin(), slotLocation.end());
-
-        uint8_t* suffixData =
-            reinterpret_cast<uint8_t*>(slotData) + slotLocationDataMemberSize +
-            slotData->slotLocCodesCmnPrtSize;
-        if (!suffixData)
+
+        // Slot location code structure contains the number of slots, the
+        // common part of their location codes and then a suffix structure
+        // {suffix size (uint8_t), suffix (variable size)} per slot
+        size_t slotOffset = entryOffset + be16toh(entry->slotLocCodesOffset);
+        auto slotData = blob.read<slotLocCode>(slotOffset,
+                                               slotLocationDataMemberSize);
+        auto commonPart =
+            slotData ? blob.string(slotOffset + slotLocationDataMemberSize,
+                                   slotData->slotLocCodesCmnPrtSize)
+                     : std::nullopt;
+        if (!commonPart)
         {
-            error("slot location suffix data is nullptr");
-            return;
+            error("Slot location codes of link {LINK} are out of the topology file",
+                  "LINK", link);
+            return false;
         }
 
         // create the full slot location code by combining common part and
         // suffix part
-        std::string slotSuffixLocationCode;
-        std::vector<std::string> slotFinaLocationCode{};
-        for ([[maybe_unused]] const auto& slot :
-             std::views::iota(0) | std::views::take(numOfSlots))
+        size_t suffixOffset = slotOffset + slotLocationDataMemberSize +
+                              commonPart->size();
+        std::string_view suffix{};
+        std::string slotLocationCode;
+        for (uint8_t slot = 0; slot < slotData->numSlotLocCodes; slot++)
         {
-            struct slotLocCodeSuf* slotLocSufData =
-                reinterpret_cast<struct slotLocCodeSuf*>(suffixData);
-            if (!slotLocSufData)
+            auto suffixSize = blob.read<uint8_t>(suffixOffset);
+            auto slotSuffix =
+                suffixSize ? blob.string(suffixOffset +
+                                             sizeOfSuffixSizeDataMember,
+                                         *suffixSize)
+                           : std::nullopt;
+            if (!slotSuffix)
             {
-                error("slot location suffix data is nullptr");
-                break;
+                error("Slot location code suffix of link {LINK} is out of the topology file",
+                      "LINK", link);
+                return false;
             }
-
-            size_t slotLocCodeSuffixSize = slotLocSufData->slotLocCodeSz;
-            if (slotLocCodeSuffixSize > 0)
+            if (!slotSuffix->empty())
             {
-                std::vector<char> slotSuffixLocation(
-                    reinterpret_cast<char*>(slotLocSufData) + 1,
-                    reinterpret_cast<char*>(slotLocSufData) + 1 +
-                        static_cast<int>(slotLocCodeSuffixSize));
-                std::string slotSuffLocationCode(slotSuffixLocation.begin(),
-                                                 slotSuffixLocation.end());
-
-                slotSuffixLocationCode = slotSuffLocationCode;
+                suffix = *slotSuffix;
             }
-            std::string slotFullLocationCode =
-                slotLocationCode + slotSuffixLocationCode;
-            slotFinaLocationCode.push_back(slotFullLocationCode);
+            slotLocationCode.assign(*commonPart);
+            slotLocationCode.append(suffix);
+            links.slotLoc.push_back(locationCodes.intern(slotLocationCode));
 
-            // move the pointer to next slot
-            suffixData += sizeOfSuffixSizeDataMember + slotLocCodeSuffixSize;
+            // move to the next slot
+            suffixOffset += sizeOfSuffixSizeDataMember + slotSuffix->size();
         }
 
-        // store the information into a map
-        topologyInformation[linkId] = std::make_tuple(
-            linkStateMap[linkStatus], type, linkSpeed, linkWidth[width],
-            pcieHostBridgeLocationCode,
-            std::make_pair(localTopPortLocationCode,
-                           localBottomPortLocationCode),
-            std::make_pair(remoteTopPortLocationCode,
-                           remoteBottomPortLocationCode),
-            slotFinaLocationCode, parentLinkId);
-
-        // move the pointer to next link
-        singleEntryData = reinterpret_cast<struct pcieLinkEntry*>(
-            reinterpret_cast<uint8_t*>(singleEntryData) +
-            htobe16(singleEntryData->entryLength));
+        links.linkId.push_back(be16toh(entry->linkId));
+        links.parentLinkId.push_back(be16toh(entry->parentLinkId));
+        links.linkStatus.push_back(entry->linkStatus);
+        links.linkType.push_back(entry->linkType);
+        links.linkSpeed.push_back(entry->linkSpeed);
+        links.linkWidth.push_back(entry->linkWidth);
+        links.hostBridgeLoc.push_back(*hostBridge);
+        links.localPortTopLoc.push_back(*localTop);
+        links.localPortBottomLoc.push_back(*localBottom);
+        links.remotePortTopLoc.push_back(*remoteTop);
+        links.remotePortBottomLoc.push_back(*remoteBottom);
+        links.slotsEnd.push_back(links.slotLoc.size());
+
+        // move to the next link
+        auto entryLength = be16toh(entry->entryLength);
+        if (entryLength == 0)
+        {
+            error("Link {LINK} of the topology file has no length", "LINK",
+                  link);
+            return false;
+        }
+        entryOffset += entryLength;
     }
-    // Need to call cable info at the end , because we dont want to parse
-    // cable info without parsing the successful topology successfully
-    // Having partial information is of no use.
-    parseCableInfo();
+    return true;
 }
 
-void PCIeInfoHandler::parseCableInfo()
+bool parseCableInfo(std::span<const uint8_t> data, PCIeTopology& topology)
 {
-    int fd = open((fs::path(pciePath) / cableInfoFile).string().c_str(),
-                  O_RDONLY, S_IRUSR | S_IWUSR);
-    if (fd == -1)
+    BlobView blob(data);
+    auto header = blob.read<cableAttributesList>(0, cableHeaderSize);
+    if (!header)
     {
-        perror("CableInfo file not present");
-        return;
+        error("Cable information file is smaller than its header");
+        return false;
     }
-    pldm::utils::CustomFD cableInfoFd(fd);
-    struct stat sb;
+    uint16_t numOfCables = be16toh(header->numOfCables);
 
-    if (fstat(fd, &sb) == -1)
-    {
-        perror("Could not get cableinfo file size");
-        return;
-    }
+    auto& cables = topology.cables;
+    auto& locationCodes = topology.locationCodes;
 
-    if (sb.st_size == 0)
+    size_t entryOffset = firstCableOffset;
+    for (uint16_t cable = 0; cable < numOfCables; cable++)
     {
-        error("Topology file Size is 0");
-        return;
+        auto entry = blob.read<pcieLinkCableAttr>(entryOffset, cableEntrySize);
+        if (!entry)
+        {
+            error("Cable information file is truncated at cable {CABLE}",
+                  "CABLE", cable);
+            return false;
+        }
+
+        auto hostPort =
+            blob.string(entryOffset + be16toh(entry->hostPortLocationCodeOffset),
+                        entry->hostPortLocationCodeSize);
+        auto ioEnclosurePort = blob.string(
+            entryOffset + be16toh(entry->ioEnclosurePortLocationCodeOffset),
+            entry->ioEnclosurePortLocationCodeSize);
+        auto partNumber =
+            blob.string(entryOffset + be16toh(entry->cablePartNumberOffset),
+                        entry->cablePartNumberSize);
+        if (!hostPort || !ioEnclosurePort || !partNumber)
+        {
+            error("Attribute of cable {CABLE} is out of the cable information file",
+                  "CABLE", cable);
+            return false;
+        }
+
+        cables.linkId.push_back(be16toh(entry->linkId));
+        cables.hostPortLoc.push_back(locationCodes.intern(*hostPort));
+        cables.ioEnclosurePortLoc.push_back(
+            locationCodes.intern(*ioEnclosurePort));
+        cables.partNumber.push_back(locationCodes.intern(*partNumber));
+        cables.cableLength.push_back(entry->cableLength);
+        cables.cableType.push_back(entry->cableType);
+        cables.cableStatus.push_back(entry->cableStatus);
+
+        // move to the next cable
+        auto entryLength = be16toh(entry->entryLength);
+        if (entryLength == 0)
+        {
+            error("Cable {CABLE} of the cable information file has no length",
+                  "CABLE", cable);
+            return false;
+        }
+        entryOffset += entryLength;
     }
+    return true;
+}
 
-    auto cableInfoCleanup = [sb](void* fileInMemory) {
-        munmap(fileInMemory, sb.st_size);
-    };
+PCIeInfoHandler::PCIeInfoHandler(uint32_t fileHandle, uint16_t fileType) :
+    FileHandler(fileHandle), infoType(fileType)
+{
+    receivedFiles.emplace(infoType, false);
+}
 
-    void* fileInMemory =
-        mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, cableInfoFd(), 0);
+int PCIeInfoHandler::writeFromMemory(
+    uint32_t offset, uint32_t length, uint64_t address,
+    oem_platform::Handler* /*oemPlatformHandler*/)
+{
+    auto infoFile = getInfoFile(infoType);
 
-    if (MAP_FAILED == fileInMemory)
+    try
     {
-        int rc = -errno;
-        error("mmap on cable ifno file failed, RC={RC}", "RC", rc);
-        return;
+        if (offset == 0 || !fs::exists(infoFile))
+        {
+            // A new file starts with its first chunk
+            std::ofstream pcieData(infoFile, std::ios::out | std::ios::binary);
+        }
+        auto rc = transferFileData(infoFile, false, offset, length, address);
+        if (rc != PLDM_SUCCESS)
+        {
+            error("TransferFileData failed in PCIeTopology with error {ERROR}",
+                  "ERROR", rc);
+            return rc;
+        }
+        return PLDM_SUCCESS;
     }
+    catch (const std::exception& e)
+    {
+        error("Create/Write data to the File type {TYPE}, failed {ERROR}",
+              "TYPE", infoType, "ERROR", e);
+        return PLDM_ERROR;
+    }
+}
+
+int PCIeInfoHandler::write(const char* buffer, uint32_t offset,
+                           uint32_t& length,
+                           oem_platform::Handler* /*oemPlatformHandler*/)
+{
+    auto infoFile = getInfoFile(infoType);
 
-    std::unique_ptr<void, decltype(cableInfoCleanup)> cablePtr(
-        fileInMemory, cableInfoCleanup);
+    int flags = O_WRONLY | O_CREAT;
+    if (offset == 0)
+    {
+        // A new file starts with its first chunk
+        flags |= O_TRUNC;
+    }
+    int fd = open(infoFile.string().c_str(), flags, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+    {
+        error(
+            "Failed to open file '{PATH}' of type {TYPE}, error number - {ERROR_NUM}",
+            "PATH", infoFile, "TYPE", infoType, "ERROR_NUM", errno);
+        return PLDM_ERROR;
+    }
+    pldm::utils::CustomFD pcieData(fd);
 
-    auto cableList =
-        reinterpret_cast<struct cableAttributesList*>(fileInMemory);
+    if (buffer && pwrite(pcieData(), buffer, length, offset) !=
+                      static_cast<ssize_t>(length))
+    {
+        error(
+            "Failed to write data to the file type {TYPE} at offset {OFFSET}, error number - {ERROR_NUM}",
+            "TYPE", infoType, "OFFSET", offset, "ERROR_NUM", errno);
+        return PLDM_ERROR;
+    }
 
-    // get number of cable links
-    auto numOfCableLinks = htobe16(cableList->numOfCables);
+    return PLDM_SUCCESS;
+}
 
-    struct pcieLinkCableAttr* cableData =
-        reinterpret_cast<struct pcieLinkCableAttr*>(
-            (reinterpret_cast<uint8_t*>(cableList)) +
-            (sizeof(struct cableAttributesList) - 1));
+int PCIeInfoHandler::fileAck(uint8_t /*fileStatus*/)
+{
+    receivedFiles[infoType] = true;
+    try
+    {
+        if (receivedFiles.at(PLDM_FILE_TYPE_CABLE_INFO) &&
+            receivedFiles.at(PLDM_FILE_TYPE_PCIE_TOPOLOGY))
+        {
+            receivedFiles.clear();
+            // parse the topology data and cache the information
+            // for further processing
+            parseTopologyData();
+        }
+    }
+    catch (const std::out_of_range& e)
+    {
+        info("Received only one of the topology file");
+    }
+    return PLDM_SUCCESS;
+}
 
-    if (!cableData)
+void PCIeInfoHandler::parseTopologyData()
+{
+    PCIeTopology parsed{};
+    if (!parseFile(fs::path(pciePath) / topologyFile,
+                   [&parsed](std::span<const uint8_t> data) {
+                       return parseTopology(data, parsed);
+                   }))
     {
-        error("Cable info parsing failed , cableData = nullptr");
+        error("Failed to parse the topology file");
         return;
     }
+    topology = std::move(parsed);
+
+    // Need to call cable info at the end , because we dont want to parse
+    // cable info without parsing the successful topology successfully
+    // Having partial information is of no use.
+    parseCableInfo();
+}
 
-    // iterate over each pci cable link
-    for (const auto& cable :
-         std::views::iota(0) | std::views::take(numOfCableLinks))
+void PCIeInfoHandler::parseCableInfo()
+{
+    topology.cables = PCIeCableTable{};
+    if (!parseFile(fs::path(pciePath) / cableInfoFile,
+                   [](std::span<const uint8_t> data) {
+                       return pldm::responder::parseCableInfo(data, topology);
+                   }))
     {
-        // get the link id
-        auto linkId = htobe16(cableData->linkId);
-        char* cableDataPtr = reinterpret_cast<char*>(cableData);
-
-        std::string localPortLocCode(
-            cableDataPtr + htobe16(cableData->hostPortLocationCodeOffset),
-            cableData->hostPortLocationCodeSize);
-
-        std::string ioSlotLocationCode(
-            cableDataPtr +
-                htobe16(cableData->ioEnclosurePortLocationCodeOffset),
-            cableData->ioEnclosurePortLocationCodeSize);
-
-        std::string cablePartNum(
-            cableDataPtr + htobe16(cableData->cablePartNumberOffset),
-            cableData->cablePartNumberSize);
-
-        // cache the data into a map
-        cableInformation[cable] = std::make_tuple(
-            linkId, localPortLocCode, ioSlotLocationCode, cablePartNum,
-            cableLengthMap[cableData->cableLength],
-            cableTypeMap[cableData->cableType],
-            cableStatusMap[cableData->cableStatus]);
-        // move the cable data pointer
-
-        cableData = reinterpret_cast<struct pcieLinkCableAttr*>(
-            (reinterpret_cast<uint8_t*>(cableData)) +
-            htobe16(cableData->entryLength));
+        error("Failed to parse the cable information file");
+        topology.cables = PCIeCableTable{};
     }
 }
 
@@ -4,6 +4,9 @@
 
 #include <sys/mman.h>
 
+#include <deque>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 
 namespace pldm
@@ -128,6 +131,139 @@ struct cableAttributesList
     pcieLinkCableAttr pciLinkCableAttr[1];
 };
 
+/** @brief Index of an interned location code */
+using LocCodeId = uint32_t;
+
+/** @class LocationCodes
+ *
+ *  @brief Interns the location codes of the PCIe topology. The same codes
+ *         come back in many links, slots and cables, each one is stored once.
+ */
+class LocationCodes
+{
+  public:
+    LocationCodes() = default;
+    LocationCodes(const LocationCodes&) = delete;
+    LocationCodes& operator=(const LocationCodes&) = delete;
+    LocationCodes(LocationCodes&&) = default;
+    LocationCodes& operator=(LocationCodes&&) = default;
+
+    /** @brief Intern a location code
+     *
+     *  @param[in] code - the location code
+     *  @return the index of the code
+     */
+    LocCodeId intern(std::string_view code);
+
+    /** @brief Get an interned location code
+     *
+     *  @param[in] id - index returned by intern()
+     *  @return the location code
+     */
+    const std::string& get(LocCodeId id) const
+    {
+        return codes[id];
+    }
+
+    size_t size() const
+    {
+        return codes.size();
+    }
+
+  private:
+    std::deque<std::string> codes; //!< the codes, by index, never moved
+    std::unordered_map<std::string_view, LocCodeId> ids; //!< index of each
+                                                         //!< code
+};
+
+/** @struct PCIeLinkTable
+ *
+ *  @brief The links of the PCIe topology, one column per attribute and one
+ *         row per link in the order of the topology file
+ */
+struct PCIeLinkTable
+{
+    std::vector<LinkId> linkId;
+    std::vector<LinkId> parentLinkId;
+    std::vector<uint8_t> linkStatus; //!< key of linkStateMap
+    std::vector<linkTypeData> linkType;
+    std::vector<uint8_t> linkSpeed; //!< key of linkSpeed
+    std::vector<uint8_t> linkWidth; //!< key of linkWidth
+    std::vector<LocCodeId> hostBridgeLoc;
+    std::vector<LocCodeId> localPortTopLoc;
+    std::vector<LocCodeId> localPortBottomLoc;
+    std::vector<LocCodeId> remotePortTopLoc;
+    std::vector<LocCodeId> remotePortBottomLoc;
+    std::vector<uint32_t> slotsEnd; //!< end of the slots of each link in
+                                    //!< slotLoc
+    std::vector<LocCodeId> slotLoc; //!< I/O slot location codes of all the
+                                    //!< links
+
+    size_t size() const
+    {
+        return linkId.size();
+    }
+
+    /** @brief Get the I/O slot location codes of a link
+     *
+     *  @param[in] row - row of the link
+     *  @return the location codes
+     */
+    std::span<const LocCodeId> slots(size_t row) const
+    {
+        size_t begin = row == 0 ? 0 : slotsEnd[row - 1];
+        return std::span(slotLoc).subspan(begin, slotsEnd[row] - begin);
+    }
+};
+
+/** @struct PCIeCableTable
+ *
+ *  @brief The cables of the PCIe topology, one column per attribute and one
+ *         row per cable in the order of the cable information file
+ */
+struct PCIeCableTable
+{
+    std::vector<LinkId> linkId;
+    std::vector<LocCodeId> hostPortLoc;
+    std::vector<LocCodeId> ioEnclosurePortLoc;
+    std::vector<LocCodeId> partNumber;
+    std::vector<uint8_t> cableLength; //!< key of cableLengthMap
+    std::vector<uint8_t> cableType;   //!< key of cableTypeMap
+    std::vector<uint8_t> cableStatus; //!< key of cableStatusMap
+
+    size_t size() const
+    {
+        return linkId.size();
+    }
+};
+
+/** @struct PCIeTopology
+ *
+ *  @brief The PCIe links and cables reported by the host
+ */
+struct PCIeTopology
+{
+    LocationCodes locationCodes;
+    PCIeLinkTable links;
+    PCIeCableTable cables;
+};
+
+/** @brief Parse the PCIe topology file sent by the host, in place
+ *
+ *  @param[in] data - the topology file
+ *  @param[out] topology - topology the links are added to
+ *  @return false if the file is malformed
+ */
+bool parseTopology(std::span<const uint8_t> data, PCIeTopology& topology);
+
+/** @brief Parse the cable information file sent by the host, in place
+ *
+ *  @param[in] data - the cable information file
+ *  @param[out] topology - topology the cables are added to
+ *  @return false if the file is malformed
+ */
+bool parseCableInfo(std::span<const uint8_t> data, PCIeTopology& topology);
+
 /** @class PCIeInfoHandler
  *
  *  @brief Inherits and implements FileHandler. This class is used to handle the
@@ -198,57 +334,10 @@ class PCIeInfoHandler : public FileHandler
   private:
     uint16_t infoType; //!< type of the information
 
-    /**
-     * @brief Map contains Topology data
-     *
-     * This static unordered map associates link IDs with link attributes.
-     * Key - LinkID (LinkId)
-     * Value - Tuple
-     *         link status (LinkStatus)
-     *         link type (LinkType)
-     *         link speed (LinkSpeed)
-     *         link width (LinkWidth)
-     *         PCIe host bridge location (PcieHostBridgeLoc)
-     *         Local port (LocalPort - Pair of local port top and bottom)
-     *         Remote port (RemotePort - Pair of remote port top and bottom)
-     *         I/O slot location (IoSlotLocation - Vector of strings)
-     */
-    static std::unordered_map<
-        LinkId, std::tuple<LinkStatus, linkTypeData, LinkSpeed, LinkWidth,
-                           PcieHostBridgeLoc, LocalPort, RemotePort,
-                           IoSlotLocation, LinkId>>
-        topologyInformation;
-    /**
-     * @brief Static unordered map containing cable information.
-     *
-     * This map associates cable link numbers with a tuple containing various
-     * cable attributes.
-     *
-     * Key - CableLinkID (CableLinkNum)
-     * Value - Tuple
-     *         Link ID (LinkId)
-     *         Local port location code (LocalPortLocCode)
-     *         I/O slot location code (IoSlotLocationCode)
-     *         Cable part number (CablePartNum)
-     *         Cable length (CableLength)
-     *         Cable type (CableType)
-     *         Cable status (CableStatus)
-     */
-
-    static std::unordered_map<
-        CableLinkNum,
-        std::tuple<LinkId, LocalPortLocCode, IoSlotLocationCode, CablePartNum,
-                   CableLength, CableType, CableStatus>>
-        cableInformation;
-    /**
-     * @brief Static unordered map containing linkId to link type information.
-     *
-     * This map associates link numbers to the link type
-     *
-     * Key - LinkID (LinkId)
-     * Value - linkTypeData (linkTypeData)
+    /** @brief The topology last received from the host, the topology and
+     *         cable information files are received by different handlers
      */
-    static std::unordered_map<LinkId, linkTypeData> linkTypeInfo;
+    static PCIeTopology topology;
 
     /** @brief A static unordered map storing information about received files.
      *
@@ -3,8 +3,10 @@
 #include "common/utils.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
+#include <fcntl.h>
 #include <libpldm/base.h>
 #include <libpldm/oem/ibm/file_io.h>
+#include <sys/stat.h>
 #include <systemd/sd-bus.h>
 #include <unistd.h>
 
@@ -17,6 +19,8 @@
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <system_error>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -90,26 +94,44 @@ Entry::Level getEntryLevelFromPEL(const std::string& pelFileName)
 }
 } // namespace detail
 
-int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
-                               uint64_t address,
-                               oem_platform::Handler* /*oemPlatformHandler*/)
+int PelHandler::getPelFd()
 {
+    if (pelFd)
+    {
+        return (*pelFd)();
+    }
+
     static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
     static constexpr auto logInterface = "org.open_power.Logging.PEL";
-
     auto& bus = pldm::utils::DBusHandler::getBus();
 
+    auto service =
+        pldm::utils::DBusHandler().getService(logObjPath, logInterface);
+    auto method = bus.new_method_call(service.c_str(), logObjPath,
+                                      logInterface, "GetPEL");
+    method.append(fileHandle);
+    auto reply = bus.call(method, dbusTimeout);
+    sdbusplus::message::unix_fd fd{};
+    reply.read(fd);
+
+    // The descriptor is closed with the reply, keep a duplicate
+    int dupFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (dupFd == -1)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to duplicate the PEL descriptor");
+    }
+    pelFd = std::make_unique<pldm::utils::CustomFD>(dupFd);
+    return (*pelFd)();
+}
+
+int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
+                               uint64_t address,
+                               oem_platform::Handler* /*oemPlatformHandler*/)
+{
     try
     {
-        auto service =
-            pldm::utils::DBusHandler().getService(logObjPath, logInterface);
-        auto method = bus.new_method_call(service.c_str(), logObjPath,
-                                          logInterface, "GetPEL");
-        method.append(fileHandle);
-        auto reply = bus.call(method, dbusTimeout);
-        sdbusplus::message::unix_fd fd{};
-        reply.read(fd);
-        auto rc = transferFileData(fd, true, offset, length, address);
+        auto rc = transferFileData(getPelFd(), true, offset, length, address);
         return rc;
     }
     catch (const std::exception& e)
@@ -126,27 +148,17 @@ int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
 int PelHandler::read(uint32_t offset, uint32_t& length, Response& response,
                      oem_platform::Handler* /*oemPlatformHandler*/)
 {
-    static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
-    static constexpr auto logInterface = "org.open_power.Logging.PEL";
-    auto& bus = pldm::utils::DBusHandler::getBus();
-
     try
     {
-        auto service =
-            pldm::utils::DBusHandler().getService(logObjPath, logInterface);
-        auto method = bus.new_method_call(service.c_str(), logObjPath,
-                                          logInterface, "GetPEL");
-        method.append(fileHandle);
-        auto reply = bus.call(method, dbusTimeout);
-        sdbusplus::message::unix_fd fd{};
-        reply.read(fd);
-
-        off_t fileSize = lseek(fd, 0, SEEK_END);
-        if (fileSize == -1)
+        auto fd = getPelFd();
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == -1)
         {
-            error("File lseek failed");
+            error("File stat failed");
             return PLDM_ERROR;
         }
+        off_t fileSize = fileStat.st_size;
         if (offset >= fileSize)
         {
             error(
@@ -158,23 +170,16 @@ int PelHandler::read(uint32_t offset, uint32_t& length, Response& response,
         {
             length = fileSize - offset;
         }
-        auto rc = lseek(fd, offset, SEEK_SET);
-        if (rc == -1)
-        {
-            error("Failed to do file lseek at offset '{OFFSET}'", "OFFSET",
-                  offset);
-            return PLDM_ERROR;
-        }
         size_t currSize = response.size();
         response.resize(currSize + length);
         auto filePos = reinterpret_cast<char*>(response.data());
         filePos += currSize;
-        rc = ::read(fd, filePos, length);
+        auto rc = pread(fd, filePos, length, offset);
         if (rc == -1)
         {
             error(
                 "Failed to do file read of length '{LENGTH}' at offset '{OFFSET}'",
-                "LENGTH", length, "OFFSET", filePos);
+                "LENGTH", length, "OFFSET", offset);
             return PLDM_ERROR;
         }
         if (rc != length)
@@ -225,6 +230,9 @@ int PelHandler::fileAck(uint8_t fileStatus)
     static std::string service;
     auto& bus = pldm::utils::DBusHandler::getBus();
 
+    // The host is done reading the PEL
+    pelFd.reset();
+
     if (service.empty())
     {
         try
@@ -2,6 +2,8 @@
 
 #include "file_io_by_type.hpp"
 
+#include <memory>
+
 namespace pldm
 {
 namespace responder
@@ -51,6 +53,19 @@ class PelHandler : public FileHandler
     /** @brief PelHandler destructor
      */
     ~PelHandler() {}
+
+  private:
+    /** @brief Get the descriptor of the PEL being read, the GetPEL D-Bus call
+     *         is made for the first chunk only and its descriptor is kept
+     *         until the PEL is acked
+     *
+     *  @return the PEL file descriptor
+     *  @throw std::exception if the PEL can't be fetched
+     */
+    int getPelFd();
+
+    std::unique_ptr<pldm::utils::CustomFD> pelFd; //!< descriptor of the PEL
+                                                  //!< being read
 };
 
 } // namespace responder
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class FileSessionCache
+ *
+ *  @brief Keeps the state looked up for a file transfer, such as an open file
+ *         descriptor or a D-Bus object path, for the chunks the host requests
+ *         after the first one. An entry lives until the transfer is acked or
+ *         it goes unused for idleTimeout. An entry pinned by a transfer still
+ *         in progress is never expired and is only evicted when every entry
+ *         is pinned.
+ *
+ *  @tparam T - the cached state, movable
+ */
+template <typename T>
+class FileSessionCache
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Time an entry is kept without being used */
+    static constexpr std::chrono::seconds idleTimeout{30};
+
+    /** @brief Number of transfers cached at once */
+    static constexpr size_t maxEntries = 16;
+
+    /** @brief Constructor
+     *
+     *  @param[in] pinned - tells if the state of a transfer is pinned, none
+     *                      is if not set
+     */
+    explicit FileSessionCache(std::function<bool(const T&)> pinned = {}) :
+        pinned(std::move(pinned))
+    {}
+
+    /** @brief Look up the state of a transfer
+     *
+     *  @param[in] key - the transfer, usually the file handle
+     *  @return the state, nullptr if not cached
+     */
+    T* find(uint64_t key)
+    {
+        expire();
+        auto entry = entries.find(key);
+        if (entry == entries.end())
+        {
+            return nullptr;
+        }
+        entry->second.lastUsed = Clock::now();
+        return &entry->second.value;
+    }
+
+    /** @brief Cache the state of a transfer
+     *
+     *  @param[in] key - the transfer
+     *  @param[in] value - the state
+     *  @return the cached state
+     */
+    T& insert(uint64_t key, T&& value)
+    {
+        expire();
+        if (entries.size() >= maxEntries && !entries.contains(key))
+        {
+            // The least recently used entry, the unpinned ones first
+            entries.erase(std::ranges::min_element(
+                entries, {}, [this](const auto& entry) {
+                    return std::make_pair(isPinned(entry.second.value),
+                                          entry.second.lastUsed);
+                }));
+        }
+        auto& entry = entries[key];
+        entry.value = std::move(value);
+        entry.lastUsed = Clock::now();
+        return entry.value;
+    }
+
+    /** @brief Drop the state of a transfer once it is acked
+     *
+     *  @param[in] key - the transfer
+     */
+    void erase(uint64_t key)
+    {
+        entries.erase(key);
+    }
+
+  private:
+    struct Entry
+    {
+        T value{};
+        Clock::time_point lastUsed{};
+    };
+
+    bool isPinned(const T& value) const
+    {
+        return pinned && pinned(value);
+    }
+
+    /** @brief Drop the unpinned entries idle for longer than idleTimeout */
+    void expire()
+    {
+        auto now = Clock::now();
+        std::erase_if(entries, [this, now](const auto& entry) {
+            return !isPinned(entry.second.value) &&
+                   now - entry.second.lastUsed > idleTimeout;
+        });
+    }
+
+    std::function<bool(const T&)> pinned;
+    std::map<uint64_t, Entry> entries;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -5,6 +5,7 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <fstream>
+#include <mutex>
 
 PHOSPHOR_LOG2_USING;
 
@@ -129,14 +130,33 @@ Table FileTable::operator()() const
     return table;
 }
 
-FileTable& buildFileTable(const std::string& fileTablePath)
+namespace
 {
-    static FileTable table;
-    if (table.isEmpty())
+
+/** @brief Guards the file table, the handlers reading it run on the worker
+ *         pool
+ */
+std::mutex fileTableMutex;
+
+/** @brief The file table built from the file table config */
+FileTable cachedTable;
+
+} // namespace
+
+FileTable buildFileTable(const std::string& fileTablePath)
+{
+    std::lock_guard lock(fileTableMutex);
+    if (cachedTable.isEmpty())
     {
-        table = FileTable(fileTablePath);
+        cachedTable = FileTable(fileTablePath);
     }
-    return table;
+    return cachedTable;
+}
+
+void clearFileTable()
+{
+    std::lock_guard lock(fileTableMutex);
+    cachedTable.clear();
 }
 
 } // namespace filetable
@@ -116,10 +116,16 @@ class FileTable
  *
  *  @param[in] fileTablePath - path of the file table config
  *
- *  @return FileTable& - Reference to instance of file table
+ *  @return FileTable - Copy of the file table, taken under the lock so
+ *                      handlers on the worker pool never read it while it
+ *                      is rebuilt
  */
 
-FileTable& buildFileTable(const std::string& fileTablePath);
+FileTable buildFileTable(const std::string& fileTablePath);
+
+/** @brief Clear the file table so the next buildFileTable() rebuilds it
+ */
+void clearFileTable();
 
 } // namespace filetable
 } // namespace pldm
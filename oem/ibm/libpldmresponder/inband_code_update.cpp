@@ -5,14 +5,18 @@
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <libpldm/entity.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Dump/NewDump/server.hpp>
 
+#include <algorithm>
+#include <array>
 #include <exception>
-#include <fstream>
+#include <sstream>
 
 PHOSPHOR_LOG2_USING;
 
@@ -463,78 +467,185 @@ int executeCmd(const T&... t)
     return 0;
 }
 
-int processCodeUpdateLid(const std::string& filePath)
+namespace
+{
+
+struct LidHeader
+{
+    uint16_t magicNumber;
+    uint16_t headerVersion;
+    uint32_t lidNumber;
+    uint32_t lidDate;
+    uint16_t lidTime;
+    uint16_t lidClass;
+    uint32_t lidCrc;
+    uint32_t lidSize;
+    uint32_t headerSize;
+};
+
+} // namespace
+
+bool copyRangeBuffered(int inFd, off_t inOffset, int outFd, off_t outOffset,
+                       size_t length)
+{
+    std::array<char, 64 * 1024> buffer;
+    while (length)
+    {
+        auto rc = pread(inFd, buffer.data(), std::min(length, buffer.size()),
+                        inOffset);
+        if (rc <= 0 || pwrite(outFd, buffer.data(), rc, outOffset) != rc)
+        {
+            return false;
+        }
+        inOffset += rc;
+        outOffset += rc;
+        length -= rc;
+    }
+    return true;
+}
+
+bool copyRange(int inFd, off_t inOffset, int outFd, off_t outOffset,
+               size_t length)
+{
+    while (length)
+    {
+        auto copied = copy_file_range(inFd, &inOffset, outFd, &outOffset,
+                                      length, 0);
+        if (copied > 0)
+        {
+            length -= copied;
+            continue;
+        }
+        if (copied == 0 ||
+            (errno != EXDEV && errno != ENOSYS && errno != EINVAL))
+        {
+            return false;
+        }
+
+        // Not supported between these files, fall back to a buffered copy
+        return copyRangeBuffered(inFd, inOffset, outFd, outOffset, length);
+    }
+    return true;
+}
+
+bool LidAssembler::readHeader(int fd, const fs::path& lidPath, Lid& lid)
 {
-    struct LidHeader
-    {
-        uint16_t magicNumber;
-        uint16_t headerVersion;
-        uint32_t lidNumber;
-        uint32_t lidDate;
-        uint16_t lidTime;
-        uint16_t lidClass;
-        uint32_t lidCrc;
-        uint32_t lidSize;
-        uint32_t headerSize;
-    };
     LidHeader header;
+    if (pread(fd, &header, sizeof(header), 0) !=
+        static_cast<ssize_t>(sizeof(header)))
+    {
+        error("Failed to read the header of LID '{PATH}'", "PATH",
+              lidPath.string());
+        return false;
+    }
 
-    std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
-    if (!ifs)
+    constexpr auto magicNumber = 0x0222;
+    if (htons(header.magicNumber) != magicNumber ||
+        htonl(header.headerSize) < sizeof(header))
     {
-        error("Failed to opening file '{FILE}' ifstream", "PATH", filePath);
-        return PLDM_ERROR;
+        error("Invalid header for file '{PATH}'", "PATH", lidPath.string());
+        return false;
     }
-    ifs.seekg(0);
-    ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
 
-    // File size should be the value of lid size minus the header size
-    auto fileSize = fs::file_size(filePath);
-    fileSize -= htonl(header.headerSize);
-    if (fileSize < htonl(header.lidSize))
+    constexpr auto bmcClass = 0x2000;
+    lid.bmcLid = htons(header.lidClass) == bmcClass;
+    lid.lidNumber = htonl(header.lidNumber);
+    lid.lidSize = htonl(header.lidSize);
+    lid.headerSize = htonl(header.headerSize);
+    lid.headerValid = true;
+    return true;
+}
+
+int LidAssembler::write(const fs::path& lidPath, uint32_t offset,
+                        uint32_t length)
+{
+    auto& lid = lids[lidPath];
+    if (offset <= lid.contiguous)
+    {
+        lid.contiguous = std::max<uint64_t>(lid.contiguous,
+                                            uint64_t(offset) + length);
+    }
+    if (!lid.headerValid && lid.contiguous < sizeof(LidHeader))
     {
-        // File is not completely written yet
-        ifs.close();
+        // Header is not completely written yet
         return PLDM_SUCCESS;
     }
 
-    constexpr auto magicNumber = 0x0222;
-    if (htons(header.magicNumber) != magicNumber)
+    auto inFd = open(lidPath.c_str(), O_RDONLY);
+    if (inFd == -1)
+    {
+        error("Failed to open file '{PATH}'", "PATH", lidPath.string());
+        lids.erase(lidPath);
+        return PLDM_ERROR;
+    }
+    pldm::utils::CustomFD lidFd(inFd);
+    if (!lid.headerValid && !readHeader(inFd, lidPath, lid))
     {
-        error("Invalid magic number for file '{PATH}'", "PATH", filePath);
-        ifs.close();
+        lids.erase(lidPath);
         return PLDM_ERROR;
     }
 
+    // File size should be the value of lid size plus the header size
+    uint64_t fileSize = fs::file_size(lidPath);
+    bool complete = fileSize >= uint64_t(lid.headerSize) + lid.lidSize;
+    if (!complete && lid.bmcLid)
+    {
+        // The BMC LIDs are concatenated into the tarball as they complete
+        return PLDM_SUCCESS;
+    }
+
     fs::create_directories(imageDirPath);
     fs::create_directories(lidDirPath);
 
-    constexpr auto bmcClass = 0x2000;
-    if (htons(header.lidClass) == bmcClass)
+    fs::path outPath = tarImagePath;
+    int flags = O_WRONLY | O_CREAT;
+    if (!lid.bmcLid)
     {
-        // Skip the header and concatenate the BMC LIDs into a tar file
-        std::ofstream ofs(tarImagePath,
-                          std::ios::out | std::ios::binary | std::ios::app);
-        ifs.seekg(htonl(header.headerSize));
-        ofs << ifs.rdbuf();
-        ofs.flush();
-        ofs.close();
+        std::stringstream lidFileName;
+        lidFileName << std::hex << lid.lidNumber << ".lid";
+        outPath = fs::path(lidDirPath) / lidFileName.str();
+        if (!lid.copied)
+        {
+            flags |= O_TRUNC;
+        }
     }
-    else
+    auto outFd = open(outPath.c_str(), flags, S_IRUSR | S_IWUSR);
+    if (outFd == -1)
     {
-        std::stringstream lidFileName;
-        lidFileName << std::hex << htonl(header.lidNumber) << ".lid";
-        auto lidNoHeaderPath = fs::path(lidDirPath) / lidFileName.str();
-        std::ofstream ofs(lidNoHeaderPath,
-                          std::ios::out | std::ios::binary | std::ios::trunc);
-        ifs.seekg(htonl(header.headerSize));
-        ofs << ifs.rdbuf();
-        ofs.flush();
-        ofs.close();
-    }
-
-    ifs.close();
-    fs::remove(filePath);
+        error("Failed to open file '{PATH}'", "PATH", outPath.string());
+        lids.erase(lidPath);
+        return PLDM_ERROR;
+    }
+    pldm::utils::CustomFD assembledFd(outFd);
+
+    // Copy the payload written so far, all of it once the LID is complete
+    uint64_t end = complete ? fileSize : lid.contiguous;
+    uint64_t from = uint64_t(lid.headerSize) + lid.copied;
+    if (end > from)
+    {
+        off_t outOffset = lid.copied;
+        if (lid.bmcLid)
+        {
+            outOffset = lseek(outFd, 0, SEEK_END);
+        }
+        if (outOffset < 0 ||
+            !copyRange(inFd, from, outFd, outOffset, end - from))
+        {
+            error(
+                "Failed to copy LID '{PATH}' to '{OUT_PATH}', error number - {ERROR_NUM}",
+                "PATH", lidPath.string(), "OUT_PATH", outPath.string(),
+                "ERROR_NUM", errno);
+            lids.erase(lidPath);
+            return PLDM_ERROR;
+        }
+        lid.copied += end - from;
+    }
+
+    if (complete)
+    {
+        lids.erase(lidPath);
+        fs::remove(lidPath);
+    }
     return PLDM_SUCCESS;
 }
 
@@ -579,10 +690,22 @@ int CodeUpdate::assembleCodeUpdateImage()
             }
 
             // Add the hostfw image to the directory where the contents were
-            // extracted
-            fs::copy_file(hostfwImagePath,
-                          fs::path(updateDirPath) / hostfwImageName,
-                          fs::copy_options::overwrite_existing);
+            // extracted, both are in the staging directory
+            std::error_code ec;
+            fs::rename(hostfwImagePath,
+                       fs::path(updateDirPath) / hostfwImageName, ec);
+            if (ec)
+            {
+                error(
+                    "Failed to move the hostfw image to '{PATH}', error - {ERROR}",
+                    "PATH", updateDirPath.string(), "ERROR", ec.message());
+                setCodeUpdateProgress(false);
+                auto sensorId = getFirmwareUpdateSensor();
+                sendStateSensorEvent(sensorId, PLDM_STATE_SENSOR_STATE, 0,
+                                     uint8_t(CodeUpdateState::FAIL),
+                                     uint8_t(CodeUpdateState::START));
+                _exit(EXIT_FAILURE);
+            }
 
             // Remove the tarball file, then re-generate it with so that the
             // hostfw image becomes part of the tarball
@@ -601,7 +724,8 @@ int CodeUpdate::assembleCodeUpdateImage()
             }
 
             // Copy the tarball to the update directory to trigger the phosphor
-            // software manager to create a version interface
+            // software manager to create a version interface, it watches for
+            // IN_CLOSE_WRITE which a rename into the directory doesn't raise
             fs::copy_file(tarImagePath, updateImagePath,
                           fs::copy_options::overwrite_existing);
 
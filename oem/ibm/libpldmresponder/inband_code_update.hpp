@@ -4,6 +4,10 @@
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform.hpp"
 
+#include <sys/types.h>
+
+#include <filesystem>
+#include <map>
 #include <string>
 
 namespace pldm
@@ -19,6 +23,90 @@ static constexpr auto Tside = "T";
 static constexpr auto redundancyIntf =
     "xyz.openbmc_project.Software.RedundancyPriority";
 
+/** @brief Copy a range of a file to another, in the kernel when the files
+ *         allow it, with copyRangeBuffered() otherwise
+ *
+ *  @param[in] inFd - source file
+ *  @param[in] inOffset - offset of the range in the source file
+ *  @param[in] outFd - destination file
+ *  @param[in] outOffset - offset of the range in the destination file
+ *  @param[in] length - length of the range
+ *  @return true if the whole range was copied
+ */
+bool copyRange(int inFd, off_t inOffset, int outFd, off_t outOffset,
+               size_t length);
+
+/** @brief Copy a range of a file to another through a user space buffer
+ *
+ *  @param[in] inFd - source file
+ *  @param[in] inOffset - offset of the range in the source file
+ *  @param[in] outFd - destination file
+ *  @param[in] outOffset - offset of the range in the destination file
+ *  @param[in] length - length of the range
+ *  @return true if the whole range was copied
+ */
+bool copyRangeBuffered(int inFd, off_t inOffset, int outFd, off_t outOffset,
+                       size_t length);
+
+/** @class LidAssembler
+ *
+ *  @brief Strips the headers of the LIDs staged during an inband code update
+ *         as their chunks are written. The header of a LID is validated as
+ *         soon as its first bytes arrive, and the payload of a host firmware
+ *         LID is copied by the kernel to its headerless file chunk by chunk,
+ *         so that the last chunk only costs the copy of that chunk.
+ */
+class LidAssembler
+{
+  public:
+    /** @brief Process a chunk written to a staged LID
+     *
+     *  @param[in] lidPath - path of the staged LID
+     *  @param[in] offset - offset of the chunk in the LID
+     *  @param[in] length - length of the chunk
+     *  @return PLDM_SUCCESS, PLDM_ERROR if the LID is invalid or couldn't be
+     *          assembled
+     */
+    int write(const std::filesystem::path& lidPath, uint32_t offset,
+              uint32_t length);
+
+    /** @brief Forget the LIDs being assembled */
+    void reset()
+    {
+        lids.clear();
+    }
+
+  private:
+    /** @struct Lid
+     *
+     *  Assembly state of a staged LID
+     */
+    struct Lid
+    {
+        bool headerValid = false; //!< header read and validated
+        bool bmcLid = false;      //!< payload goes to the BMC tarball
+        uint32_t lidNumber = 0;
+        uint32_t lidSize = 0;     //!< payload size
+        uint32_t headerSize = 0;
+        uint64_t contiguous = 0;  //!< end of the bytes written without a gap
+        uint64_t copied = 0;      //!< payload bytes copied to the headerless
+                                  //!< LID
+    };
+
+    /** @brief Read and validate the header of a LID
+     *
+     *  @param[in] fd - staged LID
+     *  @param[in] lidPath - path of the staged LID
+     *  @param[out] lid - assembly state of the LID
+     *  @return true if the header is valid
+     */
+    static bool readHeader(int fd, const std::filesystem::path& lidPath,
+                           Lid& lid);
+
+    /** @brief LIDs being assembled, keyed by their staged path */
+    std::map<std::filesystem::path, Lid> lids;
+};
+
 /** @class CodeUpdate
  *
  *  @brief This class performs the necessary operation in pldm for
@@ -94,6 +182,21 @@ class CodeUpdate
     void setCodeUpdateProgress(bool progress)
     {
         codeUpdateInProgress = progress;
+        lidAssembler.reset();
+    }
+
+    /* @brief Method to process a chunk of a LID written during inband
+     *        update, such as verifying and removing the header to get it
+     *        ready to be written to flash
+     * @param[in] filePath - Path to the LID file
+     * @param[in] offset - offset of the chunk in the LID
+     * @param[in] length - length of the chunk
+     * @return - PLDM_SUCCESS codes
+     */
+    int processCodeUpdateLid(const std::string& filePath, uint32_t offset,
+                             uint32_t length)
+    {
+        return lidAssembler.write(filePath, offset, length);
     }
 
     /** @brief Method to clear contents the LID staging directory that contains
@@ -195,6 +298,7 @@ class CodeUpdate
         oemPlatformHandler; //!< oem platform handler
     uint16_t markerLidSensorId;
     uint16_t firmwareUpdateSensorId;
+    LidAssembler lidAssembler; //!< LIDs staged by the inband update
 
     /** @brief D-Bus property changed signal match for image activation */
     std::unique_ptr<sdbusplus::bus::match_t> imageActivationMatch;
@@ -226,12 +330,5 @@ int setBootSide(uint16_t entityInstance, uint8_t currState,
                 const std::vector<set_effecter_state_field>& stateField,
                 CodeUpdate* codeUpdate);
 
-/* @brief Method to process LIDs during inband update, such as verifying and
- *        removing the header to get them ready to be written to flash
- * @param[in] filePath - Path to the LID file
- * @return - PLDM_SUCCESS codes
- */
-int processCodeUpdateLid(const std::string& filePath);
-
 } // namespace responder
 } // namespace pldm
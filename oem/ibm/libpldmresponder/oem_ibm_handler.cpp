@@ -484,7 +484,8 @@ int pldm::responder::oem_ibm_platform::Handler::sendEventToHost(
     auto rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
         std::move(requestMsg),
-        std::move(oemPlatformEventMessageResponseHandler));
+        std::move(oemPlatformEventMessageResponseHandler),
+        pldm::requester::RequestPriority::Event);
     if (rc)
     {
         error("Failed to send BIOS attribute change event message ");
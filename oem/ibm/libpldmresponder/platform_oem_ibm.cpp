@@ -104,7 +104,8 @@ int sendBiosAttributeUpdateEvent(
     };
     rc = handler->registerRequest(
         eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
-        std::move(requestMsg), std::move(platformEventMessageResponseHandler));
+        std::move(requestMsg), std::move(platformEventMessageResponseHandler),
+        pldm::requester::RequestPriority::Event);
     if (rc)
     {
         error(
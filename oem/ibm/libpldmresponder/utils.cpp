@@ -41,7 +41,8 @@ int setupUnixSocket(const std::string& socketInterface)
 
     strncpy(addr.sun_path, socketInterface.c_str(), sizeof(addr.sun_path) - 1);
 
-    if ((sock = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0)) == -1)
+    if ((sock = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                       0)) == -1)
     {
         error("Failed to open unix socket");
         return -1;
@@ -62,98 +63,7 @@ int setupUnixSocket(const std::string& socketInterface)
         return -1;
     }
 
-    fd_set rfd;
-    struct timeval tv;
-    tv.tv_sec = 1;
-    tv.tv_usec = 0;
-
-    FD_ZERO(&rfd);
-    FD_SET(sock, &rfd);
-    int nfd = sock + 1;
-    int fd = -1;
-
-    int retval = select(nfd, &rfd, NULL, NULL, &tv);
-    if (retval < 0)
-    {
-        error(
-            "Failed select() call while setting up unix socket, error number - {ERROR_NUM}",
-            "ERROR_NUM", errno);
-        close(sock);
-        return -1;
-    }
-
-    if ((retval > 0) && (FD_ISSET(sock, &rfd)))
-    {
-        fd = accept(sock, NULL, NULL);
-        if (fd < 0)
-        {
-            error(
-                "Failed accept() call while setting up unix socket, error number - {ERROR_NUM}",
-                "ERROR_NUM", errno);
-            close(sock);
-            return -1;
-        }
-        close(sock);
-    }
-    return fd;
-}
-
-int writeToUnixSocket(const int sock, const char* buf, const uint64_t blockSize)
-{
-    uint64_t i;
-    int nwrite = 0;
-
-    for (i = 0; i < blockSize; i = i + nwrite)
-    {
-        fd_set wfd;
-        struct timeval tv;
-        tv.tv_sec = 1;
-        tv.tv_usec = 0;
-
-        FD_ZERO(&wfd);
-        FD_SET(sock, &wfd);
-        int nfd = sock + 1;
-
-        int retval = select(nfd, NULL, &wfd, NULL, &tv);
-        if (retval < 0)
-        {
-            error(
-                "Failed to write to unix socket select, error number - {ERROR_NUM}",
-                "ERROR_NUM", errno);
-            close(sock);
-            return -1;
-        }
-        if (retval == 0)
-        {
-            nwrite = 0;
-            continue;
-        }
-        if ((retval > 0) && (FD_ISSET(sock, &wfd)))
-        {
-            nwrite = write(sock, buf + i, blockSize - i);
-            if (nwrite < 0)
-            {
-                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
-                {
-                    error(
-                        "Failed to write to unix socket, error number - {ERROR_NUM}",
-                        "ERROR_NUM", errno);
-                    nwrite = 0;
-                    continue;
-                }
-                error(
-                    "Failed to write to unix socket, error number - {ERROR_NUM}",
-                    "ERROR_NUM", errno);
-                close(sock);
-                return -1;
-            }
-        }
-        else
-        {
-            nwrite = 0;
-        }
-    }
-    return 0;
+    return sock;
 }
 
 bool checkIfIBMFru(const std::string& objPath)
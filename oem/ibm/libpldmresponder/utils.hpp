@@ -15,30 +15,14 @@ namespace utils
 
 /** @brief Setup UNIX socket
  *  This function creates listening socket in non-blocking mode and allows only
- *  one socket connection. returns accepted socket after accepting connection
- *  from peer.
+ *  one socket connection. The connection is accepted by the caller.
  *
  *  @param[in] socketInterface - unix socket path
- *  @return   on success returns accepted socket fd
+ *  @return   on success returns the listening socket fd
  *            on failure returns -1
  */
 int setupUnixSocket(const std::string& socketInterface);
 
-/** @brief Write data on UNIX socket
- *  This function writes given data to a non-blocking socket.
- *  Irrespective of block size, this function make sure of writing given data
- *  on unix socket.
- *
- *  @param[in] sock - unix socket
- *  @param[in] buf -  data buffer
- *  @param[in] blockSize - size of data to write
- *  @return   on success returns  0
- *            on failure returns -1
-
- */
-int writeToUnixSocket(const int sock, const char* buf,
-                      const uint64_t blockSize);
-
 /** @brief checks if given FRU is IBM specific
  *
  *  @param[in] objPath - FRU object path
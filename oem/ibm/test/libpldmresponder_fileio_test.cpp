@@ -1,4 +1,6 @@
 
+#include "libpldmresponder/dump_offload.hpp"
+#include "libpldmresponder/file_handler_registry.hpp"
 #include "libpldmresponder/file_io.hpp"
 #include "libpldmresponder/file_io_by_type.hpp"
 #include "libpldmresponder/file_io_type_cert.hpp"
@@ -6,14 +8,22 @@
 #include "libpldmresponder/file_io_type_lid.hpp"
 #include "libpldmresponder/file_io_type_pcie.hpp"
 #include "libpldmresponder/file_io_type_pel.hpp"
+#include "libpldmresponder/file_session_cache.hpp"
 #include "libpldmresponder/file_table.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <libpldm/base.h>
 #include <libpldm/oem/ibm/file_io.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
@@ -257,7 +267,7 @@ TEST_F(TestFileTable, ReadFileInvalidFileHandle)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
@@ -266,7 +276,7 @@ TEST_F(TestFileTable, ReadFileInvalidFileHandle)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_INVALID_FILE_HANDLE);
     // Clear the file table contents.
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, ReadFileInvalidOffset)
@@ -292,7 +302,7 @@ TEST_F(TestFileTable, ReadFileInvalidOffset)
            &address, sizeof(address));
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
@@ -301,7 +311,7 @@ TEST_F(TestFileTable, ReadFileInvalidOffset)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_DATA_OUT_OF_RANGE);
     // Clear the file table contents.
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, ReadFileInvalidLength)
@@ -327,7 +337,7 @@ TEST_F(TestFileTable, ReadFileInvalidLength)
            &address, sizeof(address));
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
@@ -336,7 +346,7 @@ TEST_F(TestFileTable, ReadFileInvalidLength)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_ERROR_INVALID_LENGTH);
     // Clear the file table contents.
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, ReadFileInvalidEffectiveLength)
@@ -365,7 +375,7 @@ TEST_F(TestFileTable, ReadFileInvalidEffectiveLength)
            &address, sizeof(address));
 
     using namespace pldm::filetable;
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
@@ -374,7 +384,7 @@ TEST_F(TestFileTable, ReadFileInvalidEffectiveLength)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_ERROR_INVALID_LENGTH);
     // Clear the file table contents.
-    table.clear();
+    clearFileTable();
 }
 
 TEST(WriteFileFromMemory, BadPath)
@@ -436,7 +446,7 @@ TEST_F(TestFileTable, WriteFileInvalidFileHandle)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
@@ -445,7 +455,7 @@ TEST_F(TestFileTable, WriteFileInvalidFileHandle)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_INVALID_FILE_HANDLE);
     // Clear the file table contents.
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, WriteFileInvalidOffset)
@@ -472,7 +482,7 @@ TEST_F(TestFileTable, WriteFileInvalidOffset)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(TestFileTable::fileTableConfig.c_str());
+    auto table = buildFileTable(TestFileTable::fileTableConfig.c_str());
 
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
@@ -481,7 +491,7 @@ TEST_F(TestFileTable, WriteFileInvalidOffset)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_DATA_OUT_OF_RANGE);
     // Clear the file table contents.
-    table.clear();
+    clearFileTable();
 }
 
 TEST(FileTable, ConfigNotExist)
@@ -527,7 +537,7 @@ TEST_F(TestFileTable, ValidateFileTable)
 TEST_F(TestFileTable, GetFileTableCommand)
 {
     // Initialise the file table with a valid handle of 0 & 1
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     uint32_t transferHandle = 0;
     uint8_t opFlag = 0;
@@ -562,7 +572,7 @@ TEST_F(TestFileTable, GetFileTableCommand)
     offsetSize += sizeof(transferFlag);
     ASSERT_EQ(0, memcmp(responsePtr->payload + offsetSize, attrTable.data(),
                         attrTable.size()));
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, GetFileTableCommandReqLengthMismatch)
@@ -629,7 +639,7 @@ TEST_F(TestFileTable, ReadFileBadPath)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     // Invalid payload length
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
@@ -653,7 +663,7 @@ TEST_F(TestFileTable, ReadFileBadPath)
     responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_INVALID_FILE_HANDLE);
 
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, ReadFileGoodPath)
@@ -677,7 +687,7 @@ TEST_F(TestFileTable, ReadFileGoodPath)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
     FileEntry value{};
     value = table.at(fileHandle);
 
@@ -713,7 +723,7 @@ TEST_F(TestFileTable, ReadFileGoodPath)
     ASSERT_EQ(0, memcmp(response->file_data, buffer.data(),
                         (fileSize - request->offset)));
 
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, WriteFileBadPath)
@@ -733,7 +743,7 @@ TEST_F(TestFileTable, WriteFileBadPath)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
 
     request->file_handle = fileHandle;
     request->offset = offset;
@@ -761,7 +771,7 @@ TEST_F(TestFileTable, WriteFileBadPath)
     responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     ASSERT_EQ(responsePtr->payload[0], PLDM_INVALID_FILE_HANDLE);
 
-    table.clear();
+    clearFileTable();
 }
 
 TEST_F(TestFileTable, WriteFileGoodPath)
@@ -782,7 +792,7 @@ TEST_F(TestFileTable, WriteFileGoodPath)
 
     using namespace pldm::filetable;
     // Initialise the file table with 2 valid file handles 0 & 1.
-    auto& table = buildFileTable(fileTableConfig.c_str());
+    auto table = buildFileTable(fileTableConfig.c_str());
     FileEntry value{};
     value = table.at(fileHandle);
 
@@ -807,7 +817,7 @@ TEST_F(TestFileTable, WriteFileGoodPath)
     ASSERT_EQ(response->length, length);
     ASSERT_EQ(0, memcmp(fileData.data(), buffer.data(), length));
 
-    table.clear();
+    clearFileTable();
 }
 
 TEST(writeFileByTypeFromMemory, testBadPath)
@@ -900,6 +910,163 @@ TEST(getHandlerByType, allPaths)
     ASSERT_THROW(getHandlerByType(0xFFFF, fileHandle), InternalFailure);
 }
 
+TEST(FileHandlerRegistry, handlerKeptForTransfer)
+{
+    FileHandlerRegistry registry{};
+    uint32_t fileHandle = 0x10;
+
+    auto& handler = registry.get(PLDM_FILE_TYPE_PEL, fileHandle);
+    ASSERT_TRUE(dynamic_cast<PelHandler*>(&handler) != nullptr);
+    EXPECT_EQ(&handler, &registry.get(PLDM_FILE_TYPE_PEL, fileHandle));
+
+    auto& other = registry.get(PLDM_FILE_TYPE_PEL, fileHandle + 1);
+    EXPECT_NE(&handler, &other);
+    auto& dump = registry.get(PLDM_FILE_TYPE_DUMP, fileHandle);
+    ASSERT_TRUE(dynamic_cast<DumpHandler*>(&dump) != nullptr);
+
+    using namespace sdbusplus::xyz::openbmc_project::Common::Error;
+    ASSERT_THROW(registry.get(0xFFFF, fileHandle), InternalFailure);
+
+    registry.release(PLDM_FILE_TYPE_DUMP, fileHandle);
+    auto& restarted = registry.get(PLDM_FILE_TYPE_DUMP, fileHandle);
+    ASSERT_TRUE(dynamic_cast<DumpHandler*>(&restarted) != nullptr);
+}
+
+TEST(FileHandlerRegistry, markerLidKeptUntilWritten)
+{
+    FileHandlerRegistry registry{};
+    uint32_t fileHandle = 0x10;
+    auto marker = &registry.get(PLDM_FILE_TYPE_LID_MARKER, fileHandle);
+    ASSERT_EQ(marker->newFileAvailable(4096), PLDM_SUCCESS);
+    EXPECT_TRUE(marker->transferInProgress());
+
+    // Enough other transfers to evict every handler not in progress
+    for (uint32_t handle = 0; handle < FileSessionCache<int>::maxEntries;
+         handle++)
+    {
+        registry.get(PLDM_FILE_TYPE_PEL, handle);
+    }
+    EXPECT_EQ(marker, &registry.get(PLDM_FILE_TYPE_LID_MARKER, fileHandle));
+
+    // A marker LID written without NewFileAvailable fails
+    registry.release(PLDM_FILE_TYPE_LID_MARKER, fileHandle);
+    auto& recreated = registry.get(PLDM_FILE_TYPE_LID_MARKER, fileHandle);
+    EXPECT_FALSE(recreated.transferInProgress());
+    std::array<char, 16> data{};
+    uint32_t length = data.size();
+    EXPECT_EQ(recreated.write(data.data(), 0, length, nullptr), PLDM_ERROR);
+}
+
+TEST(PCIeTopology, parseTopologyAndCables)
+{
+    // one link with two slots sharing the common part of their location code
+    const std::string hostBridge = "U78DA.ND0.1234567-P0";
+    const std::string port = "U78DA.ND0.1234567-P0-C1";
+    const std::string slotCommon = "U78DA.ND0.1234567-P1-C";
+    constexpr size_t linkEntrySize =
+        offsetof(pcieLinkEntry, pciLinkEntryLocCode);
+    size_t slotsOffset = linkEntrySize + hostBridge.size() + port.size();
+    size_t entryLength = slotsOffset + 2 + slotCommon.size() + 2 * 2;
+
+    std::vector<uint8_t> topologyFile(8 + entryLength);
+    auto header = reinterpret_cast<topologyBlob*>(topologyFile.data());
+    header->numPcieLinkEntries = htobe16(1);
+    auto entry = reinterpret_cast<pcieLinkEntry*>(topologyFile.data() + 8);
+    entry->entryLength = htobe16(entryLength);
+    entry->linkId = htobe16(0x10);
+    entry->parentLinkId = htobe16(0x01);
+    entry->linkType = linkTypeData::Primary;
+    entry->linkSpeed = 0x03;
+    entry->linkWidth = 0x10;
+    entry->pcieHostBridgeLocCodeSize = hostBridge.size();
+    entry->pcieHostBridgeLocCodeOff = htobe16(linkEntrySize);
+    entry->topLocalPortLocCodeSize = port.size();
+    entry->topRemotePortLocCodeSize = port.size();
+    entry->topLocalPortLocCodeOff =
+        htobe16(linkEntrySize + hostBridge.size());
+    entry->topRemotePortLocCodeOff = entry->topLocalPortLocCodeOff;
+    entry->slotLocCodesOffset = htobe16(slotsOffset);
+    auto entryData = reinterpret_cast<char*>(entry);
+    std::memcpy(entryData + linkEntrySize, hostBridge.data(),
+                hostBridge.size());
+    std::memcpy(entryData + linkEntrySize + hostBridge.size(), port.data(),
+                port.size());
+    auto slots = entryData + slotsOffset;
+    slots[0] = 2;
+    slots[1] = slotCommon.size();
+    std::memcpy(slots + 2, slotCommon.data(), slotCommon.size());
+    std::memcpy(slots + 2 + slotCommon.size(), "\x01"
+                                               "1"
+                                               "\x01"
+                                               "2",
+                4);
+
+    PCIeTopology topology{};
+    auto data = std::span<const uint8_t>(topologyFile);
+    ASSERT_TRUE(parseTopology(data, topology));
+    ASSERT_EQ(topology.links.size(), 1);
+    EXPECT_EQ(topology.links.linkId[0], 0x10);
+    EXPECT_EQ(topology.links.parentLinkId[0], 0x01);
+    EXPECT_EQ(topology.links.linkType[0], linkTypeData::Primary);
+    const auto& codes = topology.locationCodes;
+    EXPECT_EQ(codes.get(topology.links.hostBridgeLoc[0]), hostBridge);
+    EXPECT_EQ(topology.links.localPortTopLoc[0],
+              topology.links.remotePortTopLoc[0]);
+    EXPECT_EQ(codes.get(topology.links.localPortTopLoc[0]), port);
+    EXPECT_EQ(codes.get(topology.links.localPortBottomLoc[0]), "");
+    auto linkSlots = topology.links.slots(0);
+    ASSERT_EQ(linkSlots.size(), 2);
+    EXPECT_EQ(codes.get(linkSlots[0]), slotCommon + "1");
+    EXPECT_EQ(codes.get(linkSlots[1]), slotCommon + "2");
+
+    // a truncated file is rejected
+    PCIeTopology truncated{};
+    EXPECT_FALSE(parseTopology(data.first(data.size() - 1), truncated));
+
+    // one cable between the port of the link and an I/O enclosure
+    const std::string ioPort = "U78DA.ND1.7654321-P0-C1-T1";
+    const std::string partNumber = "78P6567";
+    constexpr size_t cableEntrySize =
+        offsetof(pcieLinkCableAttr, cableAttrLocCode);
+    constexpr size_t firstCable = sizeof(cableAttributesList) - 1;
+    size_t cableLength =
+        cableEntrySize + port.size() + ioPort.size() + partNumber.size();
+    std::vector<uint8_t> cableFile(firstCable + cableLength);
+    auto cableList = reinterpret_cast<cableAttributesList*>(cableFile.data());
+    cableList->numOfCables = htobe16(1);
+    pcieLinkCableAttr cable{};
+    cable.entryLength = htobe16(cableLength);
+    cable.linkId = htobe16(0x10);
+    cable.cableType = 0x01;
+    cable.hostPortLocationCodeSize = port.size();
+    cable.hostPortLocationCodeOffset = htobe16(cableEntrySize);
+    cable.ioEnclosurePortLocationCodeSize = ioPort.size();
+    cable.ioEnclosurePortLocationCodeOffset =
+        htobe16(cableEntrySize + port.size());
+    cable.cablePartNumberSize = partNumber.size();
+    cable.cablePartNumberOffset =
+        htobe16(cableEntrySize + port.size() + ioPort.size());
+    auto cableData = cableFile.data() + firstCable;
+    std::memcpy(cableData, &cable, cableEntrySize);
+    std::memcpy(cableData + cableEntrySize, port.data(), port.size());
+    std::memcpy(cableData + cableEntrySize + port.size(), ioPort.data(),
+                ioPort.size());
+    std::memcpy(cableData + cableEntrySize + port.size() + ioPort.size(),
+                partNumber.data(), partNumber.size());
+
+    auto numCodes = codes.size();
+    ASSERT_TRUE(parseCableInfo(cableFile, topology));
+    ASSERT_EQ(topology.cables.size(), 1);
+    EXPECT_EQ(topology.cables.linkId[0], 0x10);
+    EXPECT_EQ(topology.cables.hostPortLoc[0],
+              topology.links.localPortTopLoc[0]);
+    EXPECT_EQ(codes.get(topology.cables.ioEnclosurePortLoc[0]), ioPort);
+    EXPECT_EQ(codes.get(topology.cables.partNumber[0]), partNumber);
+    EXPECT_EQ(topology.cables.cableType[0], 0x01);
+    // the port of the link is interned once
+    EXPECT_EQ(codes.size(), numCodes + 2);
+}
+
 TEST(readFileByTypeIntoMemory, testBadPath)
 {
     uint8_t host_eid = 0;
@@ -998,3 +1165,123 @@ TEST(readFileByType, testReadFile)
     ASSERT_EQ(response.size(), in.size());
     ASSERT_EQ(std::equal(in.begin(), in.end(), response.begin()), true);
 }
+
+TEST(DumpOffloadChannel, bufferedUntilConsumerReads)
+{
+    char tmpdir[] = "/tmp/pldm_dump_offload.XXXXXX";
+    auto dir = fs::path(mkdtemp(tmpdir));
+    auto socketPath = (dir / "offload").string();
+
+    auto event = sdeventplus::Event::get_default();
+    DumpOffloadChannel channel(event);
+    ASSERT_TRUE(channel.listen(socketPath));
+
+    // The dump is buffered until the consumer connects
+    std::vector<char> data(1024 * 1024);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<char>(i * 31);
+    }
+    ASSERT_TRUE(channel.ready(data.size()));
+    ASSERT_TRUE(channel.write(data.data(), data.size()));
+    EXPECT_FALSE(channel.ready(DumpOffloadChannel::maxBufferedBytes));
+
+    int consumer = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    ASSERT_GE(consumer, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(connect(consumer, reinterpret_cast<sockaddr*>(&addr),
+                      sizeof(addr)),
+              0);
+    channel.finish();
+    EXPECT_TRUE(channel.busy());
+
+    std::vector<char> received{};
+    std::array<char, 64 * 1024> buf{};
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.size() < data.size() &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        sd_event_run(event.get(), 10000);
+        ssize_t n = 0;
+        while ((n = read(consumer, buf.data(), buf.size())) > 0)
+        {
+            received.insert(received.end(), buf.begin(), buf.begin() + n);
+        }
+    }
+    EXPECT_EQ(received, data);
+    EXPECT_FALSE(channel.busy());
+    EXPECT_FALSE(channel.hasFailed());
+
+    close(consumer);
+    fs::remove_all(dir);
+}
+
+TEST(DumpOffloadChannel, consumerConnectTimeout)
+{
+    char tmpdir[] = "/tmp/pldm_dump_offload.XXXXXX";
+    auto dir = fs::path(mkdtemp(tmpdir));
+    auto socketPath = (dir / "offload").string();
+
+    auto event = sdeventplus::Event::get_default();
+    DumpOffloadChannel channel(event, std::chrono::milliseconds(50));
+    ASSERT_TRUE(channel.listen(socketPath));
+    ASSERT_TRUE(channel.ready(1024));
+
+    // The channel fails from the event loop, without any host request
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!channel.hasFailed() && std::chrono::steady_clock::now() < deadline)
+    {
+        sd_event_run(event.get(), 10000);
+    }
+    EXPECT_TRUE(channel.hasFailed());
+    EXPECT_FALSE(channel.ready(1024));
+
+    fs::remove_all(dir);
+}
+
+TEST(FileSessionCache, findInsertErase)
+{
+    FileSessionCache<std::string> cache{};
+    EXPECT_EQ(cache.find(1), nullptr);
+
+    cache.insert(1, "/xyz/openbmc_project/dump/system/entry/1");
+    auto cached = cache.find(1);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(*cached, "/xyz/openbmc_project/dump/system/entry/1");
+
+    cache.erase(1);
+    EXPECT_EQ(cache.find(1), nullptr);
+}
+
+TEST(FileSessionCache, evictLeastRecentlyUsed)
+{
+    FileSessionCache<int> cache{};
+    for (uint64_t key = 0; key < FileSessionCache<int>::maxEntries; key++)
+    {
+        cache.insert(key, static_cast<int>(key));
+    }
+    // Use the first transfer, the second one is now the oldest
+    ASSERT_NE(cache.find(0), nullptr);
+
+    cache.insert(FileSessionCache<int>::maxEntries, 0);
+    EXPECT_NE(cache.find(0), nullptr);
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_NE(cache.find(FileSessionCache<int>::maxEntries), nullptr);
+}
+
+TEST(FileSessionCache, evictPinnedLast)
+{
+    FileSessionCache<int> cache{[](const int& value) { return value < 0; }};
+    // The oldest transfer is still in progress
+    cache.insert(0, -1);
+    for (uint64_t key = 1; key < FileSessionCache<int>::maxEntries; key++)
+    {
+        cache.insert(key, static_cast<int>(key));
+    }
+
+    cache.insert(FileSessionCache<int>::maxEntries, 0);
+    EXPECT_NE(cache.find(0), nullptr);
+    EXPECT_EQ(cache.find(1), nullptr);
+}
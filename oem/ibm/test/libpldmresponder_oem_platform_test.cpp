@@ -15,6 +15,8 @@
 #include <libpldm/entity.h>
 #include <libpldm/oem/ibm/entity.h>
 #include <libpldm/pdr.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
@@ -22,6 +24,8 @@
 
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
 
 using namespace pldm::utils;
 using namespace pldm::responder;
@@ -223,6 +227,70 @@ TEST(clearDirPath, testClearDirPath)
     ASSERT_EQ(stat(dirPath, &buffer), 0);
 }
 
+class CopyRangeTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char dirName[] = "/tmp/copyRange.XXXXXX";
+        dir = fs::path(mkdtemp(dirName));
+
+        data.resize(200 * 1024);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<char>(i * 7);
+        }
+        std::ofstream(dir / "in", std::ios::binary)
+            .write(data.data(), data.size());
+
+        inFd = open((dir / "in").c_str(), O_RDONLY);
+        outFd = open((dir / "out").c_str(), O_RDWR | O_CREAT, 0600);
+        ASSERT_NE(inFd, -1);
+        ASSERT_NE(outFd, -1);
+    }
+
+    void TearDown() override
+    {
+        close(inFd);
+        close(outFd);
+        fs::remove_all(dir);
+    }
+
+    std::string output() const
+    {
+        std::ifstream file(dir / "out", std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), {}};
+    }
+
+    fs::path dir;
+    std::string data;
+    int inFd = -1;
+    int outFd = -1;
+};
+
+TEST_F(CopyRangeTest, copyFileRange)
+{
+    // Strip a 100 byte header, in two chunks like the LID assembly does
+    ASSERT_TRUE(copyRange(inFd, 100, outFd, 0, 1000));
+    ASSERT_TRUE(copyRange(inFd, 1100, outFd, 1000, data.size() - 1100));
+    EXPECT_EQ(output(), data.substr(100));
+
+    // A range past the end of the source is not copied
+    EXPECT_FALSE(copyRange(inFd, data.size(), outFd, 0, 1));
+}
+
+TEST_F(CopyRangeTest, bufferedFallback)
+{
+    // More than the 64 KiB buffer, at unaligned offsets
+    ASSERT_TRUE(copyRangeBuffered(inFd, 100, outFd, 0, 1000));
+    ASSERT_TRUE(
+        copyRangeBuffered(inFd, 1100, outFd, 1000, data.size() - 1100));
+    EXPECT_EQ(output(), data.substr(100));
+
+    EXPECT_FALSE(copyRangeBuffered(inFd, data.size(), outFd, 0, 1));
+    EXPECT_FALSE(copyRangeBuffered(-1, 0, outFd, 0, 1));
+}
+
 TEST(generateStateEffecterOEMPDR, testGoodRequest)
 {
     const AssociatedEntityMap associateMap = {};
@@ -0,0 +1,191 @@
+#include "capability_cache.hpp"
+
+#include "libpldm/base.h"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+namespace
+{
+
+/** @brief Version of the cache entry layout
+ *
+ *  An entry is the version byte, the PLDM base version of the endpoint, the
+ *  64 bit mask of the supported types and then the command bit mask of each
+ *  supported type, in type order.
+ */
+constexpr uint8_t entryVersion = 2;
+
+constexpr size_t cmdBytesPerType = PLDM_MAX_CMDS_PER_TYPE / 8;
+
+constexpr size_t typesOffset = sizeof(entryVersion) + sizeof(ver32_t);
+
+constexpr size_t headerSize = typesOffset + sizeof(uint64_t);
+
+} // namespace
+
+std::optional<std::filesystem::path>
+    CapabilityCache::entryPath(const UUID& uuid) const
+{
+    if (uuid.empty() || !std::ranges::all_of(uuid, [](char c) {
+            return std::isxdigit(static_cast<unsigned char>(c)) || c == '-';
+        }))
+    {
+        return std::nullopt;
+    }
+    return cacheDir / uuid;
+}
+
+std::optional<Capabilities> CapabilityCache::get(const UUID& uuid,
+                                                 const ver32_t& version) const
+{
+    auto path = entryPath(uuid);
+    if (!path)
+    {
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    auto lastWriteTime = std::filesystem::last_write_time(*path, ec);
+    if (ec ||
+        std::filesystem::file_time_type::clock::now() - lastWriteTime > maxAge)
+    {
+        return std::nullopt;
+    }
+
+    std::ifstream stream(*path, std::ios::in | std::ios::binary);
+    if (!stream)
+    {
+        return std::nullopt;
+    }
+    std::vector<uint8_t> entry{std::istreambuf_iterator<char>(stream),
+                               std::istreambuf_iterator<char>()};
+
+    if (entry.size() < headerSize || entry[0] != entryVersion)
+    {
+        lg2::error("Ignoring corrupted capability cache entry {PATH}", "PATH",
+                   path->string());
+        return std::nullopt;
+    }
+
+    if (std::memcmp(entry.data() + sizeof(entryVersion), &version,
+                    sizeof(version)))
+    {
+        lg2::info("Capability cache entry {PATH} is of another PLDM version",
+                  "PATH", path->string());
+        return std::nullopt;
+    }
+
+    Capabilities capabilities{};
+    std::memcpy(&capabilities.supportedTypes, entry.data() + typesOffset,
+                sizeof(capabilities.supportedTypes));
+    auto numTypes = std::popcount(capabilities.supportedTypes);
+    if (entry.size() != headerSize + numTypes * cmdBytesPerType)
+    {
+        lg2::error("Ignoring corrupted capability cache entry {PATH}", "PATH",
+                   path->string());
+        return std::nullopt;
+    }
+
+    capabilities.supportedCmds.resize(PLDM_MAX_TYPES * cmdBytesPerType);
+    auto cmds = entry.begin() + headerSize;
+    for (uint8_t type = 0; type < PLDM_MAX_TYPES; type++)
+    {
+        if (!(capabilities.supportedTypes & (1ULL << type)))
+        {
+            continue;
+        }
+        std::copy_n(cmds, cmdBytesPerType,
+                    capabilities.supportedCmds.begin() +
+                        type * cmdBytesPerType);
+        cmds += cmdBytesPerType;
+    }
+
+    return capabilities;
+}
+
+bool CapabilityCache::store(const UUID& uuid, const ver32_t& version,
+                            const Capabilities& capabilities) const
+{
+    auto path = entryPath(uuid);
+    if (!path ||
+        capabilities.supportedCmds.size() != PLDM_MAX_TYPES * cmdBytesPerType)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> entry(headerSize);
+    entry[0] = entryVersion;
+    std::memcpy(entry.data() + sizeof(entryVersion), &version,
+                sizeof(version));
+    std::memcpy(entry.data() + typesOffset, &capabilities.supportedTypes,
+                sizeof(capabilities.supportedTypes));
+    for (uint8_t type = 0; type < PLDM_MAX_TYPES; type++)
+    {
+        if (!(capabilities.supportedTypes & (1ULL << type)))
+        {
+            continue;
+        }
+        auto cmds = capabilities.supportedCmds.begin() + type * cmdBytesPerType;
+        entry.insert(entry.end(), cmds, cmds + cmdBytesPerType);
+    }
+
+    /* Write a temporary file and rename it, readers never see a partial
+     * entry
+     */
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    auto tmpPath = *path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::out | std::ios::binary |
+                                          std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(entry.data()),
+                     entry.size());
+        if (!stream)
+        {
+            lg2::error("Failed to write capability cache entry {PATH}",
+                       "PATH", tmpPath.string());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, *path, ec);
+    if (ec)
+    {
+        lg2::error("Failed to store capability cache entry {PATH}, {ERROR}",
+                   "PATH", path->string(), "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+void CapabilityCache::invalidate(const UUID& uuid) const
+{
+    auto path = entryPath(uuid);
+    if (!path)
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(*path, ec);
+}
+
+} // namespace platform_mc
+} // namespace pldm
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <libpldm/base.h>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct Capabilities
+ *
+ *  The PLDM types and commands supported by a terminus, as reported by
+ *  GetPLDMTypes and GetPLDMCommands
+ */
+struct Capabilities
+{
+    /** @brief Bit mask of the supported PLDM types */
+    uint64_t supportedTypes = 0;
+
+    /** @brief Bit mask of the supported PLDM commands, in the layout of
+     *         Terminus::setSupportedCommands()
+     */
+    std::vector<uint8_t> supportedCmds{};
+};
+
+/**
+ * @brief CapabilityCache
+ *
+ * Persists the capabilities of the termini keyed by their endpoint UUID and
+ * the PLDM base version they report, so that a device coming back after a
+ * reset is initialized without the GetPLDMTypes/GetPLDMCommands handshake.
+ * Entries older than the maximum age are ignored, which bounds how long a
+ * firmware update that keeps the version can go unnoticed. Endpoints without
+ * a UUID are not cached.
+ */
+class CapabilityCache
+{
+  public:
+    /** @brief Maximum age of an entry by default */
+    static constexpr std::chrono::hours defaultMaxAge{24};
+
+    /** @brief Constructor
+     *
+     *  @param[in] cacheDir - directory of the cache entries, created on the
+     *                        first store
+     *  @param[in] maxAge - maximum age of an entry
+     */
+    explicit CapabilityCache(std::filesystem::path cacheDir,
+                             std::chrono::seconds maxAge = defaultMaxAge) :
+        cacheDir(std::move(cacheDir)), maxAge(maxAge)
+    {}
+
+    /** @brief Check whether the capabilities of an endpoint can be cached
+     *
+     *  @param[in] uuid - endpoint UUID
+     *  @return true if the UUID can key a cache entry
+     */
+    bool isCacheable(const UUID& uuid) const
+    {
+        return entryPath(uuid).has_value();
+    }
+
+    /** @brief Look up the capabilities of an endpoint
+     *
+     *  @param[in] uuid - endpoint UUID
+     *  @param[in] version - PLDM base version reported by the endpoint
+     *  @return the cached capabilities, std::nullopt if not cached, cached
+     *          for another version, expired or the entry is corrupted
+     */
+    std::optional<Capabilities> get(const UUID& uuid,
+                                    const ver32_t& version) const;
+
+    /** @brief Cache the capabilities of an endpoint
+     *
+     *  @param[in] uuid - endpoint UUID
+     *  @param[in] version - PLDM base version reported by the endpoint
+     *  @param[in] capabilities - capabilities of the endpoint
+     *  @return true if the entry was written
+     */
+    bool store(const UUID& uuid, const ver32_t& version,
+               const Capabilities& capabilities) const;
+
+    /** @brief Drop the cached capabilities of an endpoint
+     *
+     *  @param[in] uuid - endpoint UUID
+     */
+    void invalidate(const UUID& uuid) const;
+
+  private:
+    /** @brief Path of the cache entry of an endpoint
+     *
+     *  @param[in] uuid - endpoint UUID
+     *  @return the entry path, std::nullopt if the UUID can't be cached
+     */
+    std::optional<std::filesystem::path> entryPath(const UUID& uuid) const;
+
+    /** @brief Directory of the cache entries */
+    std::filesystem::path cacheDir;
+
+    /** @brief Maximum age of an entry */
+    std::chrono::seconds maxAge;
+};
+
+} // namespace platform_mc
+} // namespace pldm
@@ -32,31 +32,31 @@ NumericSensor::NumericSensor(
     switch (pdr->base_unit)
     {
         case PLDM_SENSOR_UNIT_DEGRESS_C:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/temperature/";
+            sensorNameSpace = temperatureNameSpace;
             sensorUnit = SensorUnit::DegreesC;
             break;
         case PLDM_SENSOR_UNIT_VOLTS:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/voltage/";
+            sensorNameSpace = voltageNameSpace;
             sensorUnit = SensorUnit::Volts;
             break;
         case PLDM_SENSOR_UNIT_AMPS:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/current/";
+            sensorNameSpace = currentNameSpace;
             sensorUnit = SensorUnit::Amperes;
             break;
         case PLDM_SENSOR_UNIT_RPM:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/fan_pwm/";
+            sensorNameSpace = fanPwmNameSpace;
             sensorUnit = SensorUnit::RPMS;
             break;
         case PLDM_SENSOR_UNIT_WATTS:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/power/";
+            sensorNameSpace = powerNameSpace;
             sensorUnit = SensorUnit::Watts;
             break;
         case PLDM_SENSOR_UNIT_JOULES:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/energy/";
+            sensorNameSpace = energyNameSpace;
             sensorUnit = SensorUnit::Joules;
             break;
         case PLDM_SENSOR_UNIT_PERCENTAGE:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/utilization/";
+            sensorNameSpace = utilizationNameSpace;
             sensorUnit = SensorUnit::Percent;
             break;
         default:
@@ -67,39 +67,14 @@ NumericSensor::NumericSensor(
             break;
     }
 
-    path = sensorNameSpace + sensorName;
-    try
-    {
-        auto service = pldm::utils::DBusHandler().getService(
-            path.c_str(), "xyz.openbmc_project.Sensor.Value");
-        if (!service.empty())
-        {
-            throw sdbusplus::xyz::openbmc_project::Common::Error::
-                TooManyResources();
-        }
-    }
-    catch (const std::exception&)
-    {
-        /* The sensor object path is not created */
-    }
-
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    try
+    path = std::string(sensorNameSpace) + sensorName;
+    if (!pathClaim.claim(path))
     {
-        associationDefinitionsIntf =
-            std::make_unique<AssociationDefinitionsInft>(bus, path.c_str());
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to create association interface for numeric sensor {PATH} error - {ERROR}",
-            "PATH", path, "ERROR", e);
-        throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
+        lg2::error("Sensor {PATH} already exists.", "PATH", path);
+        throw sdbusplus::xyz::openbmc_project::Common::Error::
+            TooManyResources();
     }
 
-    associationDefinitionsIntf->associations(
-        {{"chassis", "all_sensors", associationPath}});
-
     double maxValue = std::numeric_limits<double>::quiet_NaN();
     double minValue = std::numeric_limits<double>::quiet_NaN();
 
@@ -275,49 +250,27 @@ NumericSensor::NumericSensor(
         updateTime = pdr->update_interval * 1000000;
     }
 
+    auto& bus = pldm::utils::DBusHandler::getBus();
     try
     {
-        valueIntf = std::make_unique<ValueIntf>(bus, path.c_str());
+        sensorIntf = std::make_unique<SensorIntf>(
+            bus, path.c_str(), SensorIntf::action::defer_emit);
     }
     catch (const sdbusplus::exception_t& e)
     {
         lg2::error(
-            "Failed to create Value interface for numeric sensor {PATH} error - {ERROR}",
+            "Failed to create D-Bus object for numeric sensor {PATH} error - {ERROR}",
             "PATH", path, "ERROR", e);
         throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
     }
-    valueIntf->maxValue(unitModifier(conversionFormula(maxValue)));
-    valueIntf->minValue(unitModifier(conversionFormula(minValue)));
+    sensorIntf->maxValue(unitModifier(conversionFormula(maxValue)), true);
+    sensorIntf->minValue(unitModifier(conversionFormula(minValue)), true);
     hysteresis = unitModifier(conversionFormula(hysteresis));
-    valueIntf->unit(sensorUnit);
-
-    try
-    {
-        availabilityIntf =
-            std::make_unique<AvailabilityIntf>(bus, path.c_str());
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to create Availability interface for numeric sensor {PATH} error - {ERROR}",
-            "PATH", path, "ERROR", e);
-        throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
-    }
-    availabilityIntf->available(true);
-
-    try
-    {
-        operationalStatusIntf =
-            std::make_unique<OperationalStatusIntf>(bus, path.c_str());
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to create Operation status interface for numeric sensor {PATH} error - {ERROR}",
-            "PATH", path, "ERROR", e);
-        throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
-    }
-    operationalStatusIntf->functional(!sensorDisabled);
+    sensorIntf->unit(sensorUnit, true);
+    sensorIntf->available(true, true);
+    sensorIntf->functional(!sensorDisabled, true);
+    sensorIntf->associations({{"chassis", "all_sensors", associationPath}},
+                             true);
 
     if (hasWarningThresholds)
     {
@@ -356,6 +309,8 @@ NumericSensor::NumericSensor(
         thresholdCriticalIntf->criticalHigh(unitModifier(criticalHigh));
         thresholdCriticalIntf->criticalLow(unitModifier(criticalLow));
     }
+
+    sensorIntf->emit_object_added();
 }
 
 NumericSensor::NumericSensor(
@@ -376,31 +331,31 @@ NumericSensor::NumericSensor(
     switch (pdr->base_unit)
     {
         case PLDM_SENSOR_UNIT_DEGRESS_C:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/temperature/";
+            sensorNameSpace = temperatureNameSpace;
             sensorUnit = SensorUnit::DegreesC;
             break;
         case PLDM_SENSOR_UNIT_VOLTS:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/voltage/";
+            sensorNameSpace = voltageNameSpace;
             sensorUnit = SensorUnit::Volts;
             break;
         case PLDM_SENSOR_UNIT_AMPS:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/current/";
+            sensorNameSpace = currentNameSpace;
             sensorUnit = SensorUnit::Amperes;
             break;
         case PLDM_SENSOR_UNIT_RPM:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/fan_pwm/";
+            sensorNameSpace = fanPwmNameSpace;
             sensorUnit = SensorUnit::RPMS;
             break;
         case PLDM_SENSOR_UNIT_WATTS:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/power/";
+            sensorNameSpace = powerNameSpace;
             sensorUnit = SensorUnit::Watts;
             break;
         case PLDM_SENSOR_UNIT_JOULES:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/energy/";
+            sensorNameSpace = energyNameSpace;
             sensorUnit = SensorUnit::Joules;
             break;
         case PLDM_SENSOR_UNIT_PERCENTAGE:
-            sensorNameSpace = "/xyz/openbmc_project/sensors/utilization/";
+            sensorNameSpace = utilizationNameSpace;
             sensorUnit = SensorUnit::Percent;
             break;
         default:
@@ -411,37 +366,13 @@ NumericSensor::NumericSensor(
             break;
     }
 
-    path = sensorNameSpace + sensorName;
-    try
-    {
-        auto service = pldm::utils::DBusHandler().getService(
-            path.c_str(), "xyz.openbmc_project.Sensor.Value");
-        if (!service.empty())
-        {
-            throw sdbusplus::xyz::openbmc_project::Common::Error::
-                TooManyResources();
-        }
-    }
-    catch (const std::exception&)
-    {
-        /* The sensor object path is not created */
-    }
-
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    try
+    path = std::string(sensorNameSpace) + sensorName;
+    if (!pathClaim.claim(path))
     {
-        associationDefinitionsIntf =
-            std::make_unique<AssociationDefinitionsInft>(bus, path.c_str());
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to create Association interface for compact numeric sensor {PATH} error - {ERROR}",
-            "PATH", path, "ERROR", e);
-        throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
+        lg2::error("Sensor {PATH} already exists.", "PATH", path);
+        throw sdbusplus::xyz::openbmc_project::Common::Error::
+            TooManyResources();
     }
-    associationDefinitionsIntf->associations(
-        {{"chassis", "all_sensors", associationPath.c_str()}});
 
     double maxValue = std::numeric_limits<double>::quiet_NaN();
     double minValue = std::numeric_limits<double>::quiet_NaN();
@@ -485,49 +416,27 @@ NumericSensor::NumericSensor(
      * updateTime is in microseconds
      */
     updateTime = static_cast<uint64_t>(DEFAULT_SENSOR_UPDATER_INTERVAL * 1000);
+    auto& bus = pldm::utils::DBusHandler::getBus();
     try
     {
-        valueIntf = std::make_unique<ValueIntf>(bus, path.c_str());
+        sensorIntf = std::make_unique<SensorIntf>(
+            bus, path.c_str(), SensorIntf::action::defer_emit);
     }
     catch (const sdbusplus::exception_t& e)
     {
         lg2::error(
-            "Failed to create Value interface for compact numeric sensor {PATH} error - {ERROR}",
+            "Failed to create D-Bus object for compact numeric sensor {PATH} error - {ERROR}",
             "PATH", path, "ERROR", e);
         throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
     }
-    valueIntf->maxValue(unitModifier(conversionFormula(maxValue)));
-    valueIntf->minValue(unitModifier(conversionFormula(minValue)));
+    sensorIntf->maxValue(unitModifier(conversionFormula(maxValue)), true);
+    sensorIntf->minValue(unitModifier(conversionFormula(minValue)), true);
     hysteresis = unitModifier(conversionFormula(hysteresis));
-    valueIntf->unit(sensorUnit);
-
-    try
-    {
-        availabilityIntf =
-            std::make_unique<AvailabilityIntf>(bus, path.c_str());
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to create Availability interface for compact numeric sensor {PATH} error - {ERROR}",
-            "PATH", path, "ERROR", e);
-        throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
-    }
-    availabilityIntf->available(true);
-
-    try
-    {
-        operationalStatusIntf =
-            std::make_unique<OperationalStatusIntf>(bus, path.c_str());
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        lg2::error(
-            "Failed to create Operational status interface for compact numeric sensor {PATH} error - {ERROR}",
-            "PATH", path, "ERROR", e);
-        throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
-    }
-    operationalStatusIntf->functional(!sensorDisabled);
+    sensorIntf->unit(sensorUnit, true);
+    sensorIntf->available(true, true);
+    sensorIntf->functional(!sensorDisabled, true);
+    sensorIntf->associations({{"chassis", "all_sensors", associationPath}},
+                             true);
 
     if (hasWarningThresholds)
     {
@@ -566,6 +475,8 @@ NumericSensor::NumericSensor(
         thresholdCriticalIntf->criticalHigh(unitModifier(criticalHigh));
         thresholdCriticalIntf->criticalLow(unitModifier(criticalLow));
     }
+
+    sensorIntf->emit_object_added();
 }
 
 double NumericSensor::conversionFormula(double value)
@@ -583,16 +494,16 @@ double NumericSensor::unitModifier(double value)
 
 void NumericSensor::updateReading(bool available, bool functional, double value)
 {
-    if (!availabilityIntf || !operationalStatusIntf || !valueIntf)
+    if (!sensorIntf)
     {
         lg2::error(
             "Failed to update sensor {NAME} D-Bus interface don't exist.",
             "NAME", sensorName);
         return;
     }
-    availabilityIntf->available(available);
-    operationalStatusIntf->functional(functional);
-    double curValue = valueIntf->value();
+    sensorIntf->available(available);
+    sensorIntf->functional(functional);
+    double curValue = sensorIntf->value();
     double newValue = std::numeric_limits<double>::quiet_NaN();
     if (functional && available)
     {
@@ -600,7 +511,7 @@ void NumericSensor::updateReading(bool available, bool functional, double value)
         if (newValue != curValue &&
             (!std::isnan(newValue) || !std::isnan(curValue)))
         {
-            valueIntf->value(newValue);
+            sensorIntf->value(newValue);
             updateThresholds();
         }
     }
@@ -609,22 +520,41 @@ void NumericSensor::updateReading(bool available, bool functional, double value)
         if (newValue != curValue &&
             (!std::isnan(newValue) || !std::isnan(curValue)))
         {
-            valueIntf->value(std::numeric_limits<double>::quiet_NaN());
+            sensorIntf->value(std::numeric_limits<double>::quiet_NaN());
         }
     }
 }
 
 void NumericSensor::handleErrGetSensorReading()
 {
-    if (!operationalStatusIntf || !valueIntf)
+    if (!sensorIntf)
     {
         lg2::error(
             "Failed to update sensor {NAME} D-Bus interfaces don't exist.",
             "NAME", sensorName);
         return;
     }
-    operationalStatusIntf->functional(false);
-    valueIntf->value(std::numeric_limits<double>::quiet_NaN());
+    sensorIntf->functional(false);
+    sensorIntf->value(std::numeric_limits<double>::quiet_NaN());
+}
+
+size_t NumericSensor::memoryUsage() const
+{
+    size_t size = sizeof(*this) + sensorName.capacity() +
+                  pathClaim.memoryUsage();
+    if (sensorIntf)
+    {
+        size += sizeof(SensorIntf);
+    }
+    if (thresholdWarningIntf)
+    {
+        size += sizeof(ThresholdWarningIntf);
+    }
+    if (thresholdCriticalIntf)
+    {
+        size += sizeof(ThresholdCriticalIntf);
+    }
+    return size;
 }
 
 bool NumericSensor::checkThreshold(bool alarm, bool direction, double value,
@@ -657,7 +587,7 @@ bool NumericSensor::checkThreshold(bool alarm, bool direction, double value,
 
 void NumericSensor::updateThresholds()
 {
-    if (!valueIntf)
+    if (!sensorIntf)
     {
         lg2::error(
             "Failed to update thresholds sensor {NAME} D-Bus interfaces don't exist.",
@@ -665,7 +595,7 @@ void NumericSensor::updateThresholds()
         return;
     }
 
-    auto value = valueIntf->value();
+    auto value = sensorIntf->value();
 
     if (thresholdWarningIntf &&
         !std::isnan(thresholdWarningIntf->warningHigh()))
@@ -14,6 +14,8 @@
 #include <xyz/openbmc_project/State/Decorator/OperationalStatus/server.hpp>
 
 #include <string>
+#include <string_view>
+#include <unordered_set>
 
 namespace pldm
 {
@@ -21,19 +23,98 @@ namespace platform_mc
 {
 
 using SensorUnit = sdbusplus::xyz::openbmc_project::Sensor::server::Value::Unit;
-using ValueIntf = sdbusplus::server::object_t<
-    sdbusplus::xyz::openbmc_project::Sensor::server::Value>;
+using SensorIntf = sdbusplus::server::object_t<
+    sdbusplus::xyz::openbmc_project::Sensor::server::Value,
+    sdbusplus::xyz::openbmc_project::State::Decorator::server::Availability,
+    sdbusplus::xyz::openbmc_project::State::Decorator::server::
+        OperationalStatus,
+    sdbusplus::xyz::openbmc_project::Association::server::Definitions>;
 using ThresholdWarningIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Sensor::Threshold::server::Warning>;
 using ThresholdCriticalIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Sensor::Threshold::server::Critical>;
-using OperationalStatusIntf =
-    sdbusplus::server::object_t<sdbusplus::xyz::openbmc_project::State::
-                                    Decorator::server::OperationalStatus>;
-using AvailabilityIntf = sdbusplus::server::object_t<
-    sdbusplus::xyz::openbmc_project::State::Decorator::server::Availability>;
-using AssociationDefinitionsInft = sdbusplus::server::object_t<
-    sdbusplus::xyz::openbmc_project::Association::server::Definitions>;
+
+/* @brief Object path namespaces of the sensors, shared by all the sensors of
+ *        a unit
+ */
+constexpr std::string_view temperatureNameSpace =
+    "/xyz/openbmc_project/sensors/temperature/";
+constexpr std::string_view voltageNameSpace =
+    "/xyz/openbmc_project/sensors/voltage/";
+constexpr std::string_view currentNameSpace =
+    "/xyz/openbmc_project/sensors/current/";
+constexpr std::string_view fanPwmNameSpace =
+    "/xyz/openbmc_project/sensors/fan_pwm/";
+constexpr std::string_view powerNameSpace =
+    "/xyz/openbmc_project/sensors/power/";
+constexpr std::string_view energyNameSpace =
+    "/xyz/openbmc_project/sensors/energy/";
+constexpr std::string_view utilizationNameSpace =
+    "/xyz/openbmc_project/sensors/utilization/";
+
+/**
+ * @brief SensorPathClaim
+ *
+ * Registers a sensor D-Bus object path as owned by this process for its
+ * lifetime, so that duplicate sensors are detected without an object mapper
+ * lookup per sensor.
+ */
+class SensorPathClaim
+{
+  public:
+    SensorPathClaim() = default;
+    SensorPathClaim(const SensorPathClaim&) = delete;
+    SensorPathClaim& operator=(const SensorPathClaim&) = delete;
+
+    ~SensorPathClaim()
+    {
+        if (path)
+        {
+            ownedPaths.erase(*path);
+        }
+    }
+
+    /** @brief Claim an object path
+     *
+     *  @param[in] objPath - sensor object path
+     *  @return false if the path is already owned by another sensor
+     */
+    bool claim(const std::string& objPath)
+    {
+        auto [it, inserted] = ownedPaths.emplace(objPath);
+        if (!inserted)
+        {
+            return false;
+        }
+        path = &*it;
+        return true;
+    }
+
+    /** @brief Check if an object path is owned by a sensor of this process
+     *
+     *  @param[in] objPath - sensor object path
+     *  @return true if owned
+     */
+    static bool isOwned(const std::string& objPath)
+    {
+        return ownedPaths.contains(objPath);
+    }
+
+    /** @brief Heap bytes held for the claimed path */
+    size_t memoryUsage() const
+    {
+        return path ? path->capacity() + 1 : 0;
+    }
+
+  private:
+    /** @brief The claimed path, owned by ownedPaths, null if nothing was
+     *         claimed. Set elements are stable across rehashes.
+     */
+    const std::string* path = nullptr;
+
+    /** @brief The sensor object paths owned by this process */
+    static inline std::unordered_set<std::string> ownedPaths{};
+};
 
 /**
  * @brief NumericSensor
@@ -95,9 +176,9 @@ class NumericSensor
      */
     inline void setInventoryPath(const std::string& inventoryPath)
     {
-        if (associationDefinitionsIntf)
+        if (sensorIntf)
         {
-            associationDefinitionsIntf->associations(
+            sensorIntf->associations(
                 {{"chassis", "all_sensors", inventoryPath}});
         }
     }
@@ -166,6 +247,12 @@ class NumericSensor
         }
     };
 
+    /** @brief Approximate memory held by the sensor, D-Bus objects included
+     *
+     *  @return size in bytes
+     */
+    size_t memoryUsage() const;
+
     /** @brief Terminus ID which the sensor belongs to */
     pldm_tid_t tid;
 
@@ -182,7 +269,7 @@ class NumericSensor
     std::string sensorName;
 
     /** @brief  sensorNameSpace */
-    std::string sensorNameSpace;
+    std::string_view sensorNameSpace;
 
   private:
     /**
@@ -191,13 +278,15 @@ class NumericSensor
      */
     void updateThresholds();
 
-    std::unique_ptr<ValueIntf> valueIntf = nullptr;
+    /** @brief The Value, Availability, OperationalStatus and Association
+     *         interfaces of the sensor, composed in one D-Bus object
+     */
+    std::unique_ptr<SensorIntf> sensorIntf = nullptr;
     std::unique_ptr<ThresholdWarningIntf> thresholdWarningIntf = nullptr;
     std::unique_ptr<ThresholdCriticalIntf> thresholdCriticalIntf = nullptr;
-    std::unique_ptr<AvailabilityIntf> availabilityIntf = nullptr;
-    std::unique_ptr<OperationalStatusIntf> operationalStatusIntf = nullptr;
-    std::unique_ptr<AssociationDefinitionsInft> associationDefinitionsIntf =
-        nullptr;
+
+    /** @brief Ownership of the sensor object path */
+    SensorPathClaim pathClaim;
 
     /** @brief Amount of hysteresis associated with the sensor thresholds */
     double hysteresis;
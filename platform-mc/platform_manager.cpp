@@ -35,6 +35,13 @@ exec::task<int> PlatformManager::initTerminus()
             }
 
             terminus->parseTerminusPDRs();
+
+            auto usage = terminus->getMemoryUsage();
+            lg2::info(
+                "Terminus {TID} parsed {PDRS} PDRs, {SENSORS} numeric sensors hold {SENSOR_BYTES} bytes, auxiliary names hold {NAME_BYTES} bytes",
+                "TID", tid, "PDRS", usage.parsedPdrs, "SENSORS",
+                usage.numericSensors, "SENSOR_BYTES", usage.sensorBytes,
+                "NAME_BYTES", usage.auxNameBytes);
         }
 
         auto rc = co_await configEventReceiver(tid);
@@ -280,8 +287,9 @@ exec::task<int> PlatformManager::getPDR(
 
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
-    rc = co_await terminusManager.sendRecvPldmMsg(tid, request, &responseMsg,
-                                                  &responseLen);
+    rc = co_await terminusManager.sendRecvPldmMsg(
+        tid, request, &responseMsg, &responseLen,
+        requester::RequestPriority::Bulk);
     if (rc)
     {
         lg2::error(
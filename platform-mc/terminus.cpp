@@ -115,7 +115,12 @@ void Terminus::parseTerminusPDRs()
     std::vector<std::shared_ptr<pldm_compact_numeric_sensor_pdr>>
         compactNumericSensorPdrs{};
 
-    for (auto& pdr : pdrs)
+    /* The raw PDRs are not needed once parsed */
+    std::vector<std::vector<uint8_t>> records{};
+    records.swap(pdrs);
+    parsedPdrCount = records.size();
+
+    for (auto& pdr : records)
     {
         auto pdrHdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
         switch (pdrHdr->type)
@@ -131,7 +136,9 @@ void Terminus::parseTerminusPDRs()
                         static_cast<uint32_t>(pdrHdr->record_handle));
                     continue;
                 }
-                sensorAuxiliaryNamesTbl.emplace_back(std::move(sensorAuxNames));
+                auto sensorId = std::get<0>(*sensorAuxNames);
+                sensorAuxiliaryNamesTbl.try_emplace(sensorId,
+                                                    std::move(sensorAuxNames));
                 break;
             }
             case PLDM_NUMERIC_SENSOR_PDR:
@@ -169,7 +176,9 @@ void Terminus::parseTerminusPDRs()
                     continue;
                 }
                 compactNumericSensorPdrs.emplace_back(std::move(parsedPdr));
-                sensorAuxiliaryNamesTbl.emplace_back(std::move(sensorAuxNames));
+                auto sensorId = std::get<0>(*sensorAuxNames);
+                sensorAuxiliaryNamesTbl.try_emplace(sensorId,
+                                                    std::move(sensorAuxNames));
                 break;
             }
             case PLDM_ENTITY_AUXILIARY_NAMES_PDR:
@@ -218,6 +227,8 @@ void Terminus::parseTerminusPDRs()
         lg2::error("Terminus ID {TID}: Created Inventory path.", "TID", tid);
     }
 
+    numericSensors.reserve(numericSensors.size() + numericSensorPdrs.size() +
+                           compactNumericSensorPdrs.size());
     for (auto pdr : numericSensorPdrs)
     {
         addNumericSensor(pdr);
@@ -229,21 +240,53 @@ void Terminus::parseTerminusPDRs()
     }
 }
 
+TerminusMemoryUsage Terminus::getMemoryUsage() const
+{
+    TerminusMemoryUsage usage{};
+    usage.parsedPdrs = parsedPdrCount;
+
+    usage.numericSensors = numericSensors.size();
+    usage.sensorBytes = numericSensors.capacity() *
+                        sizeof(std::shared_ptr<NumericSensor>);
+    for (const auto& sensor : numericSensors)
+    {
+        usage.sensorBytes += sensor->memoryUsage();
+    }
+
+    for (const auto& [id, sensorAuxNames] : sensorAuxiliaryNamesTbl)
+    {
+        const auto& [sensorId, sensorCnt, names] = *sensorAuxNames;
+        usage.auxNameBytes += sizeof(SensorAuxiliaryNames);
+        for (const auto& sensorNames : names)
+        {
+            for (const auto& [tag, name] : sensorNames)
+            {
+                usage.auxNameBytes += sizeof(tag) + sizeof(name) +
+                                      tag.capacity() + name.capacity();
+            }
+        }
+    }
+    for (const auto& entityAuxNames : entityAuxiliaryNamesTbl)
+    {
+        const auto& [key, names] = *entityAuxNames;
+        usage.auxNameBytes += sizeof(EntityAuxiliaryNames);
+        for (const auto& [tag, name] : names)
+        {
+            usage.auxNameBytes += sizeof(tag) + sizeof(name) + tag.capacity() +
+                                  name.capacity();
+        }
+    }
+
+    return usage;
+}
+
 std::shared_ptr<SensorAuxiliaryNames>
     Terminus::getSensorAuxiliaryNames(SensorId id)
 {
-    auto it = std::find_if(
-        sensorAuxiliaryNamesTbl.begin(), sensorAuxiliaryNamesTbl.end(),
-        [id](
-            const std::shared_ptr<SensorAuxiliaryNames>& sensorAuxiliaryNames) {
-            const auto& [sensorId, sensorCnt, sensorNames] =
-                *sensorAuxiliaryNames;
-            return sensorId == id;
-        });
-
+    auto it = sensorAuxiliaryNamesTbl.find(id);
     if (it != sensorAuxiliaryNamesTbl.end())
     {
-        return *it;
+        return it->second;
     }
     return nullptr;
 };
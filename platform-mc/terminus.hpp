@@ -15,6 +15,7 @@
 #include <bitset>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -60,6 +61,18 @@ using AuxiliaryNames = std::vector<std::pair<NameLanguageTag, std::string>>;
 using EntityKey = struct EntityKey;
 using EntityAuxiliaryNames = std::tuple<EntityKey, AuxiliaryNames>;
 
+/** @struct TerminusMemoryUsage
+ *
+ *  Approximate memory held by the sensor model of a terminus
+ */
+struct TerminusMemoryUsage
+{
+    size_t parsedPdrs = 0;     //!< Number of PDRs parsed
+    size_t numericSensors = 0; //!< Number of numeric sensors
+    size_t sensorBytes = 0;    //!< Bytes held by the numeric sensors
+    size_t auxNameBytes = 0;   //!< Bytes held by the auxiliary name tables
+};
+
 /**
  * @brief Terminus
  *
@@ -111,10 +124,17 @@ class Terminus
         return true;
     }
 
-    /** @brief Parse the PDRs stored in the member variable, pdrs.
+    /** @brief Parse the PDRs stored in the member variable, pdrs. The raw
+     *         PDRs are released once parsed.
      */
     void parseTerminusPDRs();
 
+    /** @brief Report the memory held by the sensor model of the terminus
+     *
+     *  @return memory usage of the terminus
+     */
+    TerminusMemoryUsage getMemoryUsage() const;
+
     /** @brief The getter to return terminus's TID */
     pldm_tid_t getTid()
     {
@@ -127,7 +147,9 @@ class Terminus
         return terminusName;
     }
 
-    /** @brief A list of PDRs fetched from Terminus */
+    /** @brief A list of PDRs fetched from Terminus, emptied by
+     *         parseTerminusPDRs()
+     */
     std::vector<std::vector<uint8_t>> pdrs{};
 
     /** @brief A flag to indicate if terminus has been initialized */
@@ -237,10 +259,15 @@ class Terminus
      */
     std::vector<uint8_t> supportedCmds;
 
-    /* @brief Sensor Auxiliary Name list */
-    std::vector<std::shared_ptr<SensorAuxiliaryNames>>
+    /* @brief Sensor Auxiliary Names indexed by sensor ID, the first PDR of a
+     *        sensor ID wins
+     */
+    std::unordered_map<SensorId, std::shared_ptr<SensorAuxiliaryNames>>
         sensorAuxiliaryNamesTbl{};
 
+    /* @brief Number of PDRs parsed by parseTerminusPDRs() */
+    size_t parsedPdrCount = 0;
+
     /* @brief Entity Auxiliary Name list */
     std::vector<std::shared_ptr<EntityAuxiliaryNames>>
         entityAuxiliaryNamesTbl{};
@@ -4,6 +4,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -219,6 +221,7 @@ void TerminusManager::removeMctpTerminus(const MctpInfos& mctpInfos)
             manager->stopSensorPolling(it->second->getTid());
         }
 
+        cachedCapabilityTids.erase(it->first);
         unmapTid(it->first);
         termini.erase(it);
     }
@@ -319,19 +322,43 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
             co_return PLDM_SUCCESS;
         }
     }
-    /* Discovery the mapped terminus */
-    uint64_t supportedTypes = 0;
-    rc = co_await getPLDMTypes(tid, supportedTypes);
-    if (rc)
+    /* Discovery the mapped terminus, a known endpoint reporting the same
+     * PLDM base version skips the capability handshake
+     */
+    const auto& uuid = std::get<1>(mctpInfo);
+    std::optional<ver32_t> version;
+    std::optional<Capabilities> capabilities;
+    if (capabilityCache.isCacheable(uuid))
+    {
+        version.emplace();
+        rc = co_await getPLDMVersion(tid, PLDM_BASE, *version);
+        if (rc == PLDM_SUCCESS)
+        {
+            capabilities = capabilityCache.get(uuid, *version);
+        }
+        else
+        {
+            version.reset();
+        }
+    }
+    bool cached = capabilities.has_value();
+    if (!cached)
     {
-        lg2::error("Failed to Get PLDM Types for terminus {TID}, error {ERROR}",
-                   "TID", tid, "ERROR", rc);
-        co_return PLDM_ERROR;
+        capabilities.emplace();
+        rc = co_await getPLDMTypes(tid, capabilities->supportedTypes);
+        if (rc)
+        {
+            lg2::error(
+                "Failed to Get PLDM Types for terminus {TID}, error {ERROR}",
+                "TID", tid, "ERROR", rc);
+            co_return PLDM_ERROR;
+        }
     }
 
     try
     {
-        termini[tid] = std::make_shared<Terminus>(tid, supportedTypes);
+        termini[tid] =
+            std::make_shared<Terminus>(tid, capabilities->supportedTypes);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -340,53 +367,37 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
         co_return PLDM_ERROR;
     }
 
-    uint8_t type = PLDM_BASE;
-    auto size = PLDM_MAX_TYPES * (PLDM_MAX_CMDS_PER_TYPE / 8);
-    std::vector<uint8_t> pldmCmds(size);
-    while ((type < PLDM_MAX_TYPES))
+    if (cached)
     {
-        if (!termini[tid]->doesSupportType(type))
-        {
-            type++;
-            continue;
-        }
-        std::vector<bitfield8_t> cmds(PLDM_MAX_CMDS_PER_TYPE / 8);
-        auto rc = co_await getPLDMCommands(tid, type, cmds.data());
-        if (rc)
-        {
-            lg2::error(
-                "Failed to Get PLDM Commands for terminus {TID}, error {ERROR}",
-                "TID", tid, "ERROR", rc);
-        }
-
-        for (size_t i = 0; i < cmds.size(); i++)
+        lg2::info("Terminus {TID} capabilities loaded from cache, UUID {UUID}",
+                  "TID", tid, "UUID", uuid);
+        cachedCapabilityTids.insert(tid);
+    }
+    else
+    {
+        cachedCapabilityTids.erase(tid);
+        rc = co_await getPLDMCommands(tid, capabilities->supportedTypes,
+                                      capabilities->supportedCmds);
+        /* Only cache a complete handshake */
+        if (rc == PLDM_SUCCESS && version)
         {
-            auto idx = type * (PLDM_MAX_CMDS_PER_TYPE / 8) + i;
-            if (idx >= pldmCmds.size())
-            {
-                lg2::error(
-                    "Calculated index {IDX} out of bounds for pldmCmds, type {TYPE}, command index {CMD_IDX}",
-                    "IDX", idx, "TYPE", type, "CMD_IDX", i);
-                continue;
-            }
-            pldmCmds[idx] = cmds[i].byte;
+            capabilityCache.store(uuid, *version, *capabilities);
         }
-        type++;
     }
-    termini[tid]->setSupportedCommands(pldmCmds);
+    termini[tid]->setSupportedCommands(capabilities->supportedCmds);
 
     co_return PLDM_SUCCESS;
 }
 
 exec::task<int> TerminusManager::sendRecvPldmMsgOverMctp(
     mctp_eid_t eid, Request& request, const pldm_msg** responseMsg,
-    size_t* responseLen)
+    size_t* responseLen, requester::RequestPriority priority)
 {
     int rc = 0;
     try
     {
         std::tie(rc, *responseMsg, *responseLen) =
-            co_await handler.sendRecvMsg(eid, std::move(request));
+            co_await handler.sendRecvMsg(eid, std::move(request), priority);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -424,7 +435,8 @@ exec::task<int> TerminusManager::getTidOverMctp(mctp_eid_t eid, pldm_tid_t* tid)
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
     rc = co_await sendRecvPldmMsgOverMctp(eid, request, &responseMsg,
-                                          &responseLen);
+                                          &responseLen,
+                                          requester::RequestPriority::Control);
     if (rc)
     {
         lg2::error("Failed to send GetTID for Endpoint {EID}, error {RC}",
@@ -470,7 +482,8 @@ exec::task<int> TerminusManager::setTidOverMctp(mctp_eid_t eid, pldm_tid_t tid)
     const pldm_msg* responseMsg = nullptr;
     size_t responseLen = 0;
     rc = co_await sendRecvPldmMsgOverMctp(eid, request, &responseMsg,
-                                          &responseLen);
+                                          &responseLen,
+                                          requester::RequestPriority::Control);
     if (rc)
     {
         lg2::error("Failed to send SetTID for Endpoint {EID}, error {RC}",
@@ -536,6 +549,56 @@ exec::task<int>
     co_return completionCode;
 }
 
+exec::task<int> TerminusManager::getPLDMVersion(pldm_tid_t tid, uint8_t type,
+                                                ver32_t& version)
+{
+    Request request(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto rc = encode_get_version_req(0, 0, PLDM_GET_FIRSTPART, type,
+                                     requestMsg);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to encode request GetPLDMVersion for terminus ID {TID}, error {RC} ",
+            "TID", tid, "RC", rc);
+        co_return rc;
+    }
+
+    const pldm_msg* responseMsg = nullptr;
+    size_t responseLen = 0;
+
+    rc = co_await sendRecvPldmMsg(tid, request, &responseMsg, &responseLen);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to send GetPLDMVersion for terminus {TID}, error {RC}",
+            "TID", tid, "RC", rc);
+        co_return rc;
+    }
+
+    uint8_t completionCode = 0;
+    uint32_t transferHandle = 0;
+    uint8_t transferFlag = 0;
+    rc = decode_get_version_resp(responseMsg, responseLen, &completionCode,
+                                 &transferHandle, &transferFlag, &version);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to decode response GetPLDMVersion for terminus ID {TID}, error {RC} ",
+            "TID", tid, "RC", rc);
+        co_return rc;
+    }
+
+    if (completionCode != PLDM_SUCCESS)
+    {
+        lg2::error(
+            "Error : GetPLDMVersion for terminus ID {TID}, complete code {CC}.",
+            "TID", tid, "CC", completionCode);
+    }
+
+    co_return completionCode;
+}
+
 exec::task<int> TerminusManager::getPLDMCommands(pldm_tid_t tid, uint8_t type,
                                                  bitfield8_t* supportedCmds)
 {
@@ -587,9 +650,78 @@ exec::task<int> TerminusManager::getPLDMCommands(pldm_tid_t tid, uint8_t type,
     co_return completionCode;
 }
 
+exec::task<int> TerminusManager::getPLDMCommands(
+    pldm_tid_t tid, uint64_t supportedTypes,
+    std::vector<uint8_t>& supportedCmds)
+{
+    constexpr size_t cmdBytesPerType = PLDM_MAX_CMDS_PER_TYPE / 8;
+    std::vector<bitfield8_t> cmds(PLDM_MAX_TYPES * cmdBytesPerType);
+    int result = PLDM_SUCCESS;
+
+    /* The requests of all the types are queued at once, the handler sends
+     * them as the terminus answers
+     */
+    exec::async_scope scope;
+    for (uint8_t type = PLDM_BASE; type < PLDM_MAX_TYPES; type++)
+    {
+        if (!(supportedTypes & (1ULL << type)))
+        {
+            continue;
+        }
+        scope.spawn(
+            getPLDMCommands(tid, type, cmds.data() + type * cmdBytesPerType) |
+                stdexec::then([&result, tid](int rc) {
+                    if (rc)
+                    {
+                        lg2::error(
+                            "Failed to Get PLDM Commands for terminus {TID}, error {ERROR}",
+                            "TID", tid, "ERROR", rc);
+                        result = rc;
+                    }
+                }),
+            exec::default_task_context<void>(exec::inline_scheduler{}));
+    }
+    co_await scope.on_empty();
+
+    supportedCmds.resize(cmds.size());
+    std::transform(cmds.begin(), cmds.end(), supportedCmds.begin(),
+                   [](const bitfield8_t& cmd) { return cmd.byte; });
+
+    co_return result;
+}
+
+void TerminusManager::revalidateCapabilities(
+    pldm_tid_t tid, const pldm_msg* responseMsg, size_t responseLen)
+{
+    if (!cachedCapabilityTids.contains(tid) || !responseMsg || !responseLen)
+    {
+        return;
+    }
+
+    auto completionCode = responseMsg->payload[0];
+    if (completionCode != PLDM_ERROR_UNSUPPORTED_PLDM_CMD &&
+        completionCode != PLDM_ERROR_INVALID_PLDM_TYPE)
+    {
+        return;
+    }
+
+    auto mctpInfo = toMctpInfo(tid);
+    if (!mctpInfo)
+    {
+        return;
+    }
+
+    lg2::info(
+        "Terminus {TID} rejected PLDM type {TYPE} command {CMD}, dropping its cached capabilities",
+        "TID", tid, "TYPE", responseMsg->hdr.type, "CMD",
+        responseMsg->hdr.command);
+    capabilityCache.invalidate(std::get<1>(mctpInfo.value()));
+    cachedCapabilityTids.erase(tid);
+}
+
 exec::task<int> TerminusManager::sendRecvPldmMsg(
     pldm_tid_t tid, Request& request, const pldm_msg** responseMsg,
-    size_t* responseLen)
+    size_t* responseLen, requester::RequestPriority priority)
 {
     /**
      * Size of tidPool is `std::numeric_limits<pldm_tid_t>::max() + 1`
@@ -620,7 +752,11 @@ exec::task<int> TerminusManager::sendRecvPldmMsg(
     auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
     requestMsg->hdr.instance_id = instanceIdDb.next(eid);
     auto rc = co_await sendRecvPldmMsgOverMctp(eid, request, responseMsg,
-                                               responseLen);
+                                               responseLen, priority);
+    if (rc == PLDM_SUCCESS)
+    {
+        revalidateCapabilities(tid, *responseMsg, *responseLen);
+    }
 
     co_return rc;
 }
@@ -2,18 +2,21 @@
 
 #include "config.h"
 
-#include "libpldm/platform.h"
-#include "libpldm/pldm.h"
-
+#include "capability_cache.hpp"
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "terminus.hpp"
 
+#include <libpldm/platform.h>
+#include <libpldm/pldm.h>
+
+#include <filesystem>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
 #include <queue>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -54,9 +57,12 @@ class TerminusManager
     explicit TerminusManager(
         sdeventplus::Event& /* event */, RequesterHandler& handler,
         pldm::InstanceIdDb& instanceIdDb, TerminiMapper& termini,
-        Manager* manager, mctp_eid_t localEid) :
+        Manager* manager, mctp_eid_t localEid,
+        const std::filesystem::path& capabilityCacheDir =
+            CAPABILITY_CACHE_DIR) :
         handler(handler), instanceIdDb(instanceIdDb), termini(termini),
-        tidPool(tidPoolSize, false), manager(manager), localEid(localEid)
+        tidPool(tidPoolSize, false), manager(manager), localEid(localEid),
+        capabilityCache(capabilityCacheDir)
     {
         // DSP0240 v1.1.0 table-8, special value: 0,0xFF = reserved
         tidPool[0] = true;
@@ -84,11 +90,14 @@ class TerminusManager
      *  @param[in] request - request PLDM message
      *  @param[out] responseMsg - response PLDM message
      *  @param[out] responseLen - length of response PLDM message
+     *  @param[in] priority - priority lane of the request
      *  @return coroutine return_value - PLDM completion code
      */
-    exec::task<int> sendRecvPldmMsg(pldm_tid_t tid, Request& request,
-                                    const pldm_msg** responseMsg,
-                                    size_t* responseLen);
+    exec::task<int> sendRecvPldmMsg(
+        pldm_tid_t tid, Request& request, const pldm_msg** responseMsg,
+        size_t* responseLen,
+        requester::RequestPriority priority =
+            requester::RequestPriority::Polling);
 
     /** @brief Send request PLDM message to eid. The function will
      *         return when received the response message from terminus.
@@ -97,11 +106,12 @@ class TerminusManager
      *  @param[in] request - request PLDM message
      *  @param[out] responseMsg - response PLDM message
      *  @param[out] responseLen - length of response PLDM message
+     *  @param[in] priority - priority lane of the request
      *  @return coroutine return_value - PLDM completion code
      */
     virtual exec::task<int> sendRecvPldmMsgOverMctp(
         mctp_eid_t eid, Request& request, const pldm_msg** responseMsg,
-        size_t* responseLen);
+        size_t* responseLen, requester::RequestPriority priority);
 
     /** @brief member functions to map/unmap tid
      */
@@ -201,6 +211,17 @@ class TerminusManager
      */
     exec::task<int> getPLDMTypes(pldm_tid_t tid, uint64_t& supportedTypes);
 
+    /** @brief Send getPLDMVersion command to destination TID and then return
+     *         the version of the PLDM type in reference parameter.
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] type - PLDM Type
+     *  @param[out] version - Version of the PLDM type returned from terminus
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> getPLDMVersion(pldm_tid_t tid, uint8_t type,
+                                   ver32_t& version);
+
     /** @brief Send getPLDMCommands command to destination TID and then return
      *         the value of supportedCommands in reference parameter.
      *
@@ -213,6 +234,29 @@ class TerminusManager
     exec::task<int> getPLDMCommands(pldm_tid_t tid, uint8_t type,
                                     bitfield8_t* supportedCmds);
 
+    /** @brief Send getPLDMCommands for all the supported types of the
+     *         terminus, the requests are issued concurrently.
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] supportedTypes - Supported Types of the terminus
+     *  @param[out] supportedCmds - Supported commands of all the types, in the
+     *                              layout of Terminus::setSupportedCommands()
+     *  @return coroutine return_value - PLDM_SUCCESS if all the types were
+     *          probed, otherwise the error of a failed probe
+     */
+    exec::task<int> getPLDMCommands(pldm_tid_t tid, uint64_t supportedTypes,
+                                    std::vector<uint8_t>& supportedCmds);
+
+    /** @brief Drop the cached capabilities of a terminus initialized from the
+     *         capability cache once it rejects a command or type
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] responseMsg - response PLDM message
+     *  @param[in] responseLen - length of response PLDM message
+     */
+    void revalidateCapabilities(pldm_tid_t tid, const pldm_msg* responseMsg,
+                                size_t responseLen);
+
     /** @brief Reference to a Handler object that manages the request/response
      *         logic.
      */
@@ -245,6 +289,14 @@ class TerminusManager
 
     /** @brief local EID */
     mctp_eid_t localEid;
+
+    /** @brief Capabilities of the termini keyed by endpoint UUID and PLDM
+     *         base version
+     */
+    CapabilityCache capabilityCache;
+
+    /** @brief The termini initialized from the capability cache */
+    std::set<pldm_tid_t> cachedCapabilityTids;
 };
 } // namespace platform_mc
 } // namespace pldm
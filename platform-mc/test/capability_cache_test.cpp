@@ -0,0 +1,104 @@
+#include "libpldm/base.h"
+
+#include "platform-mc/capability_cache.hpp"
+
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+
+class CapabilityCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_capability_cache.XXXXXX";
+        dir = std::filesystem::path(mkdtemp(tmpdir));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    static Capabilities makeCapabilities()
+    {
+        constexpr size_t cmdBytesPerType = PLDM_MAX_CMDS_PER_TYPE / 8;
+        Capabilities capabilities{};
+        capabilities.supportedTypes = (1 << PLDM_BASE) | (1 << PLDM_PLATFORM);
+        capabilities.supportedCmds.resize(PLDM_MAX_TYPES * cmdBytesPerType);
+        capabilities.supportedCmds[0] = 0x34;
+        capabilities.supportedCmds[PLDM_PLATFORM * cmdBytesPerType + 6] = 0x02;
+        return capabilities;
+    }
+
+    static constexpr ver32_t version{0xF1, 0xF0, 0xF0, 0x00};
+
+    std::filesystem::path dir;
+};
+
+TEST_F(CapabilityCacheTest, storeGet)
+{
+    CapabilityCache cache(dir / "capabilities");
+    const pldm::UUID uuid = "ad4c8360-c54c-11eb-8529-0242ac130003";
+    EXPECT_FALSE(cache.get(uuid, version).has_value());
+
+    auto capabilities = makeCapabilities();
+    ASSERT_TRUE(cache.store(uuid, version, capabilities));
+
+    auto cached = cache.get(uuid, version);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(capabilities.supportedTypes, cached->supportedTypes);
+    EXPECT_EQ(capabilities.supportedCmds, cached->supportedCmds);
+
+    cache.invalidate(uuid);
+    EXPECT_FALSE(cache.get(uuid, version).has_value());
+}
+
+TEST_F(CapabilityCacheTest, otherVersion)
+{
+    CapabilityCache cache(dir);
+    const pldm::UUID uuid = "ad4c8360-c54c-11eb-8529-0242ac130003";
+    ASSERT_TRUE(cache.store(uuid, version, makeCapabilities()));
+
+    const ver32_t updated{0xF2, 0xF0, 0xF0, 0x00};
+    EXPECT_FALSE(cache.get(uuid, updated).has_value());
+    EXPECT_TRUE(cache.get(uuid, version).has_value());
+}
+
+TEST_F(CapabilityCacheTest, expiredEntry)
+{
+    CapabilityCache cache(dir, std::chrono::hours(1));
+    const pldm::UUID uuid = "ad4c8360-c54c-11eb-8529-0242ac130003";
+    ASSERT_TRUE(cache.store(uuid, version, makeCapabilities()));
+    EXPECT_TRUE(cache.get(uuid, version).has_value());
+
+    std::filesystem::last_write_time(
+        dir / uuid,
+        std::filesystem::file_time_type::clock::now() - std::chrono::hours(2));
+    EXPECT_FALSE(cache.get(uuid, version).has_value());
+}
+
+TEST_F(CapabilityCacheTest, uncacheableUuid)
+{
+    CapabilityCache cache(dir);
+    auto capabilities = makeCapabilities();
+
+    EXPECT_FALSE(cache.isCacheable(""));
+    EXPECT_FALSE(cache.store("", version, capabilities));
+    EXPECT_FALSE(cache.store("../ad4c8360", version, capabilities));
+    EXPECT_FALSE(cache.get("", version).has_value());
+}
+
+TEST_F(CapabilityCacheTest, corruptedEntry)
+{
+    CapabilityCache cache(dir);
+    const pldm::UUID uuid = "ad4c8360-c54c-11eb-8529-0242ac130003";
+    ASSERT_TRUE(cache.store(uuid, version, makeCapabilities()));
+
+    // truncate the commands of the last type
+    auto path = dir / uuid;
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(cache.get(uuid, version).has_value());
+}
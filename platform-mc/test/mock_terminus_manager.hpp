@@ -16,14 +16,17 @@ class MockTerminusManager : public TerminusManager
   public:
     MockTerminusManager(sdeventplus::Event& event, RequesterHandler& handler,
                         pldm::InstanceIdDb& instanceIdDb,
-                        TerminiMapper& termini, Manager* manager) :
+                        TerminiMapper& termini, Manager* manager,
+                        const std::filesystem::path& capabilityCacheDir =
+                            CAPABILITY_CACHE_DIR) :
         TerminusManager(event, handler, instanceIdDb, termini, manager,
-                        pldm::BmcMctpEid)
+                        pldm::BmcMctpEid, capabilityCacheDir)
     {}
 
     exec::task<int> sendRecvPldmMsgOverMctp(
         mctp_eid_t /*eid*/, Request& /*request*/, const pldm_msg** responseMsg,
-        size_t* responseLen) override
+        size_t* responseLen,
+        requester::RequestPriority /*priority*/) override
     {
         if (responseMsgs.empty() || responseMsg == nullptr ||
             responseLen == nullptr)
@@ -270,3 +270,54 @@ TEST(NumericSensor, checkThreshold)
                                      hysteresis);
     EXPECT_EQ(false, lowAlarm);
 }
+
+TEST(NumericSensor, duplicateObjectPath)
+{
+    auto numericSensorPdr = std::make_shared<pldm_numeric_sensor_value_pdr>();
+    numericSensorPdr->sensor_id = 1;
+    numericSensorPdr->base_unit = PLDM_SENSOR_UNIT_DEGRESS_C;
+
+    std::string sensorName{"duplicate1"};
+    std::string inventoryPath{
+        "/xyz/openbmc_project/inventroy/Item/Board/PLDM_device_1"};
+    std::string path{"/xyz/openbmc_project/sensors/temperature/duplicate1"};
+    {
+        pldm::platform_mc::NumericSensor sensor(0x01, true, numericSensorPdr,
+                                                sensorName, inventoryPath);
+        EXPECT_TRUE(pldm::platform_mc::SensorPathClaim::isOwned(path));
+        EXPECT_THROW(pldm::platform_mc::NumericSensor(
+                         0x01, true, numericSensorPdr, sensorName,
+                         inventoryPath),
+                     sdbusplus::exception_t);
+    }
+
+    // the path is released with the sensor owning it
+    EXPECT_FALSE(pldm::platform_mc::SensorPathClaim::isOwned(path));
+    EXPECT_NO_THROW(pldm::platform_mc::NumericSensor(
+        0x01, true, numericSensorPdr, sensorName, inventoryPath));
+}
+
+TEST(NumericSensor, memoryUsage)
+{
+    auto numericSensorPdr = std::make_shared<pldm_numeric_sensor_value_pdr>();
+    numericSensorPdr->sensor_id = 1;
+    numericSensorPdr->base_unit = PLDM_SENSOR_UNIT_VOLTS;
+
+    std::string inventoryPath{
+        "/xyz/openbmc_project/inventroy/Item/Board/PLDM_device_1"};
+    std::string sensorName{"memory1"};
+    pldm::platform_mc::NumericSensor sensor(0x01, true, numericSensorPdr,
+                                            sensorName, inventoryPath);
+    EXPECT_EQ(pldm::platform_mc::voltageNameSpace, sensor.sensorNameSpace);
+
+    // the threshold interfaces are only created for the declared thresholds
+    numericSensorPdr->supported_thresholds.bits.bit0 = 1;
+    numericSensorPdr->supported_thresholds.bits.bit1 = 1;
+    sensorName = "memory2";
+    pldm::platform_mc::NumericSensor sensorWithThresholds(
+        0x01, true, numericSensorPdr, sensorName, inventoryPath);
+    EXPECT_EQ(sensor.memoryUsage() +
+                  sizeof(pldm::platform_mc::ThresholdWarningIntf) +
+                  sizeof(pldm::platform_mc::ThresholdCriticalIntf),
+              sensorWithThresholds.memoryUsage());
+}
@@ -185,7 +185,8 @@ TEST_F(PlatformManagerTest, initTerminusTest)
 
     stdexec::sync_wait(platformManager.initTerminus());
     EXPECT_EQ(true, terminus->initialized);
-    EXPECT_EQ(2, terminus->pdrs.size());
+    EXPECT_EQ(0, terminus->pdrs.size());
+    EXPECT_EQ(2, terminus->getMemoryUsage().parsedPdrs);
     EXPECT_EQ(1, terminus->numericSensors.size());
     EXPECT_EQ("S0", terminus->getTerminusName());
 }
@@ -344,7 +345,8 @@ TEST_F(PlatformManagerTest, parseTerminusNameTest)
 
     stdexec::sync_wait(platformManager.initTerminus());
     EXPECT_EQ(true, terminus->initialized);
-    EXPECT_EQ(2, terminus->pdrs.size());
+    EXPECT_EQ(0, terminus->pdrs.size());
+    EXPECT_EQ(2, terminus->getMemoryUsage().parsedPdrs);
     EXPECT_EQ("S0", terminus->getTerminusName());
 }
 
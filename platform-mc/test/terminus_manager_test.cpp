@@ -15,6 +15,8 @@
 #include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <filesystem>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -498,3 +500,119 @@ TEST_F(TerminusManagerTest, doesSupportCommandTest)
     EXPECT_EQ(false, termini[1]->doesSupportCommand(
                          PLDM_FRU, PLDM_GET_FRU_RECORD_BY_OPTION));
 }
+
+TEST_F(TerminusManagerTest, cachedCapabilitiesTest)
+{
+    char tmpdir[] = "/tmp/pldm_capability_cache.XXXXXX";
+    std::filesystem::path cacheDir(mkdtemp(tmpdir));
+    pldm::platform_mc::MockTerminusManager cachingTerminusManager(
+        event, reqHandler, instanceIdDb, termini, nullptr, cacheDir);
+
+    const size_t getTidRespLen = PLDM_GET_TID_RESP_BYTES;
+    const size_t setTidRespLen = PLDM_SET_TID_RESP_BYTES;
+    const size_t getPldmVersionRespLen = PLDM_GET_VERSION_RESP_BYTES;
+    const size_t getPldmTypesRespLen = PLDM_GET_TYPES_RESP_BYTES;
+    const size_t getPldmCommandsRespLen = PLDM_GET_COMMANDS_RESP_BYTES;
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getTidRespLen> getTidResp0{
+        0x00, 0x02, 0x02, 0x00, 0x00};
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + setTidRespLen> setTidResp0{
+        0x00, 0x02, 0x01, 0x00};
+    // PLDM base version 1.1.0
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getPldmVersionRespLen>
+        getPldmVersionResp0{0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00,
+                            0x00, 0x05, 0x00, 0xF0, 0xF1, 0xF1};
+    // PLDM base version 1.2.0, after a firmware update
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getPldmVersionRespLen>
+        getPldmVersionResp1{0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00,
+                            0x00, 0x05, 0x00, 0xF0, 0xF2, 0xF1};
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getPldmTypesRespLen>
+        getPldmTypesResp0{0x00, 0x02, 0x04, 0x00, 0x01, 0x00,
+                          0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    // GetTID, GetPLDMVersion, GetPLDMTypes and GetPLDMCommands
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + getPldmCommandsRespLen>
+        getPldmCommandsResp0{0x00, 0x02, 0x05, 0x00, 0x3C};
+
+    // 0.discover the endpoint, the capabilities are probed and cached
+    auto rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getTidResp0.data()), sizeof(getTidResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(setTidResp0.data()), sizeof(setTidResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmVersionResp0.data()),
+        sizeof(getPldmVersionResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmTypesResp0.data()),
+        sizeof(getPldmTypesResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmCommandsResp0.data()),
+        sizeof(getPldmCommandsResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    pldm::MctpInfos mctpInfos{};
+    mctpInfos.emplace_back(
+        pldm::MctpInfo(12, "ad4c8360-c54c-11eb-8529-0242ac130003", "", 1));
+    cachingTerminusManager.discoverMctpTerminus(mctpInfos);
+    ASSERT_EQ(1, termini.size());
+    EXPECT_TRUE(cachingTerminusManager.responseMsgs.empty());
+    EXPECT_TRUE(termini[1]->doesSupportCommand(PLDM_BASE, PLDM_GET_PLDM_TYPES));
+
+    // 1.the endpoint comes back after a reset with the same version, only
+    // the TID is assigned
+    cachingTerminusManager.removeMctpTerminus(mctpInfos);
+    EXPECT_EQ(0, termini.size());
+
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getTidResp0.data()), sizeof(getTidResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(setTidResp0.data()), sizeof(setTidResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmVersionResp0.data()),
+        sizeof(getPldmVersionResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    cachingTerminusManager.discoverMctpTerminus(mctpInfos);
+    ASSERT_EQ(1, termini.size());
+    EXPECT_TRUE(cachingTerminusManager.responseMsgs.empty());
+    EXPECT_TRUE(termini[1]->doesSupportType(PLDM_BASE));
+    EXPECT_TRUE(termini[1]->doesSupportCommand(PLDM_BASE, PLDM_GET_PLDM_TYPES));
+    EXPECT_FALSE(termini[1]->doesSupportCommand(PLDM_BASE, PLDM_SET_TID));
+
+    // 2.the endpoint comes back with another version, the capabilities are
+    // probed again
+    cachingTerminusManager.removeMctpTerminus(mctpInfos);
+    EXPECT_EQ(0, termini.size());
+
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getTidResp0.data()), sizeof(getTidResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(setTidResp0.data()), sizeof(setTidResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmVersionResp1.data()),
+        sizeof(getPldmVersionResp1));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmTypesResp0.data()),
+        sizeof(getPldmTypesResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    rc = cachingTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getPldmCommandsResp0.data()),
+        sizeof(getPldmCommandsResp0));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    cachingTerminusManager.discoverMctpTerminus(mctpInfos);
+    ASSERT_EQ(1, termini.size());
+    EXPECT_TRUE(cachingTerminusManager.responseMsgs.empty());
+    EXPECT_TRUE(termini[1]->doesSupportCommand(PLDM_BASE, PLDM_GET_PLDM_TYPES));
+
+    cachingTerminusManager.removeMctpTerminus(mctpInfos);
+    std::filesystem::remove_all(cacheDir);
+}
@@ -104,7 +104,8 @@ TEST(TerminusTest, parseSensorAuxiliaryNamesPDRTest)
     EXPECT_EQ(1, names[0].size());
     EXPECT_EQ("en", names[0][0].first);
     EXPECT_EQ("TEMP1", names[0][0].second);
-    EXPECT_EQ(2, t1.pdrs.size());
+    EXPECT_EQ(0, t1.pdrs.size());
+    EXPECT_EQ(2, t1.getMemoryUsage().parsedPdrs);
     EXPECT_EQ("S0", t1.getTerminusName());
 }
 
@@ -223,7 +224,8 @@ TEST(TerminusTest, parseSensorAuxiliaryMultiNamesPDRTest)
     EXPECT_EQ("TEMP2", names[0][1].second);
     EXPECT_EQ("fr", names[0][2].first);
     EXPECT_EQ("TEMP12", names[0][2].second);
-    EXPECT_EQ(2, t1.pdrs.size());
+    EXPECT_EQ(0, t1.pdrs.size());
+    EXPECT_EQ(2, t1.getMemoryUsage().parsedPdrs);
     EXPECT_EQ("S0", t1.getTerminusName());
 }
 
@@ -344,7 +346,8 @@ TEST(TerminusTest, parseSensorAuxiliaryNamesMultiSensorsPDRTest)
     EXPECT_EQ("TEMP2", names[1][0].second);
     EXPECT_EQ("fr", names[1][1].first);
     EXPECT_EQ("TEMP12", names[1][1].second);
-    EXPECT_EQ(2, t1.pdrs.size());
+    EXPECT_EQ(0, t1.pdrs.size());
+    EXPECT_EQ(2, t1.getMemoryUsage().parsedPdrs);
     EXPECT_EQ("S0", t1.getTerminusName());
 }
 
@@ -381,4 +384,11 @@ TEST(TerminusTest, parsePDRTestNoSensorPDR)
 
     auto sensorAuxNames = t1.getSensorAuxiliaryNames(1);
     EXPECT_EQ(nullptr, sensorAuxNames);
+
+    // the raw PDR is released, only the parsed names are kept
+    EXPECT_TRUE(t1.pdrs.empty());
+    auto usage = t1.getMemoryUsage();
+    EXPECT_EQ(1, usage.parsedPdrs);
+    EXPECT_EQ(0, usage.numericSensors);
+    EXPECT_LT(0, usage.auxNameBytes);
 }
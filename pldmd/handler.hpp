@@ -5,6 +5,7 @@
 #include <cassert>
 #include <functional>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace pldm
@@ -39,6 +40,16 @@ class CmdHandler
         return handlers.at(pldmCommand)(tid, request, reqMsgLen);
     }
 
+    /** @brief Check if the handler of a command may run on a worker thread
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return true if the command is offloadable
+     */
+    bool isOffloadable(Command pldmCommand) const
+    {
+        return offloadable.contains(pldmCommand);
+    }
+
     /** @brief Create a response message containing only cc
      *
      *  @param[in] request - PLDM request message
@@ -61,6 +72,13 @@ class CmdHandler
      *         classes.
      */
     std::map<Command, HandlerFunc> handlers;
+
+    /** @brief commands whose handlers may run on a worker thread, concurrently
+     *         with the event loop and with each other. Their handlers must
+     *         not touch the D-Bus connection nor state owned by the event
+     *         loop, like the PDR repository and the BIOS tables.
+     */
+    std::set<Command> offloadable;
 };
 
 } // namespace responder
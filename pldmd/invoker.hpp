@@ -44,6 +44,19 @@ class Invoker
                                              reqMsgLen);
     }
 
+    /** @brief Check if the handler of a command may run on a worker thread
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @return true if the command is offloadable
+     */
+    bool isOffloadable(Type pldmType, Command pldmCommand) const
+    {
+        auto handler = handlers.find(pldmType);
+        return handler != handlers.end() &&
+               handler->second->isOffloadable(pldmCommand);
+    }
+
   private:
     std::map<Type, std::unique_ptr<CmdHandler>> handlers;
 };
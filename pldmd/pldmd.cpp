@@ -10,6 +10,8 @@
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
+#include "requester/retry_policy.hpp"
+#include "worker_pool.hpp"
 
 #include <err.h>
 #include <getopt.h>
@@ -161,6 +163,71 @@ static std::optional<Response>
     return std::nullopt;
 }
 
+static void sendResponse(PldmTransport& pldmTransport, const Response& response,
+                         bool verbose, pldm_tid_t tid)
+{
+    FlightRecorder::GetInstance().saveRecord(response, true);
+    if (verbose)
+    {
+        printBuffer(Tx, response);
+    }
+
+    auto returnCode =
+        pldmTransport.sendMsg(tid, response.data(), response.size());
+    if (returnCode != PLDM_REQUESTER_SUCCESS)
+    {
+        warning(
+            "Failed to send pldmTransport message for TID '{TID}', response code '{RETURN_CODE}'",
+            "TID", tid, "RETURN_CODE", returnCode);
+    }
+}
+
+/** @brief Run the handler of an offloadable PLDM request on a worker thread,
+ *         the response is sent from the event loop once the handler returns
+ *
+ *  @return true if the request was offloaded
+ */
+static bool offloadRxMsg(const std::vector<uint8_t>& requestMsg,
+                         Invoker& invoker, WorkerPool* workerPool,
+                         PldmTransport& pldmTransport, bool verbose,
+                         pldm_tid_t tid)
+{
+    pldm_header_info hdrFields{};
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(requestMsg.data());
+    if (!workerPool || PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields) ||
+        PLDM_RESPONSE == hdrFields.msg_type ||
+        !invoker.isOffloadable(hdrFields.pldm_type, hdrFields.command))
+    {
+        return false;
+    }
+
+    workerPool->submit(
+        [&invoker, requestMsg, tid, type = hdrFields.pldm_type,
+         command = hdrFields.command]() {
+            auto request = reinterpret_cast<const pldm_msg*>(requestMsg.data());
+            try
+            {
+                return invoker.handle(tid, type, command, request,
+                                      requestMsg.size() - sizeof(pldm_msg_hdr));
+            }
+            catch (const std::exception& e)
+            {
+                // The requester gets an error instead of no response
+                error(
+                    "Offloaded handler of PLDM type '{TYPE}' command '{COMMAND}' failed, error - {ERROR}",
+                    "TYPE", type, "COMMAND", command, "ERROR", e);
+                return CmdHandler::ccOnlyResponse(request, PLDM_ERROR);
+            }
+        },
+        [&pldmTransport, verbose, tid](Response&& response) {
+            if (!response.empty())
+            {
+                sendResponse(pldmTransport, response, verbose, tid);
+            }
+        });
+    return true;
+}
+
 void optionUsage(void)
 {
     info("Usage: pldmd [options]");
@@ -199,7 +266,7 @@ int main(int argc, char** argv)
     sdbusplus::server::manager_t sensorObjManager(
         bus, "/xyz/openbmc_project/sensors");
 
-    InstanceIdDb instanceIdDb;
+    LeasedInstanceIdDb instanceIdDb;
     dbus_api::Requester dbusImplReq(bus, "/xyz/openbmc_project/pldm",
                                     instanceIdDb);
     sdbusplus::server::manager_t inventoryManager(
@@ -208,6 +275,8 @@ int main(int argc, char** argv)
     Invoker invoker{};
     requester::Handler<requester::Request> reqHandler(&pldmTransport, event,
                                                       instanceIdDb, verbose);
+    reqHandler.setRetryPolicies(
+        requester::parseRetryPolicies(REQUEST_RETRY_POLICY_JSON));
 
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
         pldm_pdr_init(), pldm_pdr_destroy);
@@ -267,13 +336,15 @@ int main(int argc, char** argv)
         FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
         bmcEntityTree.get());
 
-    // FRU table is built lazily when a FRU command or Get PDR command is
-    // handled. To enable building FRU table, the FRU handler is passed to the
-    // Platform handler.
+    // FRU table is built once the inventory settles, or when a FRU command or
+    // Get PDR command is handled before that, and updated as FRUs are plugged
+    // and unplugged. To enable building FRU table, the FRU handler is passed
+    // to the Platform handler.
     auto platformHandler = std::make_unique<platform::Handler>(
         &dbusHandler, hostEID, &instanceIdDb, PDR_JSONS_DIR, pdrRepo.get(),
         hostPDRHandler.get(), dbusToPLDMEventHandler.get(), fruHandler.get(),
         platformConfigHandler.get(), &reqHandler, event, true);
+    platformHandler->enablePdrImageCache(PDR_IMAGE_CACHE_DIR);
 
     auto biosHandler = std::make_unique<bios::Handler>(
         pldmTransport.getEventSource(), hostEID, &instanceIdDb, &reqHandler,
@@ -289,6 +360,8 @@ int main(int argc, char** argv)
         &reqHandler);
 #endif
 
+    fruHandler->watchInventory(event, bus);
+
     invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
     invoker.registerHandler(PLDM_PLATFORM, std::move(platformHandler));
     invoker.registerHandler(PLDM_FRU, std::move(fruHandler));
@@ -308,8 +381,15 @@ int main(int argc, char** argv)
         std::make_unique<MctpDiscovery>(
             bus, std::initializer_list<MctpDiscoveryHandlerIntf*>{
                      fwManager.get(), platformManager.get()});
+    std::unique_ptr<WorkerPool> workerPool{};
+    if (RESPONDER_WORKER_THREADS)
+    {
+        workerPool =
+            std::make_unique<WorkerPool>(event, RESPONDER_WORKER_THREADS);
+    }
     auto callback = [verbose, &invoker, &reqHandler, &fwManager, &pldmTransport,
-                     TID](IO& io, int fd, uint32_t revents) mutable {
+                     &workerPool, TID](IO& io, int fd,
+                                       uint32_t revents) mutable {
         if (!(revents & EPOLLIN))
         {
             return;
@@ -334,24 +414,16 @@ int main(int argc, char** argv)
             {
                 printBuffer(Rx, requestMsgVec);
             }
-            // process message and send response
-            auto response = processRxMsg(requestMsgVec, invoker, reqHandler,
-                                         fwManager.get(), TID);
-            if (response.has_value())
+            // process message and send response, the slow handlers run on
+            // the worker pool
+            if (!offloadRxMsg(requestMsgVec, invoker, workerPool.get(),
+                              pldmTransport, verbose, TID))
             {
-                FlightRecorder::GetInstance().saveRecord(*response, true);
-                if (verbose)
-                {
-                    printBuffer(Tx, *response);
-                }
-
-                returnCode = pldmTransport.sendMsg(TID, (*response).data(),
-                                                   (*response).size());
-                if (returnCode != PLDM_REQUESTER_SUCCESS)
+                auto response = processRxMsg(requestMsgVec, invoker, reqHandler,
+                                             fwManager.get(), TID);
+                if (response.has_value())
                 {
-                    warning(
-                        "Failed to send pldmTransport message for TID '{TID}', response code '{RETURN_CODE}'",
-                        "TID", TID, "RETURN_CODE", returnCode);
+                    sendResponse(pldmTransport, *response, verbose, TID);
                 }
             }
         }
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "handler.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class WorkerPool
+ *
+ *  Runs the PLDM command handlers marked offloadable on worker threads, so
+ *  that a slow handler doesn't stall the event loop. The responses are posted
+ *  back to the event loop, where their completions run.
+ */
+class WorkerPool
+{
+  public:
+    using Job = std::function<Response()>;
+    using Completion = std::function<void(Response&& response)>;
+
+    WorkerPool() = delete;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the completions run on
+     *  @param[in] numThreads - number of worker threads
+     */
+    explicit WorkerPool(sdeventplus::Event& event, size_t numThreads) :
+        eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (eventFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to create the worker pool eventfd");
+        }
+        completionSource.emplace(
+            event, eventFd, EPOLLIN,
+            [this](sdeventplus::source::IO&, int, uint32_t) {
+                runCompletions();
+            });
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            workers.emplace_back(&WorkerPool::run, this);
+        }
+    }
+
+    /** @brief Stop the workers once they finish the running jobs, the queued
+     *         jobs and the pending completions are dropped
+     */
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        completionSource.reset();
+        close(eventFd);
+    }
+
+    /** @brief Run a job on a worker thread
+     *
+     *  @param[in] job - the job, run on a worker thread
+     *  @param[in] completion - invoked with the response of the job on the
+     *                          event loop
+     */
+    void submit(Job&& job, Completion&& completion)
+    {
+        {
+            std::lock_guard lock(mutex);
+            jobs.emplace_back(std::move(job), std::move(completion));
+        }
+        jobAvailable.notify_one();
+    }
+
+    /** @brief Number of worker threads */
+    size_t size() const
+    {
+        return workers.size();
+    }
+
+  private:
+    /** @brief Worker thread, runs the jobs until the pool is stopped */
+    void run()
+    {
+        while (true)
+        {
+            std::pair<Job, Completion> entry;
+            {
+                std::unique_lock lock(mutex);
+                jobAvailable.wait(lock,
+                                  [this] { return stopping || !jobs.empty(); });
+                if (stopping)
+                {
+                    return;
+                }
+                entry = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            Response response{};
+            try
+            {
+                response = entry.first();
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Offloaded PLDM command handler failed, {ERROR}",
+                           "ERROR", e);
+            }
+
+            {
+                std::lock_guard lock(mutex);
+                completions.emplace_back(std::move(response),
+                                         std::move(entry.second));
+            }
+            uint64_t one = 1;
+            if (write(eventFd, &one, sizeof(one)) < 0)
+            {
+                lg2::error("Failed to signal the worker pool eventfd, {ERRNO}",
+                           "ERRNO", errno);
+            }
+        }
+    }
+
+    /** @brief Invoke the completions of the finished jobs, on the event loop
+     */
+    void runCompletions()
+    {
+        uint64_t count = 0;
+        if (read(eventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+        {
+            lg2::error("Failed to read the worker pool eventfd, {ERRNO}",
+                       "ERRNO", errno);
+        }
+
+        std::deque<std::pair<Response, Completion>> finished;
+        {
+            std::lock_guard lock(mutex);
+            finished.swap(completions);
+        }
+        for (auto& [response, completion] : finished)
+        {
+            completion(std::move(response));
+        }
+    }
+
+    int eventFd; //!< signals the event loop of finished jobs
+    std::optional<sdeventplus::source::IO> completionSource;
+
+    std::mutex mutex; //!< guards jobs, completions and stopping
+    std::condition_variable jobAvailable;
+    std::deque<std::pair<Job, Completion>> jobs;
+    std::deque<std::pair<Response, Completion>> completions;
+    bool stopping = false;
+
+    std::vector<std::thread> workers;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -19,8 +19,6 @@ namespace
 
 using namespace pldmtool::helper;
 
-std::vector<std::unique_ptr<CommandInterface>> commands;
-
 const std::map<const char*, pldm_fileio_table_type> pldmFileIOTableTypes{
     {"AttributeTable", PLDM_FILE_ATTRIBUTE_TABLE},
 };
@@ -109,6 +107,12 @@ class GetFileTable : public CommandInterface
     }
 
     void parseResponseMsg(pldm_msg*, size_t) override {}
+
+    bool isPipelinable() const override
+    {
+        return false;
+    }
+
     void exec() override
     {
         std::vector<uint8_t> requestMsg(
@@ -198,7 +202,7 @@ class GetFileTable : public CommandInterface
     }
 };
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto oem_ibm = app.add_subcommand("oem-ibm", "oem type command");
     oem_ibm->require_subcommand(1);
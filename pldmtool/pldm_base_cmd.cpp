@@ -22,7 +22,6 @@ namespace
 
 using namespace pldmtool::helper;
 
-std::vector<std::unique_ptr<CommandInterface>> commands;
 const std::map<const char*, pldm_supported_types> pldmTypes{
     {"base", PLDM_BASE},   {"platform", PLDM_PLATFORM},
     {"bios", PLDM_BIOS},   {"fru", PLDM_FRU},
@@ -361,7 +360,7 @@ class GetPLDMCommands : public CommandInterface
     }
 };
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto base = app.add_subcommand("base", "base type command");
     base->require_subcommand(1);
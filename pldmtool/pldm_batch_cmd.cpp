@@ -0,0 +1,439 @@
+#include "pldm_batch_cmd.hpp"
+
+#include "common/transport.hpp"
+#include "pldm_cmd_helper.hpp"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace pldm::utils;
+
+namespace pldmtool
+{
+
+namespace batch
+{
+
+using namespace pldmtool::helper;
+
+namespace
+{
+
+/** @class OutputCapture
+ *
+ *  Redirects std::cout and std::cerr into string buffers for its lifetime,
+ *  so that the output of a command can be attributed to its script line.
+ */
+class OutputCapture
+{
+  public:
+    OutputCapture() :
+        coutBuf(std::cout.rdbuf(out.rdbuf())),
+        cerrBuf(std::cerr.rdbuf(err.rdbuf()))
+    {}
+
+    OutputCapture(const OutputCapture&) = delete;
+    OutputCapture& operator=(const OutputCapture&) = delete;
+
+    ~OutputCapture()
+    {
+        std::cout.rdbuf(coutBuf);
+        std::cerr.rdbuf(cerrBuf);
+    }
+
+    std::string output() const
+    {
+        return out.str();
+    }
+
+    std::string errors() const
+    {
+        return err.str();
+    }
+
+  private:
+    std::ostringstream out;
+    std::ostringstream err;
+    std::streambuf* coutBuf;
+    std::streambuf* cerrBuf;
+};
+
+/** @struct CommandTree
+ *
+ *  The command tree of a script line, its CLI::App and the commands
+ *  registered against it. The app is declared last so that it is destroyed
+ *  first, its callbacks reference the commands.
+ */
+struct CommandTree
+{
+    Commands commands;
+    std::unique_ptr<CLI::App> app;
+};
+
+/** @struct PendingRequest
+ *
+ *  A request sent in the current window, waiting for its response. It owns
+ *  the command tree of its line until the response is handled.
+ */
+struct PendingRequest
+{
+    size_t line;
+    std::string command;
+    CommandInterface* interface;
+    std::vector<uint8_t> requestMsg;
+    std::string output;
+    std::string errors;
+    bool done;
+    std::unique_ptr<CommandTree> tree;
+};
+
+} // namespace
+
+class Batch
+{
+  public:
+    Batch() = delete;
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    explicit Batch(CLI::App* app, CommandSet commandSet) :
+        commandSet(std::move(commandSet))
+    {
+        app->add_option("-f,--file", scriptFile,
+                        "script with one pldmtool command per line, "
+                        "standard input if not set");
+        app->add_option("-w,--window", windowSize,
+                        "maximum number of requests in flight, each to a "
+                        "different MCTP endpoint")
+            ->check(CLI::Range(1, 255));
+        app->add_option("-t,--timeout", timeoutMs,
+                        "response timeout in milliseconds of the pipelined "
+                        "requests");
+        app->callback([this]() { exec(); });
+    }
+
+    void exec()
+    {
+        std::ifstream file;
+        std::istream* script = &std::cin;
+        if (!scriptFile.empty())
+        {
+            file.open(scriptFile);
+            if (!file)
+            {
+                std::cerr << "Failed to open " << scriptFile << "\n";
+                return;
+            }
+            script = &file;
+        }
+
+        stdOut = std::cout.rdbuf();
+        CommandInterface::setScheduler(
+            [this](CommandInterface& command) { return schedule(command); });
+
+        std::string command;
+        size_t line = 0;
+        while (std::getline(*script, command))
+        {
+            ++line;
+            auto first = command.find_first_not_of(" \t\r");
+            if (first == std::string::npos || command[first] == '#')
+            {
+                continue;
+            }
+            auto last = command.find_last_not_of(" \t\r");
+            command = command.substr(first, last - first + 1);
+            if (command.starts_with("pldmtool "))
+            {
+                command.erase(0, std::string("pldmtool ").size());
+            }
+
+            runLine(line, command);
+        }
+
+        flush();
+        CommandInterface::setScheduler(nullptr);
+    }
+
+  private:
+    /** @brief Parse and execute a script line. The commands that can be
+     *         pipelined are only sent, their output is emitted when the window
+     *         is flushed.
+     */
+    void runLine(size_t line, const std::string& command)
+    {
+        currentLine = line;
+        currentCommand = command;
+        scheduled = false;
+
+        auto tree = std::make_unique<CommandTree>();
+        tree->app = std::make_unique<CLI::App>("pldmtool batch line");
+        tree->app->require_subcommand(1)->ignore_case();
+        commandSet.registerCommands(*tree->app, tree->commands);
+
+        std::string output;
+        std::string errors;
+        {
+            OutputCapture capture;
+            try
+            {
+                tree->app->parse(command, false);
+                commandSet.postParse(tree->commands);
+            }
+            catch (const CLI::ParseError& e)
+            {
+                std::cerr << e.get_name() << ": " << e.what() << "\n";
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << "\n";
+            }
+            output = capture.output();
+            errors = capture.errors();
+        }
+
+        if (scheduled && !pending.empty())
+        {
+            // released once the response of the line is handled
+            pending.back().tree = std::move(tree);
+            return;
+        }
+
+        // keep the lines in order, emit what is still in flight first
+        flush();
+        emit(line, command, output, errors);
+    }
+
+    /** @brief Scheduler hook of the commands, see CommandScheduler */
+    bool schedule(CommandInterface& command)
+    {
+        if (!command.isPipelinable() || windowSize <= 1)
+        {
+            flush();
+            return false;
+        }
+
+        auto eid = command.getMCTPEID();
+        if (pending.size() >= windowSize ||
+            std::ranges::any_of(pending, [eid](const auto& request) {
+                return request.interface->getMCTPEID() == eid;
+            }))
+        {
+            flush();
+        }
+
+        auto [rc, requestMsg] = command.prepareRequestMsg();
+        if (rc != PLDM_SUCCESS)
+        {
+            return true;
+        }
+
+        pending.emplace_back(PendingRequest{currentLine, currentCommand,
+                                            &command, std::move(requestMsg),
+                                            {}, {}, false, nullptr});
+        scheduled = true;
+        return true;
+    }
+
+    /** @brief Send the requests of the window, wait for their responses and
+     *         emit the output of their lines in order
+     */
+    void flush()
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+
+        auto& pldmTransport = getPldmTransport();
+        size_t outstanding = 0;
+        for (auto& request : pending)
+        {
+            OutputCapture capture;
+            if (request.interface->isVerbose())
+            {
+                std::cout << "pldmtool: ";
+                printBuffer(Tx, request.requestMsg);
+            }
+            auto rc = pldmTransport.sendMsg(request.interface->getMCTPEID(),
+                                            request.requestMsg.data(),
+                                            request.requestMsg.size());
+            if (rc != PLDM_REQUESTER_SUCCESS)
+            {
+                std::cerr << "failed to send pldm request rc " << rc << "\n";
+                request.interface->abandonRequest();
+                request.done = true;
+                request.tree.reset();
+            }
+            else
+            {
+                ++outstanding;
+            }
+            request.output = capture.output();
+            request.errors = capture.errors();
+        }
+
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(timeoutMs);
+        pollfd pfd{pldmTransport.getEventSource(), POLLIN, 0};
+        while (outstanding)
+        {
+            auto remaining =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now())
+                    .count();
+            if (remaining <= 0)
+            {
+                break;
+            }
+            auto ret = poll(&pfd, 1, remaining);
+            if (ret < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (ret <= 0)
+            {
+                break;
+            }
+
+            pldm_tid_t tid{};
+            void* responseMessage = nullptr;
+            size_t responseMessageSize{};
+            if (pldmTransport.recvMsg(tid, responseMessage,
+                                      responseMessageSize) !=
+                PLDM_REQUESTER_SUCCESS)
+            {
+                continue;
+            }
+            if (responseMessageSize >= sizeof(pldm_msg_hdr))
+            {
+                auto hdr = static_cast<const pldm_msg_hdr*>(responseMessage);
+                auto it = std::ranges::find_if(pending, [&](const auto& req) {
+                    auto reqHdr = reinterpret_cast<const pldm_msg_hdr*>(
+                        req.requestMsg.data());
+                    return !req.done && !hdr->request &&
+                           req.interface->getMCTPEID() == tid &&
+                           hdr->instance_id == reqHdr->instance_id &&
+                           hdr->type == reqHdr->type &&
+                           hdr->command == reqHdr->command;
+                });
+                if (it != pending.end())
+                {
+                    auto data = static_cast<const uint8_t*>(responseMessage);
+                    handleResponse(*it, std::vector<uint8_t>(
+                                            data, data + responseMessageSize));
+                    --outstanding;
+                }
+            }
+            free(responseMessage);
+        }
+
+        for (auto& request : pending)
+        {
+            if (!request.done)
+            {
+                OutputCapture capture;
+                request.interface->abandonRequest();
+                if (request.errors.empty())
+                {
+                    std::cerr << "no response received within " << timeoutMs
+                              << " ms\n";
+                }
+                request.output += capture.output();
+                request.errors += capture.errors();
+                request.tree.reset();
+            }
+            emit(request.line, request.command, request.output,
+                 request.errors);
+        }
+        pending.clear();
+    }
+
+    /** @brief Decode the response of a request as it arrives and release the
+     *         command tree of its line, the output is emitted in script order
+     *         once the window is flushed
+     */
+    void handleResponse(PendingRequest& request,
+                        std::vector<uint8_t> responseMsg)
+    {
+        OutputCapture capture;
+        if (request.interface->isVerbose())
+        {
+            std::cout << "pldmtool: ";
+            printBuffer(Rx, responseMsg);
+        }
+        request.interface->handleResponseMsg(responseMsg);
+        request.output += capture.output();
+        request.errors += capture.errors();
+        request.done = true;
+        request.tree.reset();
+    }
+
+    /** @brief Write the result of a script line as a single line of JSON */
+    void emit(size_t line, const std::string& command,
+              const std::string& output, const std::string& errors)
+    {
+        ordered_json result;
+        result["line"] = line;
+        result["command"] = command;
+        if (!output.empty())
+        {
+            auto parsed = ordered_json::parse(output, nullptr, false);
+            if (parsed.is_discarded())
+            {
+                result["output"] = output;
+            }
+            else
+            {
+                result["output"] = std::move(parsed);
+            }
+        }
+        if (!errors.empty())
+        {
+            result["error"] = errors;
+        }
+
+        std::ostream out(stdOut);
+        out << result.dump() << std::endl;
+    }
+
+    CommandSet commandSet;
+    std::string scriptFile;
+    size_t windowSize = 8;
+    int timeoutMs = RESPONSE_TIME_OUT;
+
+    /** @brief the original std::cout buffer, the results are written there */
+    std::streambuf* stdOut = nullptr;
+
+    /** @brief requests of the current window, in script order */
+    std::vector<PendingRequest> pending;
+
+    size_t currentLine = 0;
+    std::string currentCommand;
+    bool scheduled = false;
+};
+
+namespace
+{
+std::unique_ptr<Batch> batchCommand;
+}
+
+void registerCommand(CLI::App& app, CommandSet commandSet)
+{
+    auto batch = app.add_subcommand(
+        "batch", "run the pldmtool commands of a script in a single session, "
+                 "printing one JSON result per line");
+    batchCommand = std::make_unique<Batch>(batch, std::move(commandSet));
+}
+
+} // namespace batch
+
+} // namespace pldmtool
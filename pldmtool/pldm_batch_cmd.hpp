@@ -0,0 +1,35 @@
+#pragma once
+
+#include "pldm_cmd_helper.hpp"
+
+#include <CLI/CLI.hpp>
+
+#include <functional>
+
+namespace pldmtool
+{
+
+namespace batch
+{
+
+/** @struct CommandSet
+ *
+ *  Hooks used by the batch mode to build a fresh command tree for every line
+ *  of the script. Every line gets its own CLI::App and command objects, so
+ *  that a command still in flight keeps the options it was parsed with, and
+ *  they are released as soon as the line has completed.
+ */
+struct CommandSet
+{
+    /** @brief register all the pldmtool commands against an app */
+    std::function<void(CLI::App&, helper::Commands&)> registerCommands;
+
+    /** @brief post-parse processing, run after each line is parsed */
+    std::function<void(const helper::Commands&)> postParse;
+};
+
+void registerCommand(CLI::App& app, CommandSet commandSet);
+
+} // namespace batch
+
+} // namespace pldmtool
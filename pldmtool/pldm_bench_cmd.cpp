@@ -0,0 +1,605 @@
+#include "pldm_bench_cmd.hpp"
+
+#include "common/transport.hpp"
+#include "pldm_cmd_helper.hpp"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace bench
+{
+
+using namespace pldmtool::helper;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+/** @brief Maximum number of outstanding requests, bounded by the number of
+ *         PLDM instance IDs of an endpoint. The run is further limited to the
+ *         instance IDs the other requesters leave free.
+ */
+constexpr size_t maxConcurrency = 32;
+
+/** @class NullBuffer
+ *
+ *  Stream buffer discarding everything written to it, used to silence the
+ *  decoded output of the commands while the benchmark runs.
+ */
+class NullBuffer : public std::streambuf
+{
+  protected:
+    int overflow(int c) override
+    {
+        return c;
+    }
+};
+
+/** @struct MixEntry
+ *
+ *  A command of the benchmark mix and the statistics collected for it.
+ */
+struct MixEntry
+{
+    std::string command;
+    int weight;
+    int currentWeight;
+    uint64_t requests;
+    uint64_t errors;
+    std::vector<uint64_t> latencies;
+};
+
+/** @struct Slot
+ *
+ *  One outstanding request. Every slot has its own parsed copy of the mix, as
+ *  the instance ID of a request is held by its command.
+ */
+struct Slot
+{
+    std::vector<CommandInterface*> commands;
+    std::optional<size_t> inFlight;
+    std::vector<uint8_t> requestMsg;
+    Clock::time_point start;
+    Clock::time_point deadline;
+};
+
+/** @brief Summarize latencies in microseconds, using nearest-rank
+ *         percentiles
+ */
+ordered_json summarize(std::vector<uint64_t>& latencies)
+{
+    ordered_json summary;
+    if (latencies.empty())
+    {
+        return summary;
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p) {
+        auto rank = static_cast<size_t>(std::ceil(p * latencies.size()));
+        return latencies[std::max<size_t>(rank, 1) - 1];
+    };
+
+    uint64_t total = 0;
+    for (auto latency : latencies)
+    {
+        total += latency;
+    }
+
+    summary["min"] = latencies.front();
+    summary["mean"] = total / latencies.size();
+    summary["p50"] = percentile(0.50);
+    summary["p99"] = percentile(0.99);
+    summary["p999"] = percentile(0.999);
+    summary["max"] = latencies.back();
+    return summary;
+}
+
+/** @brief Count the instance IDs of an endpoint free in the instance ID
+ *         database, by allocating them all and releasing them again
+ */
+size_t freeInstanceIds(uint8_t eid)
+{
+    auto& instanceIdDb = getInstanceIdDb();
+    std::vector<uint8_t> ids;
+    try
+    {
+        while (ids.size() < maxConcurrency)
+        {
+            ids.push_back(instanceIdDb.next(eid));
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        // No free instance ids
+    }
+    for (auto id : ids)
+    {
+        instanceIdDb.free(eid, id);
+    }
+    return ids.size();
+}
+
+} // namespace
+
+class Bench
+{
+  public:
+    Bench() = delete;
+    Bench(const Bench&) = delete;
+    Bench& operator=(const Bench&) = delete;
+
+    explicit Bench(CLI::App* app, batch::CommandSet commandSet) :
+        commandSet(std::move(commandSet))
+    {
+        app->add_option("-c,--command", mix,
+                        "pldmtool command of the mix, e.g. \"platform "
+                        "GetSensorReading -i 1\", prefix with WEIGHT: to "
+                        "weight it, e.g. \"3:platform GetPDR -d 0\"")
+            ->required();
+        app->add_option("-m,--mctp_eid", mctpEid,
+                        "MCTP endpoint ID of all the commands of the mix");
+        app->add_option("-r,--rate", rate,
+                        "target request rate per second, 0 sends as fast as "
+                        "the concurrency allows");
+        app->add_option("-j,--concurrency", concurrency,
+                        "maximum number of requests in flight")
+            ->check(CLI::Range(size_t(1), maxConcurrency));
+        app->add_option("-d,--duration", durationSec,
+                        "duration of the run in seconds");
+        app->add_option("-n,--requests", maxRequests,
+                        "stop after sending this many requests, 0 for no "
+                        "limit");
+        app->add_option("-t,--timeout", timeoutMs,
+                        "response timeout in milliseconds");
+        app->callback([this]() { exec(); });
+    }
+
+    void exec()
+    {
+        if (!parseMix())
+        {
+            return;
+        }
+
+        auto& pldmTransport = getPldmTransport();
+        NullBuffer nullBuffer;
+        auto coutBuf = std::cout.rdbuf(&nullBuffer);
+        auto cerrBuf = std::cerr.rdbuf(&nullBuffer);
+
+        auto start = Clock::now();
+        auto end = start + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(durationSec));
+        std::optional<Clock::duration> period;
+        if (rate > 0)
+        {
+            period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / rate));
+        }
+        auto nextSend = start;
+        size_t inFlight = 0;
+        uint64_t sent = 0;
+        pollfd pfd{pldmTransport.getEventSource(), POLLIN, 0};
+
+        while (true)
+        {
+            auto now = Clock::now();
+            auto sending = [&]() {
+                return now < end && (maxRequests == 0 || sent < maxRequests);
+            };
+            if (!sending() && inFlight == 0)
+            {
+                break;
+            }
+
+            for (auto& slot : slots)
+            {
+                if (slot.inFlight && slot.deadline <= now)
+                {
+                    slot.commands[*slot.inFlight]->abandonRequest();
+                    ++mixEntries[*slot.inFlight].errors;
+                    ++timeoutErrors;
+                    slot.inFlight.reset();
+                    --inFlight;
+                }
+            }
+
+            for (auto& slot : slots)
+            {
+                if (!sending() || (period && nextSend > now))
+                {
+                    break;
+                }
+                if (slot.inFlight)
+                {
+                    continue;
+                }
+
+                auto index = pickCommand();
+                auto& command = *slot.commands[index];
+                auto& entry = mixEntries[index];
+                ++entry.requests;
+                ++sent;
+
+                // In rate mode latency is measured from the scheduled send
+                // time, so that a stalled responder is not hidden by the
+                // requests it delayed.
+                slot.start = period ? nextSend : now;
+                if (period)
+                {
+                    nextSend += *period;
+                }
+
+                std::pair<int, std::vector<uint8_t>> request;
+                try
+                {
+                    request = command.prepareRequestMsg();
+                }
+                catch (const std::exception&)
+                {
+                    // another requester took the instance IDs of the endpoint
+                    ++entry.errors;
+                    ++instanceIdErrors;
+                    continue;
+                }
+                auto& [rc, requestMsg] = request;
+                if (rc != PLDM_SUCCESS)
+                {
+                    ++entry.errors;
+                    ++encodeErrors;
+                    continue;
+                }
+
+                if (pldmTransport.sendMsg(command.getMCTPEID(),
+                                          requestMsg.data(),
+                                          requestMsg.size()) !=
+                    PLDM_REQUESTER_SUCCESS)
+                {
+                    command.abandonRequest();
+                    ++entry.errors;
+                    ++sendErrors;
+                    continue;
+                }
+
+                slot.requestMsg = std::move(requestMsg);
+                slot.deadline = now + std::chrono::milliseconds(timeoutMs);
+                slot.inFlight = index;
+                ++inFlight;
+            }
+
+            auto wakeup = Clock::time_point::max();
+            for (const auto& slot : slots)
+            {
+                if (slot.inFlight)
+                {
+                    wakeup = std::min(wakeup, slot.deadline);
+                }
+            }
+            if (sending())
+            {
+                wakeup = std::min(wakeup, end);
+                if (period && inFlight < slots.size())
+                {
+                    wakeup = std::min(wakeup, nextSend);
+                }
+            }
+            if (inFlight == 0 && !period)
+            {
+                // every request failed before being sent, retry right away
+                continue;
+            }
+
+            auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::max(wakeup - now, Clock::duration::zero()));
+            timespec timeout{
+                static_cast<time_t>(wait.count() / 1'000'000'000),
+                static_cast<long>(wait.count() % 1'000'000'000)};
+            auto ret = ppoll(&pfd, 1, &timeout, nullptr);
+            if (ret < 0 && errno != EINTR)
+            {
+                break;
+            }
+            if (ret > 0)
+            {
+                receive(pldmTransport, inFlight);
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+        std::cout.rdbuf(coutBuf);
+        std::cerr.rdbuf(cerrBuf);
+
+        report(sent, elapsed.count());
+    }
+
+  private:
+    /** @brief Parse the commands of the mix, once per slot. The concurrency
+     *         is clamped to the instance IDs free for the endpoints of the mix.
+     *
+     *  @return false if a command is invalid
+     */
+    bool parseMix()
+    {
+        for (auto command : mix)
+        {
+            int weight = 1;
+            auto colon = command.find(':');
+            if (colon != std::string::npos && colon > 0 &&
+                std::all_of(command.begin(), command.begin() + colon,
+                            [](unsigned char c) { return std::isdigit(c); }))
+            {
+                weight = std::stoi(command.substr(0, colon));
+                command.erase(0, colon + 1);
+            }
+            if (mctpEid)
+            {
+                command += " -m " + std::to_string(*mctpEid);
+            }
+            mixEntries.emplace_back(
+                MixEntry{std::move(command), weight, 0, 0, 0, {}});
+        }
+
+        slots.resize(1);
+        if (!parseSlot(slots.front()))
+        {
+            return false;
+        }
+
+        for (auto command : slots.front().commands)
+        {
+            auto eid = command->getMCTPEID();
+            auto freeIds = freeInstanceIds(eid);
+            if (freeIds == 0)
+            {
+                std::cerr << "No free instance IDs for MCTP endpoint "
+                          << static_cast<int>(eid) << "\n";
+                return false;
+            }
+            if (freeIds < concurrency)
+            {
+                std::cerr << "Limiting the concurrency to " << freeIds
+                          << ", the free instance IDs of MCTP endpoint "
+                          << static_cast<int>(eid) << "\n";
+                concurrency = freeIds;
+            }
+        }
+
+        slots.resize(concurrency);
+        for (auto& slot : slots | std::views::drop(1))
+        {
+            if (!parseSlot(slot))
+            {
+                return false;
+            }
+        }
+
+        // option processing run after the parse, like GetPDR -i looking up
+        // the PDRs of the terminus, silenced as its output isn't measured
+        NullBuffer nullBuffer;
+        auto coutBuf = std::cout.rdbuf(&nullBuffer);
+        try
+        {
+            commandSet.postParse(registry);
+        }
+        catch (const std::exception& e)
+        {
+            std::cout.rdbuf(coutBuf);
+            std::cerr << "Unable to set up the commands: " << e.what() << "\n";
+            return false;
+        }
+        std::cout.rdbuf(coutBuf);
+
+        return true;
+    }
+
+    /** @brief Parse a copy of the commands of the mix for a slot
+     *
+     *  @return false if a command is invalid
+     */
+    bool parseSlot(Slot& slot)
+    {
+        CommandInterface* parsed = nullptr;
+        CommandInterface::setScheduler([&parsed](CommandInterface& command) {
+            parsed = &command;
+            return true;
+        });
+
+        for (const auto& entry : mixEntries)
+        {
+            parsed = nullptr;
+            auto app = std::make_unique<CLI::App>("pldmtool bench command");
+            app->require_subcommand(1)->ignore_case();
+            commandSet.registerCommands(*app, registry);
+            try
+            {
+                app->parse(entry.command, false);
+            }
+            catch (const CLI::ParseError& e)
+            {
+                std::cerr << "Invalid command '" << entry.command
+                          << "': " << e.what() << "\n";
+                CommandInterface::setScheduler(nullptr);
+                return false;
+            }
+            apps.push_back(std::move(app));
+
+            if (parsed == nullptr || !parsed->init())
+            {
+                std::cerr << "Unable to benchmark '" << entry.command
+                          << "'\n";
+                CommandInterface::setScheduler(nullptr);
+                return false;
+            }
+            slot.commands.push_back(parsed);
+        }
+
+        CommandInterface::setScheduler(nullptr);
+        return true;
+    }
+
+    /** @brief Pick the next command of the mix, smooth weighted round robin
+     *
+     *  @return index of the command in the mix
+     */
+    size_t pickCommand()
+    {
+        int total = 0;
+        size_t picked = 0;
+        for (size_t i = 0; i < mixEntries.size(); ++i)
+        {
+            mixEntries[i].currentWeight += mixEntries[i].weight;
+            total += mixEntries[i].weight;
+            if (mixEntries[i].currentWeight > mixEntries[picked].currentWeight)
+            {
+                picked = i;
+            }
+        }
+        mixEntries[picked].currentWeight -= total;
+        return picked;
+    }
+
+    /** @brief Receive a message and complete the request it responds to */
+    void receive(PldmTransport& pldmTransport, size_t& inFlight)
+    {
+        pldm_tid_t tid{};
+        void* responseMessage = nullptr;
+        size_t responseMessageSize{};
+        if (pldmTransport.recvMsg(tid, responseMessage, responseMessageSize) !=
+            PLDM_REQUESTER_SUCCESS)
+        {
+            return;
+        }
+        auto now = Clock::now();
+
+        if (responseMessageSize > sizeof(pldm_msg_hdr))
+        {
+            auto hdr = static_cast<const pldm_msg_hdr*>(responseMessage);
+            auto slot = std::ranges::find_if(slots, [&](const auto& slot) {
+                if (!slot.inFlight)
+                {
+                    return false;
+                }
+                auto reqHdr =
+                    reinterpret_cast<const pldm_msg_hdr*>(slot.requestMsg.data());
+                return !hdr->request &&
+                       slot.commands[*slot.inFlight]->getMCTPEID() == tid &&
+                       hdr->instance_id == reqHdr->instance_id &&
+                       hdr->type == reqHdr->type &&
+                       hdr->command == reqHdr->command;
+            });
+            if (slot != slots.end())
+            {
+                auto index = *slot->inFlight;
+                auto& entry = mixEntries[index];
+                auto data = static_cast<const uint8_t*>(responseMessage);
+                std::vector<uint8_t> responseMsg(data,
+                                                 data + responseMessageSize);
+                if (responseMsg[sizeof(pldm_msg_hdr)] != PLDM_SUCCESS)
+                {
+                    ++entry.errors;
+                    ++completionCodeErrors;
+                }
+                entry.latencies.push_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        now - slot->start)
+                        .count());
+                slot->commands[index]->handleResponseMsg(responseMsg);
+                slot->inFlight.reset();
+                --inFlight;
+            }
+        }
+        free(responseMessage);
+    }
+
+    /** @brief Print the results of the run as JSON */
+    void report(uint64_t sent, double elapsed)
+    {
+        std::vector<uint64_t> latencies;
+        ordered_json commands = ordered_json::array();
+        for (auto& entry : mixEntries)
+        {
+            latencies.insert(latencies.end(), entry.latencies.begin(),
+                             entry.latencies.end());
+            ordered_json command;
+            command["command"] = entry.command;
+            command["weight"] = entry.weight;
+            command["requests"] = entry.requests;
+            command["responses"] = entry.latencies.size();
+            command["errors"] = entry.errors;
+            command["latency_us"] = summarize(entry.latencies);
+            commands.emplace_back(std::move(command));
+        }
+
+        ordered_json result;
+        result["duration_s"] = elapsed;
+        result["concurrency"] = concurrency;
+        result["target_rate"] = rate;
+        result["requests"] = sent;
+        result["responses"] = latencies.size();
+        result["throughput_rps"] = elapsed > 0 ? latencies.size() / elapsed
+                                               : 0.0;
+        result["errors"] = {{"encode", encodeErrors},
+                            {"send", sendErrors},
+                            {"timeout", timeoutErrors},
+                            {"instance_id", instanceIdErrors},
+                            {"completion_code", completionCodeErrors}};
+        result["latency_us"] = summarize(latencies);
+        result["commands"] = std::move(commands);
+        DisplayInJson(result);
+    }
+
+    batch::CommandSet commandSet;
+    std::vector<std::string> mix;
+    std::optional<uint8_t> mctpEid;
+    double rate = 0;
+    size_t concurrency = 1;
+    double durationSec = 10;
+    uint64_t maxRequests = 0;
+    int timeoutMs = RESPONSE_TIME_OUT;
+
+    std::vector<MixEntry> mixEntries;
+    std::vector<Slot> slots;
+
+    /** @brief the commands of the slots and the CLI::App objects they were
+     *         parsed with, the apps are declared last to be destroyed first
+     */
+    Commands registry;
+    std::vector<std::unique_ptr<CLI::App>> apps;
+
+    uint64_t encodeErrors = 0;
+    uint64_t sendErrors = 0;
+    uint64_t timeoutErrors = 0;
+    uint64_t instanceIdErrors = 0;
+    uint64_t completionCodeErrors = 0;
+};
+
+namespace
+{
+std::unique_ptr<Bench> benchCommand;
+}
+
+void registerCommand(CLI::App& app, batch::CommandSet commandSet)
+{
+    auto bench = app.add_subcommand(
+        "bench", "drive a mix of commands against an endpoint and report the "
+                 "latency and throughput");
+    benchCommand = std::make_unique<Bench>(bench, std::move(commandSet));
+}
+
+} // namespace bench
+
+} // namespace pldmtool
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pldm_batch_cmd.hpp"
+
+#include <CLI/CLI.hpp>
+
+namespace pldmtool
+{
+
+namespace bench
+{
+
+void registerCommand(CLI::App& app, batch::CommandSet commandSet);
+
+} // namespace bench
+
+} // namespace pldmtool
@@ -23,8 +23,6 @@ using namespace pldmtool::helper;
 using namespace pldm::bios::utils;
 using namespace pldm::utils;
 
-std::vector<std::unique_ptr<CommandInterface>> commands;
-
 const std::map<const char*, pldm_bios_table_types> pldmBIOSTableTypes{
     {"StringTable", PLDM_BIOS_STRING_TABLE},
     {"AttributeTable", PLDM_BIOS_ATTR_TABLE},
@@ -193,6 +191,11 @@ class GetBIOSTableHandler : public CommandInterface
 
     void parseResponseMsg(pldm_msg*, size_t) override {}
 
+    bool isPipelinable() const override
+    {
+        return false;
+    }
+
     std::optional<Table> getBIOSTable(pldm_bios_table_types tableType)
     {
         std::vector<uint8_t> requestMsg(
@@ -690,53 +693,54 @@ class GetBIOSAttributeCurrentValueByHandle : public GetBIOSTableHandler
             ->required();
     }
 
-    void exec()
+    bool init() override
     {
-        auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-        auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+        stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+        attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
 
         if (!stringTable || !attrTable)
         {
             std::cout << "StringTable/AttrTable Unavailable" << std::endl;
-            return;
+            return false;
         }
 
-        auto handle = findAttrHandleByName(attrName, *attrTable, *stringTable);
-        if (!handle)
+        attrHandle = findAttrHandleByName(attrName, *attrTable, *stringTable);
+        if (!attrHandle)
         {
             std::cerr << "Can not find the attribute " << attrName << std::endl;
-            return;
+            return false;
+        }
+
+        return true;
+    }
+
+    void exec() override
+    {
+        if (init())
+        {
+            CommandInterface::exec();
         }
+    }
 
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
         std::vector<uint8_t> requestMsg(
             sizeof(pldm_msg_hdr) +
             PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_REQ_BYTES);
         auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
 
         auto rc = encode_get_bios_attribute_current_value_by_handle_req(
-            instanceId, 0, PLDM_GET_FIRSTPART, *handle, request);
-        if (rc != PLDM_SUCCESS)
-        {
-            std::cerr << "PLDM: Request Message Error, rc =" << rc << std::endl;
-            return;
-        }
-
-        std::vector<uint8_t> responseMsg;
-        rc = pldmSendRecv(requestMsg, responseMsg);
-        if (rc != PLDM_SUCCESS)
-        {
-            std::cerr << "PLDM: Communication Error, rc =" << rc << std::endl;
-            return;
-        }
+            instanceId, 0, PLDM_GET_FIRSTPART, *attrHandle, request);
+        return {rc, requestMsg};
+    }
 
+    void parseResponseMsg(pldm_msg* responsePtr, size_t payloadLength) override
+    {
         uint8_t cc = 0, transferFlag = 0;
         uint32_t nextTransferHandle = 0;
         struct variable_field attributeData;
-        auto responsePtr =
-            reinterpret_cast<struct pldm_msg*>(responseMsg.data());
-        auto payloadLength = responseMsg.size() - sizeof(pldm_msg_hdr);
 
-        rc = decode_get_bios_attribute_current_value_by_handle_resp(
+        auto rc = decode_get_bios_attribute_current_value_by_handle_resp(
             responsePtr, payloadLength, &cc, &nextTransferHandle, &transferFlag,
             &attributeData);
         if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
@@ -758,6 +762,9 @@ class GetBIOSAttributeCurrentValueByHandle : public GetBIOSTableHandler
 
   private:
     std::string attrName;
+    std::optional<Table> stringTable;
+    std::optional<Table> attrTable;
+    std::optional<uint16_t> attrHandle;
 };
 
 class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
@@ -954,7 +961,7 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
     std::string attrValue;
 };
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto bios = app.add_subcommand("bios", "bios type command");
     bios->require_subcommand(1);
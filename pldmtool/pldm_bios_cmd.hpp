@@ -1,4 +1,7 @@
 #pragma once
+
+#include "pldm_cmd_helper.hpp"
+
 #include <CLI/CLI.hpp>
 
 namespace pldmtool
@@ -7,7 +10,7 @@ namespace pldmtool
 namespace bios
 {
 
-void registerCommand(CLI::App& app);
+void registerCommand(CLI::App& app, helper::Commands& commands);
 
 } // namespace bios
 
@@ -21,15 +21,23 @@ namespace pldmtool
 namespace helper
 {
 
+PldmTransport& getPldmTransport()
+{
+    static PldmTransport pldmTransport{};
+    return pldmTransport;
+}
+
+pldm::InstanceIdDb& getInstanceIdDb()
+{
+    static pldm::InstanceIdDb instanceIdDb{};
+    return instanceIdDb;
+}
+
 void CommandInterface::exec()
 {
-    instanceId = instanceIdDb.next(mctp_eid);
-    auto [rc, requestMsg] = createRequestMsg();
+    auto [rc, requestMsg] = prepareRequestMsg();
     if (rc != PLDM_SUCCESS)
     {
-        instanceIdDb.free(mctp_eid, instanceId);
-        std::cerr << "Failed to encode request message for " << pldmType << ":"
-                  << commandName << " rc = " << rc << "\n";
         return;
     }
 
@@ -38,16 +46,41 @@ void CommandInterface::exec()
 
     if (rc != PLDM_SUCCESS)
     {
-        instanceIdDb.free(mctp_eid, instanceId);
+        abandonRequest();
         std::cerr << "pldmSendRecv: Failed to receive RC = " << rc << "\n";
         return;
     }
 
+    handleResponseMsg(responseMsg);
+}
+
+std::pair<int, std::vector<uint8_t>> CommandInterface::prepareRequestMsg()
+{
+    instanceId = instanceIdDb.next(mctp_eid);
+    auto [rc, requestMsg] = createRequestMsg();
+    if (rc != PLDM_SUCCESS)
+    {
+        instanceIdDb.free(mctp_eid, instanceId);
+        std::cerr << "Failed to encode request message for " << pldmType << ":"
+                  << commandName << " rc = " << rc << "\n";
+        return {rc, {}};
+    }
+
+    return {rc, requestMsg};
+}
+
+void CommandInterface::handleResponseMsg(std::vector<uint8_t>& responseMsg)
+{
     auto responsePtr = reinterpret_cast<struct pldm_msg*>(responseMsg.data());
     parseResponseMsg(responsePtr, responseMsg.size() - sizeof(pldm_msg_hdr));
     instanceIdDb.free(mctp_eid, instanceId);
 }
 
+void CommandInterface::abandonRequest()
+{
+    instanceIdDb.free(mctp_eid, instanceId);
+}
+
 int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
                                    std::vector<uint8_t>& responseMsg)
 {
@@ -64,7 +97,7 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
     }
 
     auto tid = mctp_eid;
-    PldmTransport pldmTransport{};
+    auto& pldmTransport = getPldmTransport();
     uint8_t retry = 0;
     int rc = PLDM_ERROR;
 
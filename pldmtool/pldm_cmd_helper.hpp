@@ -16,9 +16,14 @@
 #include <nlohmann/json.hpp>
 
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <utility>
+#include <vector>
+
+class PldmTransport;
 
 namespace pldmtool
 {
@@ -73,19 +78,45 @@ static inline void DisplayInJson(const ordered_json& data)
 int mctpSockSendRecv(const std::vector<uint8_t>& requestMsg,
                      std::vector<uint8_t>& responseMsg, bool pldmVerbose);
 
+/** @brief Get the PLDM transport shared by all the commands of the process
+ *
+ *  @return PldmTransport - the transport, created on first use
+ */
+PldmTransport& getPldmTransport();
+
+/** @brief Get the instance ID database shared by all the commands of the
+ *         process
+ *
+ *  @return pldm::InstanceIdDb - the instance ID database, opened on first use
+ */
+pldm::InstanceIdDb& getInstanceIdDb();
+
+class CommandInterface;
+
+/** @brief Hook invoked instead of exec() when a command is parsed. It returns
+ *         true if it took over the request/response exchange of the command,
+ *         false if the command has to be executed synchronously.
+ */
+using CommandScheduler = std::function<bool(CommandInterface&)>;
+
 class CommandInterface
 {
   public:
     explicit CommandInterface(const char* type, const char* name,
                               CLI::App* app) :
         pldmType(type), commandName(name), mctp_eid(PLDM_ENTITY_ID),
-        pldmVerbose(false), instanceId(0)
+        pldmVerbose(false), instanceId(0), instanceIdDb(getInstanceIdDb())
     {
         app->add_option("-m,--mctp_eid", mctp_eid, "MCTP endpoint ID");
         app->add_flag("-v, --verbose", pldmVerbose);
         app->add_option("-n, --retry-count", numRetries,
                         "Number of retry when PLDM request message is failed");
-        app->callback([&]() { exec(); });
+        app->callback([&]() {
+            if (!scheduler || !scheduler(*this))
+            {
+                exec();
+            }
+        });
     }
 
     virtual ~CommandInterface() = default;
@@ -97,9 +128,62 @@ class CommandInterface
 
     virtual void exec();
 
+    /** @brief Whether the command is a single request/response exchange
+     *         that can be sent without waiting for the responses of other
+     *         commands. Commands overriding exec() to chain several
+     *         exchanges must return false.
+     *
+     *  @return true if the command can be pipelined
+     */
+    virtual bool isPipelinable() const
+    {
+        return true;
+    }
+
+    /** @brief One-time setup needed before the request of the command can be
+     *         encoded, such as resolving a name to a handle. Commands doing
+     *         such lookups override it so that the request/response exchange
+     *         can be repeated on its own.
+     *
+     *  @return false if the command cannot be sent
+     */
+    virtual bool init()
+    {
+        return true;
+    }
+
+    /** @brief Allocate an instance ID and encode the request message, the
+     *         first half of exec()
+     *
+     *  @return PLDM_SUCCESS and the request message on success, the instance
+     *          ID is released on failure
+     */
+    std::pair<int, std::vector<uint8_t>> prepareRequestMsg();
+
+    /** @brief Decode the response message and release the instance ID, the
+     *         second half of exec()
+     *
+     *  @param[in] responseMsg - response message matching the request
+     */
+    void handleResponseMsg(std::vector<uint8_t>& responseMsg);
+
+    /** @brief Release the instance ID of a request that got no response
+     */
+    void abandonRequest();
+
     int pldmSendRecv(std::vector<uint8_t>& requestMsg,
                      std::vector<uint8_t>& responseMsg);
 
+    /** @brief Set the hook invoked when a command is parsed, used by the batch
+     *         mode to pipeline requests
+     *
+     *  @param[in] hook - scheduler, or nullptr to execute synchronously
+     */
+    static void setScheduler(CommandScheduler hook)
+    {
+        scheduler = std::move(hook);
+    }
+
     /**
      * @brief get MCTP endpoint ID
      *
@@ -130,17 +214,46 @@ class CommandInterface
         return commandName;
     }
 
+    /**
+     * @brief whether the request and response messages are to be printed,
+     *        always the case for raw commands
+     *
+     * @return true if verbose
+     */
+    inline bool isVerbose()
+    {
+        return pldmVerbose || pldmType == "raw";
+    }
+
+    /**
+     * @brief get the instance ID of the outstanding request
+     *
+     * @return uint8_t - PLDM instance ID
+     */
+    inline uint8_t getInstanceId()
+    {
+        return instanceId;
+    }
+
   private:
     const std::string pldmType;
     const std::string commandName;
     uint8_t mctp_eid;
     bool pldmVerbose;
 
+    /** @brief scheduler hook, see setScheduler() */
+    static inline CommandScheduler scheduler;
+
   protected:
     uint8_t instanceId;
-    pldm::InstanceIdDb instanceIdDb;
+    pldm::InstanceIdDb& instanceIdDb;
     uint8_t numRetries = 0;
 };
 
+/** @brief The commands registered against a CLI::App, they have to outlive
+ *         the app as its callbacks run them
+ */
+using Commands = std::vector<std::unique_ptr<CommandInterface>>;
+
 } // namespace helper
 } // namespace pldmtool
@@ -22,8 +22,6 @@ namespace
 
 using namespace pldmtool::helper;
 
-std::vector<std::unique_ptr<CommandInterface>> commands;
-
 } // namespace
 
 class GetFruRecordTableMetadata : public CommandInterface
@@ -410,6 +408,27 @@ class GetFruRecordTable : public CommandInterface
     GetFruRecordTable& operator=(GetFruRecordTable&&) = delete;
 
     using CommandInterface::CommandInterface;
+
+    bool isPipelinable() const override
+    {
+        return false;
+    }
+
+    void exec() override
+    {
+        // The table is transferred in parts, the data transfer handle of the
+        // next part is returned with each part
+        dataTransferHandle = 0;
+        operationFlag = PLDM_GET_FIRSTPART;
+        tableData.clear();
+        parts = 0;
+        do
+        {
+            nextPartRequired = false;
+            CommandInterface::exec();
+        } while (nextPartRequired);
+    }
+
     std::pair<int, std::vector<uint8_t>> createRequestMsg() override
     {
         std::vector<uint8_t> requestMsg(
@@ -417,7 +436,7 @@ class GetFruRecordTable : public CommandInterface
         auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
 
         auto rc = encode_get_fru_record_table_req(
-            instanceId, 0, PLDM_GET_FIRSTPART, request,
+            instanceId, dataTransferHandle, operationFlag, request,
             requestMsg.size() - sizeof(pldm_msg_hdr));
         return {rc, requestMsg};
     }
@@ -441,13 +460,42 @@ class GetFruRecordTable : public CommandInterface
             return;
         }
 
-        FRUTablePrint tablePrint(fru_record_table_data.data(),
-                                 fru_record_table_length);
+        tableData.insert(tableData.end(), fru_record_table_data.begin(),
+                         fru_record_table_data.begin() +
+                             fru_record_table_length);
+
+        if (transfer_flag == PLDM_START || transfer_flag == PLDM_MIDDLE)
+        {
+            // The data transfer handles are opaque, a responder that never
+            // sends the last part is only caught by the size of the transfer
+            if (++parts >= maxParts || tableData.size() > maxTableSize)
+            {
+                std::cerr << "FRU record table transfer exceeds " << maxParts
+                          << " parts or " << maxTableSize << " bytes\n";
+                return;
+            }
+            nextPartRequired = true;
+            dataTransferHandle = next_data_transfer_handle;
+            operationFlag = PLDM_GET_NEXTPART;
+            return;
+        }
+
+        FRUTablePrint tablePrint(tableData.data(), tableData.size());
         tablePrint.print();
     }
+
+  private:
+    static constexpr size_t maxParts = 4096;
+    static constexpr size_t maxTableSize = 16 * 1024 * 1024;
+
+    uint32_t dataTransferHandle = 0;
+    uint8_t operationFlag = PLDM_GET_FIRSTPART;
+    bool nextPartRequired = false;
+    size_t parts = 0;
+    std::vector<uint8_t> tableData;
 };
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto fru = app.add_subcommand("fru", "FRU type command");
     fru->require_subcommand(1);
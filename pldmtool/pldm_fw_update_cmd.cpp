@@ -17,8 +17,6 @@ namespace
 using namespace pldmtool::helper;
 using namespace pldm::fw_update;
 
-std::vector<std::unique_ptr<CommandInterface>> commands;
-
 } // namespace
 
 const std::map<uint8_t, std::string> fdStateMachine{
@@ -611,7 +609,7 @@ void QueryDeviceIdentifiers::parseResponseMsg(pldm_msg* responsePtr,
     pldmtool::helper::DisplayInJson(data);
 }
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto fwUpdate =
         app.add_subcommand("fw_update", "firmware update type commands");
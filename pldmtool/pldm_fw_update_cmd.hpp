@@ -1,5 +1,7 @@
 #pragma once
 
+#include "pldm_cmd_helper.hpp"
+
 #include <CLI/CLI.hpp>
 
 namespace pldmtool
@@ -8,7 +10,7 @@ namespace pldmtool
 namespace fw_update
 {
 
-void registerCommand(CLI::App& app);
+void registerCommand(CLI::App& app, helper::Commands& commands);
 
 } // namespace fw_update
 
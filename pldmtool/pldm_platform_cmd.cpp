@@ -68,7 +68,6 @@ std::string getEffecterOpState(uint8_t state)
                                            : std::to_string(state);
 }
 
-std::vector<std::unique_ptr<CommandInterface>> commands;
 
 } // namespace
 
@@ -122,6 +121,11 @@ class GetPDR : public CommandInterface
         pdrOptionGroup->require_option(1);
     }
 
+    bool isPipelinable() const override
+    {
+        return false;
+    }
+
     void parseGetPDROptions()
     {
         optTIDSet = false;
@@ -2220,7 +2224,7 @@ class GetNumericEffecterValue : public CommandInterface
     uint16_t effecterId;
 };
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto platform = app.add_subcommand("platform", "platform type command");
     platform->require_subcommand(1);
@@ -2260,7 +2264,7 @@ void registerCommand(CLI::App& app)
         "platform", "getStateEffecterStates", getStateEffecterStates));
 }
 
-void parseGetPDROption()
+void parseGetPDROption(const Commands& commands)
 {
     for (const auto& command : commands)
     {
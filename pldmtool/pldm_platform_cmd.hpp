@@ -1,5 +1,7 @@
 #pragma once
 
+#include "pldm_cmd_helper.hpp"
+
 #include <CLI/CLI.hpp>
 
 namespace pldmtool
@@ -8,12 +10,12 @@ namespace pldmtool
 namespace platform
 {
 
-void registerCommand(CLI::App& app);
+void registerCommand(CLI::App& app, helper::Commands& commands);
 
 /*@brief method to parse the command line option for
    get PDR command.
 */
-void parseGetPDROption();
+void parseGetPDROption(const helper::Commands& commands);
 
 void getPDRs();
 
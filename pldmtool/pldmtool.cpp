@@ -1,4 +1,6 @@
 #include "pldm_base_cmd.hpp"
+#include "pldm_batch_cmd.hpp"
+#include "pldm_bench_cmd.hpp"
 #include "pldm_bios_cmd.hpp"
 #include "pldm_cmd_helper.hpp"
 #include "pldm_fru_cmd.hpp"
@@ -16,11 +18,6 @@ namespace raw
 
 using namespace pldmtool::helper;
 
-namespace
-{
-std::vector<std::unique_ptr<CommandInterface>> commands;
-}
-
 class RawOp : public CommandInterface
 {
   public:
@@ -53,7 +50,7 @@ class RawOp : public CommandInterface
     std::vector<uint8_t> rawData;
 };
 
-void registerCommand(CLI::App& app)
+void registerCommand(CLI::App& app, Commands& commands)
 {
     auto raw =
         app.add_subcommand("raw", "send a raw request and print response");
@@ -61,25 +58,36 @@ void registerCommand(CLI::App& app)
 }
 
 } // namespace raw
+
+void registerCommands(CLI::App& app, helper::Commands& commands)
+{
+    raw::registerCommand(app, commands);
+    base::registerCommand(app, commands);
+    bios::registerCommand(app, commands);
+    platform::registerCommand(app, commands);
+    fru::registerCommand(app, commands);
+    fw_update::registerCommand(app, commands);
+
+#ifdef OEM_IBM
+    oem_ibm::registerCommand(app, commands);
+#endif
+}
+
 } // namespace pldmtool
 
 int main(int argc, char** argv)
 {
+    pldmtool::helper::Commands commands;
     CLI::App app{"PLDM requester tool for OpenBMC"};
     app.require_subcommand(1)->ignore_case();
 
-    pldmtool::raw::registerCommand(app);
-    pldmtool::base::registerCommand(app);
-    pldmtool::bios::registerCommand(app);
-    pldmtool::platform::registerCommand(app);
-    pldmtool::fru::registerCommand(app);
-    pldmtool::fw_update::registerCommand(app);
-
-#ifdef OEM_IBM
-    pldmtool::oem_ibm::registerCommand(app);
-#endif
+    pldmtool::registerCommands(app, commands);
+    pldmtool::batch::CommandSet commandSet{
+        pldmtool::registerCommands, pldmtool::platform::parseGetPDROption};
+    pldmtool::batch::registerCommand(app, commandSet);
+    pldmtool::bench::registerCommand(app, commandSet);
 
     CLI11_PARSE(app, argc, argv);
-    pldmtool::platform::parseGetPDROption();
+    pldmtool::platform::parseGetPDROption(commands);
     return 0;
 }
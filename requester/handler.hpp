@@ -4,6 +4,7 @@
 #include "common/transport.hpp"
 #include "common/types.hpp"
 #include "request.hpp"
+#include "retry_policy.hpp"
 
 #include <libpldm/base.h>
 #include <sys/socket.h>
@@ -14,12 +15,15 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <chrono>
-#include <deque>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <tuple>
 #include <unordered_map>
@@ -78,32 +82,256 @@ using ResponseHandler = std::function<void(
  */
 using SendRecvCoResp = std::tuple<int, const pldm_msg*, size_t>;
 
-/** @struct RegisteredRequest
+/** @enum RequestPriority
  *
- *  This struct is used to store the registered request to one endpoint.
+ *  Priority lanes of the requests queued to an endpoint, in decreasing
+ *  priority order.
  */
-struct RegisteredRequest
+enum class RequestPriority : uint8_t
 {
-    RequestKey key;                  //!< Responder MCTP endpoint ID
-    std::vector<uint8_t> reqMsg;     //!< Request messages queue
-    ResponseHandler responseHandler; //!< Waiting for response flag
+    Control, //!< Effecter sets, event receiver and firmware update control
+    Event,   //!< Platform event messages
+    Polling, //!< Periodic monitoring, the default
+    Bulk,    //!< PDR, FRU and other large transfers
+};
+
+/** @brief Number of request priority lanes */
+constexpr size_t numRequestPriorities =
+    static_cast<size_t>(RequestPriority::Bulk) + 1;
+
+/** @brief Number of requests sent from higher priority lanes while a lower
+ *         priority lane is waiting, before that lane is served once
+ */
+constexpr uint8_t requestStarvationLimit = 8;
+
+/** @brief Number of PLDM instance IDs of a terminus */
+constexpr size_t numInstanceIds = 32;
+
+/** @brief Maximum number of requests in flight to one endpoint, bounded by
+ *         the PLDM instance IDs of a terminus
+ */
+constexpr uint8_t maxRequestWindowSize = numInstanceIds;
+
+/** @brief Index terminating the request lanes */
+constexpr uint8_t noRequestSlot = 0xFF;
+
+using RequestClock = std::chrono::steady_clock;
+
+/** @struct RequestSlot
+ *
+ *  A request registered to an endpoint, kept in the slot of its instance ID
+ *  from registration until the response or the instance ID expiry. The slots
+ *  are reused, queueing and sending a request doesn't allocate.
+ *
+ * @tparam RequestInterface - Request class type
+ */
+template <class RequestInterface>
+struct RequestSlot
+{
+    enum class State : uint8_t
+    {
+        Free,
+        Queued,
+        InFlight,
+    };
+
+    State state = State::Free;       //!< Stage of the request
+    RequestKey key{};                //!< Key of the request
+    RequestPriority priority = RequestPriority::Polling; //!< Priority lane
+    uint8_t next = noRequestSlot;    //!< Next queued slot of the lane
+    pldm::Request reqMsg{};          //!< Request message until it is sent
+    ResponseHandler responseHandler; //!< Response handler of the request
+    std::optional<RequestInterface> request; //!< The request in flight
+    RequestClock::time_point sentTime{};     //!< Time the request was sent
+    RequestClock::time_point retryTime{};    //!< Next retry, max if none
+    RequestClock::time_point expiryTime{};   //!< Instance ID expiry
+    std::chrono::milliseconds timeout{};     //!< Time to wait per retry
+    bool adaptive = false; //!< timeout derived from the round-trip times
+    bool retried = false;  //!< the request was sent more than once
+};
+
+/** @struct RequestLane
+ *
+ *  The queued requests of one priority to an endpoint, linked through the
+ *  request slots in registration order.
+ */
+struct RequestLane
+{
+    uint8_t head = noRequestSlot; //!< First queued slot
+    uint8_t tail = noRequestSlot; //!< Last queued slot
+    uint8_t lastType = 0xFF;      //!< PLDM type of the last request sent
+    uint8_t skipped = 0;          //!< Requests sent from higher lanes meanwhile
+
+    bool empty() const
+    {
+        return head == noRequestSlot;
+    }
 };
 
 /** @struct EndpointMessageQueue
  *
- *  This struct is used to save the list of request messages of one endpoint and
- *  the existing of the request message to the endpoint with its' EID.
+ *  This struct is used to save the request slots of one endpoint, indexed by
+ *  instance ID, and the lanes of the queued requests. The queued requests
+ *  are served by priority, a lower priority lane skipped
+ *  requestStarvationLimit times in a row is served once. Within a lane the
+ *  PLDM types are served round robin, so that a burst of requests of one type
+ *  does not hold back the other callers.
+ *
+ * @tparam RequestInterface - Request class type
  */
+template <class RequestInterface>
 struct EndpointMessageQueue
 {
+    using Slot = RequestSlot<RequestInterface>;
+
     mctp_eid_t eid; //!< Responder MCTP endpoint ID
-    std::deque<std::shared_ptr<RegisteredRequest>> requestQueue; //!< Queue
-    bool activeRequest; //!< Waiting for response flag
+    std::array<Slot, numInstanceIds> slots{};              //!< Requests
+    std::array<RequestLane, numRequestPriorities> lanes{}; //!< Queues
+    uint8_t windowSize = 1; //!< Maximum number of requests in flight
+    uint8_t inFlight = 0;   //!< Number of requests waiting for a response
+    RttEstimator rtt{};     //!< Round-trip times of the endpoint
 
     bool operator==(const mctp_eid_t& mctpEid) const
     {
         return (eid == mctpEid);
     }
+
+    /** @brief Queue a request in the lane of its priority
+     *
+     *  @param[in] index - slot of the request
+     */
+    void push(uint8_t index)
+    {
+        auto& lane = lanes[static_cast<size_t>(slots[index].priority)];
+        slots[index].next = noRequestSlot;
+        if (lane.empty())
+        {
+            lane.head = index;
+        }
+        else
+        {
+            slots[lane.tail].next = index;
+        }
+        lane.tail = index;
+    }
+
+    /** @brief Dequeue the next request
+     *
+     *  @return the slot of the request, noRequestSlot if none is queued
+     */
+    uint8_t pop()
+    {
+        /* a starving lane goes first, the lowest one if several */
+        auto starving = std::find_if(lanes.rbegin(), lanes.rend(),
+                                     [](const RequestLane& lane) {
+                                         return !lane.empty() &&
+                                                lane.skipped >=
+                                                    requestStarvationLimit;
+                                     });
+        auto selected = lanes.end();
+        if (starving != lanes.rend())
+        {
+            selected = std::next(starving).base();
+        }
+        else
+        {
+            selected = std::find_if(
+                lanes.begin(), lanes.end(),
+                [](const RequestLane& lane) { return !lane.empty(); });
+        }
+        if (selected == lanes.end())
+        {
+            return noRequestSlot;
+        }
+
+        for (auto it = std::next(selected); it != lanes.end(); ++it)
+        {
+            if (!it->empty())
+            {
+                it->skipped++;
+            }
+        }
+        selected->skipped = 0;
+        return pop(*selected);
+    }
+
+    /** @brief Remove a queued request
+     *
+     *  @param[in] index - slot of the request
+     *  @return true if the request was queued
+     */
+    bool erase(uint8_t index)
+    {
+        return unlink(lanes[static_cast<size_t>(slots[index].priority)],
+                      index);
+    }
+
+  private:
+    /** @brief Dequeue the first request of the PLDM type following the type
+     *         of the last request sent from a lane
+     *
+     *  @param[in] lane - a non-empty lane
+     *  @return the slot of the request
+     */
+    uint8_t pop(RequestLane& lane)
+    {
+        uint8_t next = noRequestSlot;
+        uint8_t first = noRequestSlot;
+        for (auto index = lane.head; index != noRequestSlot;
+             index = slots[index].next)
+        {
+            auto type = slots[index].key.type;
+            if (type > lane.lastType &&
+                (next == noRequestSlot || type < slots[next].key.type))
+            {
+                next = index;
+            }
+            if (first == noRequestSlot || type < slots[first].key.type)
+            {
+                first = index;
+            }
+        }
+
+        auto index = (next != noRequestSlot) ? next : first;
+        unlink(lane, index);
+        lane.lastType = slots[index].key.type;
+        return index;
+    }
+
+    /** @brief Unlink a slot from a lane
+     *
+     *  @param[in] lane - the lane
+     *  @param[in] index - slot of the request
+     *  @return true if the slot was in the lane
+     */
+    bool unlink(RequestLane& lane, uint8_t index)
+    {
+        uint8_t prev = noRequestSlot;
+        for (auto it = lane.head; it != noRequestSlot;
+             prev = it, it = slots[it].next)
+        {
+            if (it != index)
+            {
+                continue;
+            }
+
+            if (prev == noRequestSlot)
+            {
+                lane.head = slots[it].next;
+            }
+            else
+            {
+                slots[prev].next = slots[it].next;
+            }
+            if (lane.tail == it)
+            {
+                lane.tail = prev;
+            }
+            slots[it].next = noRequestSlot;
+            return true;
+        }
+        return false;
+    }
 };
 
 /** @class Handler
@@ -115,6 +343,9 @@ struct EndpointMessageQueue
  *  received within the instance ID expiration interval or any other failure the
  *  response handler is invoked with the empty response.
  *
+ *  The requests are kept in fixed slots per endpoint and a single timer drives
+ *  the retries and the instance ID expiry of all the requests in flight.
+ *
  * @tparam RequestInterface - Request class type
  */
 template <class RequestInterface>
@@ -137,6 +368,8 @@ class Handler
      *  @param[in] instanceIdExpiryInterval - instance ID expiration interval
      *  @param[in] numRetries - number of request retries
      *  @param[in] responseTimeOut - time to wait between each retry
+     *  @param[in] windowSize - default number of requests in flight to an
+     *                          endpoint
      */
     explicit Handler(
         PldmTransport* pldmTransport, sdeventplus::Event& event,
@@ -145,106 +378,60 @@ class Handler
             std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
         uint8_t numRetries = static_cast<uint8_t>(NUMBER_OF_REQUEST_RETRIES),
         std::chrono::milliseconds responseTimeOut =
-            std::chrono::milliseconds(RESPONSE_TIME_OUT)) :
+            std::chrono::milliseconds(RESPONSE_TIME_OUT),
+        uint8_t windowSize = static_cast<uint8_t>(REQUEST_WINDOW_SIZE)) :
         pldmTransport(pldmTransport), event(event), instanceIdDb(instanceIdDb),
         verbose(verbose), instanceIdExpiryInterval(instanceIdExpiryInterval),
-        numRetries(numRetries), responseTimeOut(responseTimeOut)
+        numRetries(numRetries), responseTimeOut(responseTimeOut),
+        windowSize(std::clamp<uint8_t>(windowSize, 1, maxRequestWindowSize)),
+        timer(event.get(), std::bind(&Handler::timerCallback, this))
     {}
 
-    void instanceIdExpiryCallBack(RequestKey key)
+    /** @brief Set the number of requests in flight to an endpoint, for the
+     *         endpoints handling concurrent requests
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] size - number of requests in flight, 1 to
+     *                    maxRequestWindowSize
+     */
+    void setWindowSize(mctp_eid_t eid, uint8_t size)
     {
-        auto eid = key.eid;
-        if (this->handlers.contains(key))
-        {
-            info(
-                "Instance ID expiry for EID '{EID}' using InstanceID '{INSTANCEID}'",
-                "EID", key.eid, "INSTANCEID", key.instanceId);
-            auto& [request, responseHandler,
-                   timerInstance] = this->handlers[key];
-            request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
-            {
-                error(
-                    "Failed to stop the instance ID expiry timer, response code '{RC}'",
-                    "RC", rc);
-            }
-            // Call response handler with an empty response to indicate no
-            // response
-            responseHandler(eid, nullptr, 0);
-            this->removeRequestContainer.emplace(
-                key,
-                std::make_unique<sdeventplus::source::Defer>(
-                    event, std::bind(&Handler::removeRequestEntry, this, key)));
-            endpointMessageQueues[eid]->activeRequest = false;
-
-            /* try to send new request if the endpoint is free */
-            pollEndpointQueue(eid);
-        }
-        else
-        {
-            // This condition is not possible, if a response is received
-            // before the instance ID expiry, then the response handler
-            // is executed and the entry will be removed.
-            assert(false);
-        }
+        getEndpointQueue(eid).windowSize =
+            std::clamp<uint8_t>(size, 1, maxRequestWindowSize);
+
+        /* a larger window lets queued requests out */
+        pollEndpointQueue(eid);
+    }
+
+    /** @brief Set the retry policies overriding the adaptive timeout of
+     *         some PLDM commands
+     *
+     *  @param[in] policies - retry policies keyed by PLDM type and command
+     */
+    void setRetryPolicies(RetryPolicies policies)
+    {
+        retryPolicies = std::move(policies);
     }
 
-    /** @brief Send the remaining PLDM request messages in endpoint queue
+    /** @brief Send the remaining PLDM request messages in endpoint queue,
+     *         up to the window size of the endpoint
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      */
     int pollEndpointQueue(mctp_eid_t eid)
     {
-        if (endpointMessageQueues[eid]->activeRequest ||
-            endpointMessageQueues[eid]->requestQueue.empty())
-        {
-            return PLDM_SUCCESS;
-        }
-
-        endpointMessageQueues[eid]->activeRequest = true;
-        auto requestMsg = endpointMessageQueues[eid]->requestQueue.front();
-        endpointMessageQueues[eid]->requestQueue.pop_front();
-
-        auto request = std::make_unique<RequestInterface>(
-            pldmTransport, requestMsg->key.eid, event,
-            std::move(requestMsg->reqMsg), numRetries, responseTimeOut,
-            verbose);
-        auto timer = std::make_unique<sdbusplus::Timer>(
-            event.get(), std::bind(&Handler::instanceIdExpiryCallBack, this,
-                                   requestMsg->key));
-
-        auto rc = request->start();
-        if (rc)
-        {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error(
-                "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
-                "RC", rc);
-            endpointMessageQueues[eid]->activeRequest = false;
-            return rc;
-        }
-
-        try
-        {
-            timer->start(duration_cast<std::chrono::microseconds>(
-                instanceIdExpiryInterval));
-        }
-        catch (const std::runtime_error& e)
+        auto& endpoint = getEndpointQueue(eid);
+        int rc = PLDM_SUCCESS;
+        while (endpoint.inFlight < endpoint.windowSize)
         {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error(
-                "Failed to start the instance ID expiry timer, error - {ERROR}",
-                "ERROR", e);
-            endpointMessageQueues[eid]->activeRequest = false;
-            return PLDM_ERROR;
+            auto index = endpoint.pop();
+            if (index == noRequestSlot)
+            {
+                break;
+            }
+            rc = sendRequest(endpoint, index);
         }
-
-        handlers.emplace(requestMsg->key,
-                         std::make_tuple(std::move(request),
-                                         std::move(requestMsg->responseHandler),
-                                         std::move(timer)));
-        return PLDM_SUCCESS;
+        return rc;
     }
 
     /** @brief Register a PLDM request message
@@ -255,38 +442,41 @@ class Handler
      *  @param[in] command - PLDM command
      *  @param[in] requestMsg - PLDM request message
      *  @param[in] responseHandler - Response handler for this request
+     *  @param[in] priority - Priority lane of the request
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
      */
-    int registerRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
-                        uint8_t command, pldm::Request&& requestMsg,
-                        ResponseHandler&& responseHandler)
+    int registerRequest(
+        mctp_eid_t eid, uint8_t instanceId, uint8_t type, uint8_t command,
+        pldm::Request&& requestMsg, ResponseHandler&& responseHandler,
+        RequestPriority priority = RequestPriority::Polling)
     {
-        RequestKey key{eid, instanceId, type, command};
-
-        if (handlers.contains(key))
+        if (instanceId >= numInstanceIds)
         {
             error(
-                "Register request for EID '{EID}' is using InstanceID '{INSTANCEID}'",
+                "Register request for EID '{EID}' with invalid InstanceID '{INSTANCEID}'",
                 "EID", eid, "INSTANCEID", instanceId);
             return PLDM_ERROR;
         }
 
-        auto inputRequest = std::make_shared<RegisteredRequest>(
-            key, std::move(requestMsg), std::move(responseHandler));
-        if (endpointMessageQueues.contains(eid))
+        auto& endpoint = getEndpointQueue(eid);
+        auto& slot = endpoint.slots[instanceId];
+        if (slot.state != Slot::State::Free)
         {
-            endpointMessageQueues[eid]->requestQueue.push_back(inputRequest);
-        }
-        else
-        {
-            std::deque<std::shared_ptr<RegisteredRequest>> reqQueue;
-            reqQueue.push_back(inputRequest);
-            endpointMessageQueues[eid] =
-                std::make_shared<EndpointMessageQueue>(eid, reqQueue, false);
+            error(
+                "Register request for EID '{EID}' is using InstanceID '{INSTANCEID}'",
+                "EID", eid, "INSTANCEID", instanceId);
+            return PLDM_ERROR;
         }
 
-        /* try to send new request if the endpoint is free */
+        slot.state = Slot::State::Queued;
+        slot.key = RequestKey{eid, instanceId, type, command};
+        slot.priority = priority;
+        slot.reqMsg = std::move(requestMsg);
+        slot.responseHandler = std::move(responseHandler);
+        endpoint.push(instanceId);
+
+        /* try to send new request if the window has room */
         pollEndpointQueue(eid);
 
         return PLDM_SUCCESS;
@@ -306,56 +496,36 @@ class Handler
     {
         RequestKey key{eid, instanceId, type, command};
 
-        /* handlers only contain key when the message is already sent */
-        if (handlers.contains(key))
+        if (!endpointMessageQueues.contains(eid))
         {
-            auto& [request, responseHandler, timerInstance] = handlers[key];
-            request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
-            {
-                error(
-                    "Failed to stop the instance ID expiry timer, response code '{RC}'",
-                    "RC", static_cast<int>(rc));
-            }
+            error(
+                "Can't find request for EID '{EID}' is using InstanceID '{INSTANCEID}' in Endpoint message Queue",
+                "EID", (unsigned)eid, "INSTANCEID", (unsigned)instanceId);
+            return PLDM_ERROR;
+        }
 
+        auto& endpoint = *endpointMessageQueues[eid];
+        auto slot = findRequest(endpoint, key);
+        if (!slot)
+        {
+            return PLDM_ERROR;
+        }
+
+        if (slot->state == Slot::State::InFlight)
+        {
+            releaseSlot(endpoint, *slot);
             instanceIdDb.free(key.eid, key.instanceId);
-            handlers.erase(key);
-            endpointMessageQueues[eid]->activeRequest = false;
-            /* try to send new request if the endpoint is free */
+            /* try to send new request if the window has room */
             pollEndpointQueue(eid);
-
-            return PLDM_SUCCESS;
         }
         else
         {
-            if (!endpointMessageQueues.contains(eid))
-            {
-                error(
-                    "Can't find request for EID '{EID}' is using InstanceID '{INSTANCEID}' in Endpoint message Queue",
-                    "EID", (unsigned)eid, "INSTANCEID", (unsigned)instanceId);
-                return PLDM_ERROR;
-            }
-            auto requestMsg = endpointMessageQueues[eid]->requestQueue;
-            /* Find the registered request in the requestQueue */
-            for (auto it = requestMsg.begin(); it != requestMsg.end();)
-            {
-                auto msg = *it;
-                if (msg->key == key)
-                {
-                    // erase and get the next valid iterator
-                    it = endpointMessageQueues[eid]->requestQueue.erase(it);
-                    instanceIdDb.free(key.eid, key.instanceId);
-                    return PLDM_SUCCESS;
-                }
-                else
-                {
-                    ++it; // increment iterator only if not erasing
-                }
-            }
+            endpoint.erase(instanceId);
+            releaseSlot(endpoint, *slot);
+            instanceIdDb.free(key.eid, key.instanceId);
         }
 
-        return PLDM_ERROR;
+        return PLDM_SUCCESS;
     }
 
     /** @brief Handle PLDM response message
@@ -372,23 +542,28 @@ class Handler
                         size_t respMsgLen)
     {
         RequestKey key{eid, instanceId, type, command};
-        if (handlers.contains(key) && !removeRequestContainer.contains(key))
+        Slot* slot = nullptr;
+        if (endpointMessageQueues.contains(eid))
         {
-            auto& [request, responseHandler, timerInstance] = handlers[key];
-            request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
+            slot = findRequest(*endpointMessageQueues[eid], key);
+        }
+
+        if (slot && slot->state == Slot::State::InFlight)
+        {
+            auto& endpoint = *endpointMessageQueues[eid];
+            if (slot->adaptive && !slot->retried)
             {
-                error(
-                    "Failed to stop the instance ID expiry timer, response code '{RC}'",
-                    "RC", rc);
+                endpoint.rtt.sample(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        RequestClock::now() - slot->sentTime));
             }
+
+            auto responseHandler = std::move(slot->responseHandler);
+            releaseSlot(endpoint, *slot);
             responseHandler(eid, response, respMsgLen);
             instanceIdDb.free(key.eid, key.instanceId);
-            handlers.erase(key);
 
-            endpointMessageQueues[eid]->activeRequest = false;
-            /* try to send new request if the endpoint is free */
+            /* try to send new request if the window has room */
             pollEndpointQueue(eid);
         }
         else
@@ -402,61 +577,246 @@ class Handler
     }
 
     /** @brief Wrap registerRequest with coroutine API.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] request - PLDM request message
+     *  @param[in] priority - Priority lane of the request
      *
      *  @return Return [PLDM_ERROR, _, _] if registerRequest fails.
      *          Return [PLDM_ERROR_NOT_READY, nullptr, 0] if timed out.
      *          Return [PLDM_SUCCESS, resp, len] if succeeded
      */
     stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto
-        sendRecvMsg(mctp_eid_t eid, pldm::Request&& request);
+        sendRecvMsg(mctp_eid_t eid, pldm::Request&& request,
+                    RequestPriority priority = RequestPriority::Polling);
 
   private:
-    PldmTransport* pldmTransport; //!< PLDM transport object
-    sdeventplus::Event& event; //!< reference to PLDM daemon's main event loop
-    pldm::InstanceIdDb& instanceIdDb; //!< reference to an InstanceIdDb
-    bool verbose;                     //!< verbose tracing flag
-    std::chrono::seconds
-        instanceIdExpiryInterval;     //!< Instance ID expiration interval
-    uint8_t numRetries;               //!< number of request retries
-    std::chrono::milliseconds
-        responseTimeOut;              //!< time to wait between each retry
+    using Endpoint = EndpointMessageQueue<RequestInterface>;
+    using Slot = typename Endpoint::Slot;
 
-    /** @brief Container for storing the details of the PLDM request
-     *         message, handler for the corresponding PLDM response and the
-     *         timer object for the Instance ID expiration
+    /** @brief Get the message queue of an endpoint, created on first use
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      */
-    using RequestValue =
-        std::tuple<std::unique_ptr<RequestInterface>, ResponseHandler,
-                   std::unique_ptr<sdbusplus::Timer>>;
+    Endpoint& getEndpointQueue(mctp_eid_t eid)
+    {
+        auto& endpoint = endpointMessageQueues[eid];
+        if (!endpoint)
+        {
+            endpoint = std::make_unique<Endpoint>();
+            endpoint->eid = eid;
+            endpoint->windowSize = windowSize;
+        }
+        return *endpoint;
+    }
 
-    // Manage the requests of responders base on MCTP EID
-    std::map<mctp_eid_t, std::shared_ptr<EndpointMessageQueue>>
-        endpointMessageQueues;
+    /** @brief Find the slot of a registered request
+     *
+     *  @param[in] endpoint - message queue of the endpoint
+     *  @param[in] key - key of the request
+     *  @return the slot, nullptr if the request is not registered
+     */
+    Slot* findRequest(Endpoint& endpoint, const RequestKey& key)
+    {
+        if (key.instanceId >= numInstanceIds)
+        {
+            return nullptr;
+        }
 
-    /** @brief Container for storing the PLDM request entries */
-    std::unordered_map<RequestKey, RequestValue, RequestKeyHasher> handlers;
+        auto& slot = endpoint.slots[key.instanceId];
+        if (slot.state == Slot::State::Free || !(slot.key == key))
+        {
+            return nullptr;
+        }
+        return &slot;
+    }
 
-    /** @brief Container to store information about the request entries to be
-     *         removed after the instance ID timer expires
+    /** @brief Release the slot of a queued or sent request, the caller frees
+     *         the instance ID
+     *
+     *  @param[in] endpoint - message queue of the endpoint
+     *  @param[in] slot - slot of the request
      */
-    std::unordered_map<RequestKey, std::unique_ptr<sdeventplus::source::Defer>,
-                       RequestKeyHasher>
-        removeRequestContainer;
+    void releaseSlot(Endpoint& endpoint, Slot& slot)
+    {
+        if (slot.state == Slot::State::InFlight)
+        {
+            endpoint.inFlight--;
+        }
+        slot.state = Slot::State::Free;
+        slot.request.reset();
+        slot.reqMsg.clear();
+        slot.responseHandler = nullptr;
+    }
 
-    /** @brief Remove request entry for which the instance ID expired
+    /** @brief Send a PLDM request message and schedule its retries and its
+     *         instance ID expiry. The time to wait for a response is the retry
+     *         policy of the command if any, derived from the round-trip times
+     *         of the endpoint otherwise.
      *
-     *  @param[in] key - key for the Request
+     *  @param[in] endpoint - message queue of the endpoint
+     *  @param[in] index - slot of the request
      */
-    void removeRequestEntry(RequestKey key)
+    int sendRequest(Endpoint& endpoint, uint8_t index)
     {
-        if (removeRequestContainer.contains(key))
+        auto& slot = endpoint.slots[index];
+        auto policy = retryPolicies.find({slot.key.type, slot.key.command});
+        slot.adaptive = (policy == retryPolicies.end());
+        slot.retried = false;
+        slot.timeout = slot.adaptive ? endpoint.rtt.timeout(responseTimeOut)
+                                     : policy->second.responseTimeOut;
+        auto retries = slot.adaptive ? numRetries : policy->second.numRetries;
+        slot.request.emplace(pldmTransport, slot.key.eid,
+                             std::move(slot.reqMsg), retries, slot.timeout,
+                             verbose);
+
+        auto rc = slot.request->start();
+        if (rc)
         {
-            removeRequestContainer[key].reset();
+            auto key = slot.key;
+            releaseSlot(endpoint, slot);
             instanceIdDb.free(key.eid, key.instanceId);
-            handlers.erase(key);
-            removeRequestContainer.erase(key);
+            error(
+                "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
+                "RC", rc);
+            return rc;
         }
+
+        auto now = RequestClock::now();
+        slot.state = Slot::State::InFlight;
+        slot.sentTime = now;
+        slot.expiryTime = now + instanceIdExpiryInterval;
+        slot.retryTime = retries ? now + slot.timeout
+                                 : RequestClock::time_point::max();
+        endpoint.inFlight++;
+        scheduleTimer(std::min(slot.retryTime, slot.expiryTime));
+        return PLDM_SUCCESS;
     }
+
+    /** @brief Arm the timer if a deadline is earlier than the armed one
+     *
+     *  @param[in] deadline - time of the next retry or expiry
+     */
+    void scheduleTimer(RequestClock::time_point deadline)
+    {
+        if (deadline >= timerDeadline)
+        {
+            return;
+        }
+
+        auto delay = std::max(deadline - RequestClock::now(),
+                              RequestClock::duration::zero());
+        try
+        {
+            timer.start(
+                std::chrono::duration_cast<std::chrono::microseconds>(delay));
+            timerDeadline = deadline;
+        }
+        catch (const std::runtime_error& e)
+        {
+            error("Failed to start the request timer, error - {ERROR}",
+                  "ERROR", e);
+        }
+    }
+
+    /** @brief Retry the requests without response and expire the instance
+     *         IDs due, then arm the timer for the next deadline
+     */
+    void timerCallback()
+    {
+        timerDeadline = RequestClock::time_point::max();
+        auto now = RequestClock::now();
+        auto next = RequestClock::time_point::max();
+        for (auto& [eid, endpoint] : endpointMessageQueues)
+        {
+            for (uint8_t index = 0; index < numInstanceIds; index++)
+            {
+                auto& slot = endpoint->slots[index];
+                if (slot.state != Slot::State::InFlight)
+                {
+                    continue;
+                }
+
+                if (slot.expiryTime <= now)
+                {
+                    if (slot.adaptive && !slot.retried)
+                    {
+                        endpoint->rtt.timedOut();
+                    }
+                    expireRequest(*endpoint, slot);
+                    continue;
+                }
+
+                if (slot.retryTime <= now)
+                {
+                    if (slot.adaptive && !slot.retried)
+                    {
+                        endpoint->rtt.timedOut();
+                    }
+                    if (slot.request->retry())
+                    {
+                        slot.retried = true;
+                        slot.retryTime = now + slot.timeout;
+                    }
+                    else
+                    {
+                        slot.retryTime = RequestClock::time_point::max();
+                    }
+                }
+                next = std::min({next, slot.retryTime, slot.expiryTime});
+            }
+        }
+
+        if (next != RequestClock::time_point::max())
+        {
+            scheduleTimer(next);
+        }
+    }
+
+    /** @brief Invoke the response handler of a request without response with
+     *         an empty response and free its instance ID
+     *
+     *  @param[in] endpoint - message queue of the endpoint
+     *  @param[in] slot - slot of the request
+     */
+    void expireRequest(Endpoint& endpoint, Slot& slot)
+    {
+        auto key = slot.key;
+        info(
+            "Instance ID expiry for EID '{EID}' using InstanceID '{INSTANCEID}'",
+            "EID", key.eid, "INSTANCEID", key.instanceId);
+
+        auto responseHandler = std::move(slot.responseHandler);
+        releaseSlot(endpoint, slot);
+        // Call response handler with an empty response to indicate no
+        // response
+        responseHandler(key.eid, nullptr, 0);
+        instanceIdDb.free(key.eid, key.instanceId);
+
+        /* try to send new request if the window has room */
+        pollEndpointQueue(key.eid);
+    }
+
+    PldmTransport* pldmTransport; //!< PLDM transport object
+    sdeventplus::Event& event; //!< reference to PLDM daemon's main event loop
+    pldm::InstanceIdDb& instanceIdDb; //!< reference to an InstanceIdDb
+    bool verbose;                     //!< verbose tracing flag
+    std::chrono::seconds
+        instanceIdExpiryInterval;     //!< Instance ID expiration interval
+    uint8_t numRetries;               //!< number of request retries
+    std::chrono::milliseconds
+        responseTimeOut;              //!< time to wait between each retry
+    uint8_t windowSize;               //!< default requests in flight per EID
+    RetryPolicies retryPolicies;      //!< retry policies per PLDM command
+
+    /** @brief Timer of the retries and instance ID expiries */
+    sdbusplus::Timer timer;
+
+    /** @brief Deadline the timer is armed for, max if not armed */
+    RequestClock::time_point timerDeadline = RequestClock::time_point::max();
+
+    // Manage the requests of responders base on MCTP EID
+    std::map<mctp_eid_t, std::unique_ptr<Endpoint>> endpointMessageQueues;
 };
 
 /** @class SendRecvMsgOperation
@@ -473,8 +833,9 @@ struct SendRecvMsgOperation
 
     explicit SendRecvMsgOperation(Handler<RequestInterface>& handler,
                                   mctp_eid_t eid, pldm::Request&& request,
-                                  R&& r) :
-        handler(handler), request(std::move(request)), receiver(std::move(r))
+                                  RequestPriority priority, R&& r) :
+        handler(handler), request(std::move(request)), priority(priority),
+        receiver(std::move(r))
     {
         auto requestMsg =
             reinterpret_cast<const pldm_msg*>(this->request.data());
@@ -511,7 +872,8 @@ struct SendRecvMsgOperation
         auto rc = op.handler.registerRequest(
             op.requestKey.eid, op.requestKey.instanceId, op.requestKey.type,
             op.requestKey.command, std::move(op.request),
-            std::bind(&SendRecvMsgOperation::onComplete, &op, _1, _2, _3));
+            std::bind(&SendRecvMsgOperation::onComplete, &op, _1, _2, _3),
+            op.priority);
         if (rc)
         {
             return stdexec::set_value(std::move(op.receiver), rc,
@@ -574,6 +936,10 @@ struct SendRecvMsgOperation
      */
     pldm::Request request;
 
+    /** @brief Priority lane of the request message.
+     */
+    RequestPriority priority;
+
     /** @brief The response message for the sent request message.
      */
     const pldm_msg* response;
@@ -608,8 +974,10 @@ struct SendRecvMsgSender
     SendRecvMsgSender() = delete;
 
     explicit SendRecvMsgSender(requester::Handler<RequestInterface>& handler,
-                               mctp_eid_t eid, pldm::Request&& request) :
-        handler(handler), eid(eid), request(std::move(request))
+                               mctp_eid_t eid, pldm::Request&& request,
+                               RequestPriority priority) :
+        handler(handler), eid(eid), request(std::move(request)),
+        priority(priority)
     {}
 
     friend auto tag_invoke(stdexec::get_completion_signatures_t,
@@ -623,7 +991,8 @@ struct SendRecvMsgSender
     friend auto tag_invoke(stdexec::connect_t, SendRecvMsgSender&& self, R r)
     {
         return SendRecvMsgOperation<RequestInterface, R>(
-            self.handler, self.eid, std::move(self.request), std::move(r));
+            self.handler, self.eid, std::move(self.request), self.priority,
+            std::move(r));
     }
 
   private:
@@ -637,12 +1006,16 @@ struct SendRecvMsgSender
 
     /** @brief Request message */
     pldm::Request request;
+
+    /** @brief Priority lane of the request message */
+    RequestPriority priority;
 };
 
 /** @brief Wrap registerRequest with coroutine API.
  *
  *  @param[in] eid - endpoint ID of the remote MCTP endpoint
  *  @param[in] request - PLDM request message
+ *  @param[in] priority - Priority lane of the request
  *
  *  @return Return [PLDM_ERROR, _, _] if registerRequest fails.
  *          Return [PLDM_ERROR_NOT_READY, nullptr, 0] if timed out.
@@ -650,10 +1023,10 @@ struct SendRecvMsgSender
  */
 template <class RequestInterface>
 stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto
-    Handler<RequestInterface>::sendRecvMsg(mctp_eid_t eid,
-                                           pldm::Request&& request)
+    Handler<RequestInterface>::sendRecvMsg(
+        mctp_eid_t eid, pldm::Request&& request, RequestPriority priority)
 {
-    return SendRecvMsgSender(*this, eid, std::move(request)) |
+    return SendRecvMsgSender(*this, eid, std::move(request), priority) |
            stdexec::then([](int rc, const pldm_msg* resp, size_t respLen) {
                return std::make_tuple(rc, resp, respLen);
            });
@@ -15,6 +15,7 @@
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -48,8 +49,20 @@ class RequestRetryTimer
     explicit RequestRetryTimer(sdeventplus::Event& event, uint8_t numRetries,
                                std::chrono::milliseconds timeout) :
 
-        event(event), numRetries(numRetries), timeout(timeout),
-        timer(event.get(), std::bind_front(&RequestRetryTimer::callback, this))
+        numRetries(numRetries), timeout(timeout),
+        timer(std::in_place, event.get(),
+              std::bind_front(&RequestRetryTimer::callback, this))
+    {}
+
+    /** @brief Constructor of a request without a timer of its own, the owner
+     *         of the request drives the retries through retry()
+     *
+     *  @param[in] numRetries - number of request retries
+     *  @param[in] timeout - time to wait between each retry in milliseconds
+     */
+    explicit RequestRetryTimer(uint8_t numRetries,
+                               std::chrono::milliseconds timeout) :
+        numRetries(numRetries), timeout(timeout)
     {}
 
     /** @brief Starts the request flow and arms the timer for request retries
@@ -66,9 +79,9 @@ class RequestRetryTimer
 
         try
         {
-            if (numRetries)
+            if (numRetries && timer)
             {
-                timer.start(duration_cast<std::chrono::microseconds>(timeout),
+                timer->start(duration_cast<std::chrono::microseconds>(timeout),
                             true);
             }
         }
@@ -85,7 +98,12 @@ class RequestRetryTimer
     /** @brief Stops the timer and no further request retries happen */
     void stop()
     {
-        auto rc = timer.stop();
+        if (!timer)
+        {
+            return;
+        }
+
+        auto rc = timer->stop();
         if (rc)
         {
             error("Failed to stop the request timer, response code '{RC}'",
@@ -93,12 +111,28 @@ class RequestRetryTimer
         }
     }
 
+    /** @brief Resend the request if it has retries left
+     *
+     *  @return true if the request was sent again
+     */
+    bool retry()
+    {
+        if (!numRetries)
+        {
+            return false;
+        }
+
+        numRetries--;
+        send();
+        return true;
+    }
+
   protected:
-    sdeventplus::Event& event; //!< reference to PLDM daemon's main event loop
-    uint8_t numRetries;        //!< number of request retries
+    uint8_t numRetries; //!< number of request retries
     std::chrono::milliseconds
-        timeout;            //!< time to wait between each retry in milliseconds
-    sdbusplus::Timer timer; //!< manages starting timers and handling timeouts
+        timeout; //!< time to wait between each retry in milliseconds
+    std::optional<sdbusplus::Timer>
+        timer;   //!< manages starting timers and handling timeouts
 
     /** @brief Sends the PLDM request message
      *
@@ -159,6 +193,22 @@ class Request final : public RequestRetryTimer
         requestMsg(std::move(requestMsg)), verbose(verbose)
     {}
 
+    /** @brief Constructor of a request whose retries are driven by its owner
+     *
+     *  @param[in] pldm_transport - PLDM transport object
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] requestMsg - PLDM request message
+     *  @param[in] numRetries - number of request retries
+     *  @param[in] timeout - time to wait between each retry in milliseconds
+     *  @param[in] verbose - verbose tracing flag
+     */
+    explicit Request(PldmTransport* pldmTransport, mctp_eid_t eid,
+                     pldm::Request&& requestMsg, uint8_t numRetries,
+                     std::chrono::milliseconds timeout, bool verbose) :
+        RequestRetryTimer(numRetries, timeout), pldmTransport(pldmTransport),
+        eid(eid), requestMsg(std::move(requestMsg)), verbose(verbose)
+    {}
+
   private:
     PldmTransport* pldmTransport; //!< PLDM transport
     mctp_eid_t eid;               //!< endpoint ID of the remote MCTP endpoint
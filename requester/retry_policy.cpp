@@ -0,0 +1,61 @@
+#include "retry_policy.hpp"
+
+#include "common/utils.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <fstream>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace requester
+{
+
+RetryPolicies parseRetryPolicies(const std::filesystem::path& path)
+{
+    RetryPolicies policies{};
+    if (!std::filesystem::exists(path))
+    {
+        return policies;
+    }
+
+    std::ifstream jsonFile(path);
+    auto data = pldm::utils::Json::parse(jsonFile, nullptr, false);
+    if (data.is_discarded())
+    {
+        error("Failed to parse retry policy json file {PATH}", "PATH",
+              path.string());
+        return policies;
+    }
+
+    const std::vector<pldm::utils::Json> emptyList{};
+    for (const auto& entry : data.value("commands", emptyList))
+    {
+        auto type = entry.value("type", -1);
+        auto command = entry.value("command", -1);
+        auto timeout = entry.value("response_time_out_ms", -1);
+        auto numRetries = entry.value("number_of_retries", -1);
+        if (type < 0 || type > UINT8_MAX || command < 0 ||
+            command > UINT8_MAX || numRetries < 0 || numRetries > UINT8_MAX ||
+            timeout < minResponseTimeOut.count() ||
+            timeout > maxResponseTimeOut.count())
+        {
+            error("Skipping invalid retry policy entry {ENTRY} in {PATH}",
+                  "ENTRY", entry.dump(), "PATH", path.string());
+            continue;
+        }
+
+        policies.insert_or_assign(
+            std::make_pair(static_cast<uint8_t>(type),
+                           static_cast<uint8_t>(command)),
+            RetryPolicy{std::chrono::milliseconds(timeout),
+                        static_cast<uint8_t>(numRetries)});
+    }
+
+    return policies;
+}
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <utility>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @brief Bounds of the time to wait for a response before a retry, the
+ *         range of the response-time-out option
+ */
+constexpr std::chrono::milliseconds minResponseTimeOut{300};
+constexpr std::chrono::milliseconds maxResponseTimeOut{4800};
+
+/** @struct RetryPolicy
+ *
+ *  The retries of the requests of one PLDM command, overriding the timeout
+ *  derived from the round-trip times of the endpoint.
+ */
+struct RetryPolicy
+{
+    std::chrono::milliseconds responseTimeOut; //!< time to wait per retry
+    uint8_t numRetries;                        //!< number of request retries
+};
+
+/** @brief Retry policies keyed by PLDM type and command */
+using RetryPolicies = std::map<std::pair<uint8_t, uint8_t>, RetryPolicy>;
+
+/** @class RttEstimator
+ *
+ *  Smoothed round-trip time and round-trip time variation of an endpoint,
+ *  from which the time to wait for a response is derived as in RFC 6298.
+ *  Only the responses to requests not retried are sampled, a response to a
+ *  retried request can't be matched with the transmission it answers.
+ */
+class RttEstimator
+{
+  public:
+    /** @brief Sample the round-trip time of a request
+     *
+     *  @param[in] rtt - time from sending the request to its response
+     */
+    void sample(std::chrono::microseconds rtt)
+    {
+        if (!sampled)
+        {
+            srtt = rtt;
+            rttvar = rtt / 2;
+            sampled = true;
+        }
+        else
+        {
+            auto delta = (srtt > rtt) ? srtt - rtt : rtt - srtt;
+            rttvar = (3 * rttvar + delta) / 4;
+            srtt = (7 * srtt + rtt) / 8;
+        }
+        backoff = 0;
+    }
+
+    /** @brief Double the timeout after a request timed out, until the next
+     *         sample
+     */
+    void timedOut()
+    {
+        if (backoff < maxBackoff)
+        {
+            backoff++;
+        }
+    }
+
+    /** @brief Time to wait for a response before a retry
+     *
+     *  @param[in] defaultTimeOut - timeout of an endpoint not sampled yet
+     *  @return the timeout, within minResponseTimeOut and maxResponseTimeOut
+     */
+    std::chrono::milliseconds
+        timeout(std::chrono::milliseconds defaultTimeOut) const
+    {
+        std::chrono::microseconds rto = defaultTimeOut;
+        if (sampled)
+        {
+            rto = std::max(srtt + 4 * rttvar,
+                           std::chrono::microseconds(minResponseTimeOut));
+        }
+        rto *= (1 << backoff);
+        return std::clamp(
+            std::chrono::ceil<std::chrono::milliseconds>(rto),
+            minResponseTimeOut, maxResponseTimeOut);
+    }
+
+    /** @brief Smoothed round-trip time, zero if not sampled */
+    std::chrono::microseconds smoothedRtt() const
+    {
+        return srtt;
+    }
+
+  private:
+    static constexpr uint8_t maxBackoff = 4;
+
+    bool sampled = false;               //!< a round trip was sampled
+    std::chrono::microseconds srtt{};   //!< smoothed round-trip time
+    std::chrono::microseconds rttvar{}; //!< round-trip time variation
+    uint8_t backoff = 0;                //!< timeouts since the sample
+};
+
+/** @brief Parse the per-command retry policies
+ *
+ *  @param[in] path - path of the JSON configuration, a missing file is no
+ *                    policy
+ *  @return the retry policies, the invalid entries are skipped
+ */
+RetryPolicies parseRetryPolicies(const std::filesystem::path& path);
+
+} // namespace requester
+} // namespace pldm
@@ -10,6 +10,8 @@
 
 #include <sdbusplus/async.hpp>
 
+#include <array>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -294,3 +296,166 @@ TEST_F(HandlerTest, asyncRequestResponseByCoroutine)
 
     stdexec::sync_wait(scope.on_empty());
 }
+
+TEST_F(HandlerTest, requestWindowScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100), 2);
+
+    std::array<uint8_t, 3> instanceIds{};
+    for (auto& instanceId : instanceIds)
+    {
+        instanceId = instanceIdDb.next(eid);
+        auto rc = reqHandler.registerRequest(
+            eid, instanceId, 0, 0, pldm::Request{},
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+
+    // The first two requests are in flight, the second one completes first
+    reqHandler.handleResponse(eid, instanceIds[1], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+
+    // which sends the third one
+    reqHandler.handleResponse(eid, instanceIds[2], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+
+    reqHandler.handleResponse(eid, instanceIds[0], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(nullResponse, false);
+}
+
+TEST_F(HandlerTest, fairQueueingScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100));
+
+    // Two requests of PLDM type 2 are queued ahead of one of type 4
+    auto platformId0 = instanceIdDb.next(eid);
+    auto platformId1 = instanceIdDb.next(eid);
+    auto fruId = instanceIdDb.next(eid);
+    for (auto [instanceId, type] :
+         {std::pair{platformId0, PLDM_PLATFORM},
+          std::pair{platformId1, PLDM_PLATFORM}, std::pair{fruId, PLDM_FRU}})
+    {
+        auto rc = reqHandler.registerRequest(
+            eid, instanceId, type, 0, pldm::Request{},
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, platformId0, PLDM_PLATFORM, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+
+    // The FRU request is served before the second platform request
+    reqHandler.handleResponse(eid, fruId, PLDM_FRU, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+
+    reqHandler.handleResponse(eid, platformId1, PLDM_PLATFORM, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 3);
+}
+
+TEST_F(HandlerTest, priorityScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100));
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+
+    // A polling request is in flight, a bulk request and then more control
+    // requests than the starvation limit are queued behind it
+    auto pollingId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, pollingId, PLDM_PLATFORM, 0, pldm::Request{},
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    auto bulkId = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, bulkId, PLDM_PLATFORM, 0, pldm::Request{},
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+        RequestPriority::Bulk);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    std::vector<uint8_t> controlIds;
+    for (auto i = 0; i <= requestStarvationLimit; i++)
+    {
+        controlIds.emplace_back(instanceIdDb.next(eid));
+        rc = reqHandler.registerRequest(
+            eid, controlIds.back(), PLDM_PLATFORM, 0, pldm::Request{},
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+            RequestPriority::Control);
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    reqHandler.handleResponse(eid, pollingId, PLDM_PLATFORM, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+
+    // The control requests go ahead of the bulk request
+    for (auto i = 0; i < requestStarvationLimit; i++)
+    {
+        reqHandler.handleResponse(eid, controlIds[i], PLDM_PLATFORM, 0,
+                                  responsePtr, response.size());
+        EXPECT_EQ(callbackCount, i + 2);
+    }
+
+    // The bulk request was skipped long enough, it is served before the last
+    // control request
+    reqHandler.handleResponse(eid, bulkId, PLDM_PLATFORM, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, requestStarvationLimit + 2);
+    reqHandler.handleResponse(eid, controlIds.back(), PLDM_PLATFORM, 0,
+                              responsePtr, response.size());
+    EXPECT_EQ(callbackCount, requestStarvationLimit + 3);
+}
+
+TEST_F(HandlerTest, busyInstanceIdScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100));
+    auto instanceId = instanceIdDb.next(eid);
+    auto queuedId = instanceIdDb.next(eid);
+    for (auto id : {instanceId, queuedId})
+    {
+        auto rc = reqHandler.registerRequest(
+            eid, id, 0, 0, pldm::Request{},
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    // The slots of a request in flight and of a queued request are busy
+    for (auto id : {instanceId, queuedId})
+    {
+        auto rc = reqHandler.registerRequest(
+            eid, id, 0, 0, pldm::Request{},
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+        EXPECT_EQ(rc, PLDM_ERROR);
+    }
+    EXPECT_EQ(reqHandler.registerRequest(
+                  eid, numInstanceIds, 0, 0, pldm::Request{},
+                  std::bind_front(&HandlerTest::pldmResponseCallBack, this)),
+              PLDM_ERROR);
+
+    EXPECT_EQ(reqHandler.unregisterRequest(eid, queuedId, 0, 0), PLDM_SUCCESS);
+    EXPECT_EQ(reqHandler.unregisterRequest(eid, queuedId, 0, 0), PLDM_ERROR);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+}
@@ -24,6 +24,12 @@ class MockRequest : public RequestRetryTimer
         RequestRetryTimer(event, numRetries, responseTimeOut)
     {}
 
+    MockRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
+                pldm::Request&& /*requestMsg*/, uint8_t numRetries,
+                std::chrono::milliseconds responseTimeOut, bool /*verbose*/) :
+        RequestRetryTimer(numRetries, responseTimeOut)
+    {}
+
     MOCK_METHOD(int, send, (), (const, override));
 };
 
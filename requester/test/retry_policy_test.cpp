@@ -0,0 +1,86 @@
+#include "requester/retry_policy.hpp"
+
+#include <cstdlib>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono;
+
+TEST(RttEstimator, defaultTimeOut)
+{
+    RttEstimator rtt{};
+    EXPECT_EQ(rtt.timeout(milliseconds(2000)), milliseconds(2000));
+
+    // A default out of the bounds is clamped
+    EXPECT_EQ(rtt.timeout(milliseconds(100)), minResponseTimeOut);
+    EXPECT_EQ(rtt.timeout(milliseconds(10000)), maxResponseTimeOut);
+}
+
+TEST(RttEstimator, adaptiveTimeOut)
+{
+    RttEstimator rtt{};
+
+    // A fast endpoint waits for the lower bound
+    for (auto i = 0; i < 8; i++)
+    {
+        rtt.sample(milliseconds(5));
+    }
+    EXPECT_EQ(rtt.smoothedRtt(), milliseconds(5));
+    EXPECT_EQ(rtt.timeout(milliseconds(2000)), minResponseTimeOut);
+
+    // A slow endpoint waits for its round trip and variation
+    RttEstimator slow{};
+    slow.sample(milliseconds(1000));
+    EXPECT_EQ(slow.timeout(milliseconds(2000)), milliseconds(3000));
+    slow.sample(milliseconds(1000));
+    EXPECT_EQ(slow.timeout(milliseconds(2000)), milliseconds(2500));
+
+    // Timeouts back off up to the upper bound, until the next sample
+    slow.timedOut();
+    EXPECT_EQ(slow.timeout(milliseconds(2000)), maxResponseTimeOut);
+    slow.sample(milliseconds(1000));
+    EXPECT_LT(slow.timeout(milliseconds(2000)), maxResponseTimeOut);
+}
+
+class RetryPolicyTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_retry_policy.XXXXXX";
+        dir = std::filesystem::path(mkdtemp(tmpdir));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(RetryPolicyTest, parse)
+{
+    auto path = dir / "request_retry_policy.json";
+    EXPECT_TRUE(parseRetryPolicies(path).empty());
+
+    std::ofstream(path) << R"({
+        "commands": [
+            {"type": 2, "command": 81, "response_time_out_ms": 4000,
+             "number_of_retries": 1},
+            {"type": 2, "command": 17, "response_time_out_ms": 100,
+             "number_of_retries": 2},
+            {"type": 4, "response_time_out_ms": 1000, "number_of_retries": 2}
+        ]
+    })";
+    auto policies = parseRetryPolicies(path);
+    ASSERT_EQ(policies.size(), 1);
+    auto& policy = policies.at({2, 81});
+    EXPECT_EQ(policy.responseTimeOut, milliseconds(4000));
+    EXPECT_EQ(policy.numRetries, 1);
+
+    std::ofstream(path) << "{ not json";
+    EXPECT_TRUE(parseRetryPolicies(path).empty());
+}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include "common/transport.hpp"
+#include "common/types.hpp"
+#include "pldmd/invoker.hpp"
+#include "requester/handler.hpp"
+#include "requester/request.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/base.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace test
+{
+
+/** @class FakeTerminus
+ *
+ *  A scriptable PLDM terminus serving the peer end of a loopback transport
+ *  on its own thread. Requests are answered by the responder registered for
+ *  their PLDM type and command, with an unsupported command completion code
+ *  otherwise.
+ */
+class FakeTerminus
+{
+  public:
+    /** @brief Build the response to a request, an empty response drops the
+     *         request
+     */
+    using Responder = std::function<responder::Response(
+        const pldm_msg* request, size_t reqMsgLen)>;
+
+    /** @brief Invoked on the terminus thread for the responses to the
+     *         requests sent by the terminus
+     */
+    using ResponseHandler =
+        std::function<void(const pldm_msg* response, size_t respMsgLen)>;
+
+    FakeTerminus() = delete;
+    FakeTerminus(const FakeTerminus&) = delete;
+    FakeTerminus& operator=(const FakeTerminus&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] fd - peer end of the loopback transport socket, owned by
+     *                  the terminus
+     *  @param[in] tid - TID of the terminus
+     */
+    explicit FakeTerminus(int fd, pldm_tid_t tid) :
+        fd(fd), tid(tid), stopFd(eventfd(0, EFD_CLOEXEC))
+    {
+        if (stopFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category());
+        }
+    }
+
+    ~FakeTerminus()
+    {
+        stop();
+        close(stopFd);
+        close(fd);
+    }
+
+    /** @brief Register the responder of a command, before start() */
+    void setResponder(uint8_t type, uint8_t command, Responder responder)
+    {
+        responders[{type, command}] = std::move(responder);
+    }
+
+    /** @brief Register the handler of the responses, before start() */
+    void setResponseHandler(ResponseHandler handler)
+    {
+        responseHandler = std::move(handler);
+    }
+
+    /** @brief Start serving requests */
+    void start()
+    {
+        worker = std::thread([this]() { run(); });
+    }
+
+    /** @brief Stop serving requests, the pending ones are not answered */
+    void stop()
+    {
+        if (worker.joinable())
+        {
+            uint64_t one = 1;
+            [[maybe_unused]] auto rc = write(stopFd, &one, sizeof(one));
+            worker.join();
+        }
+    }
+
+    /** @brief Send a request from the terminus to the BMC
+     *
+     *  @param[in] request - PLDM request message
+     *
+     *  @return true if the request was sent
+     */
+    bool sendRequest(const std::vector<uint8_t>& request)
+    {
+        return sendPacket(tid, request.data(), request.size());
+    }
+
+    /** @brief Number of requests answered by the terminus */
+    uint64_t requestCount() const
+    {
+        return requests.load();
+    }
+
+    /** @brief Number of responses received by the terminus */
+    uint64_t responseCount() const
+    {
+        return responses.load();
+    }
+
+    pldm_tid_t getTid() const
+    {
+        return tid;
+    }
+
+  private:
+    void run()
+    {
+        std::array<pollfd, 2> pfds{{{fd, POLLIN, 0}, {stopFd, POLLIN, 0}}};
+        std::vector<uint8_t> packet(UINT16_MAX);
+        while (true)
+        {
+            if (poll(pfds.data(), pfds.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return;
+            }
+            if (pfds[1].revents)
+            {
+                return;
+            }
+            if (!(pfds[0].revents & POLLIN))
+            {
+                if (pfds[0].revents)
+                {
+                    return;
+                }
+                continue;
+            }
+
+            auto size = recv(fd, packet.data(), packet.size(), 0);
+            if (size <= 0)
+            {
+                return;
+            }
+            if (static_cast<size_t>(size) <
+                sizeof(pldm_tid_t) + sizeof(pldm_msg_hdr))
+            {
+                continue;
+            }
+
+            auto msg = reinterpret_cast<const pldm_msg*>(packet.data() + 1);
+            size_t msgLen = size - sizeof(pldm_tid_t) - sizeof(pldm_msg_hdr);
+            if (!msg->hdr.request)
+            {
+                ++responses;
+                if (responseHandler)
+                {
+                    responseHandler(msg, msgLen);
+                }
+                continue;
+            }
+
+            responder::Response response;
+            auto it = responders.find({msg->hdr.type, msg->hdr.command});
+            if (it != responders.end())
+            {
+                response = it->second(msg, msgLen);
+            }
+            else
+            {
+                response = responder::CmdHandler::ccOnlyResponse(
+                    msg, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+            }
+            ++requests;
+            if (!response.empty())
+            {
+                sendPacket(packet[0], response.data(), response.size());
+            }
+        }
+    }
+
+    bool sendPacket(pldm_tid_t packetTid, const void* msg, size_t len)
+    {
+        std::vector<uint8_t> packet(sizeof(packetTid) + len);
+        packet[0] = packetTid;
+        std::memcpy(packet.data() + sizeof(packetTid), msg, len);
+        return send(fd, packet.data(), packet.size(), MSG_NOSIGNAL) ==
+               static_cast<ssize_t>(packet.size());
+    }
+
+    int fd;
+    pldm_tid_t tid;
+    int stopFd;
+    std::map<std::pair<uint8_t, uint8_t>, Responder> responders;
+    ResponseHandler responseHandler;
+    std::atomic<uint64_t> requests = 0;
+    std::atomic<uint64_t> responses = 0;
+    std::thread worker;
+};
+
+/** @brief Encode a GetTID response
+ *
+ *  @param[in] request - GetTID request
+ *  @param[in] tid - TID to report
+ *
+ *  @return PLDM response message
+ */
+inline responder::Response getTidResponse(const pldm_msg* request,
+                                          pldm_tid_t tid)
+{
+    responder::Response response(sizeof(pldm_msg_hdr) +
+                                 PLDM_GET_TID_RESP_BYTES);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    encode_get_tid_resp(request->hdr.instance_id, PLDM_SUCCESS, tid,
+                        responsePtr);
+    return response;
+}
+
+/** @class GetTidHandler
+ *
+ *  Minimal PLDM base type handler answering GetTID, to exercise the Invoker
+ *  dispatch without the dependencies of the real responders.
+ */
+class GetTidHandler : public responder::CmdHandler
+{
+  public:
+    explicit GetTidHandler(pldm_tid_t tid)
+    {
+        handlers.emplace(PLDM_GET_TID,
+                         [tid](pldm_tid_t, const pldm_msg* request, size_t) {
+                             return getTidResponse(request, tid);
+                         });
+    }
+};
+
+/** @class LoopbackHarness
+ *
+ *  Wires the request path of pldmd to a FakeTerminus over a loopback
+ *  transport: requests received from the terminus are dispatched to the
+ *  Invoker like pldmd does, responses are handed to the requester Handler.
+ */
+class LoopbackHarness
+{
+  public:
+    LoopbackHarness(const LoopbackHarness&) = delete;
+    LoopbackHarness& operator=(const LoopbackHarness&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] terminusTid - TID of the fake terminus
+     *  @param[in] numRetries - number of request retries of the Handler
+     *  @param[in] responseTimeOut - response timeout of the Handler
+     */
+    explicit LoopbackHarness(
+        pldm_tid_t terminusTid = 9, uint8_t numRetries = 0,
+        std::chrono::milliseconds responseTimeOut =
+            std::chrono::milliseconds(RESPONSE_TIME_OUT)) :
+        LoopbackHarness(createSocketPair(), terminusTid, numRetries,
+                        responseTimeOut)
+    {}
+
+    /** @brief Run the event loop until a condition holds
+     *
+     *  @param[in] done - condition to wait for
+     *  @param[in] timeout - maximum time to wait for
+     *
+     *  @return true if the condition holds
+     */
+    bool runUntil(const std::function<bool()>& done,
+                  std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!done())
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return false;
+            }
+            auto remaining =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    deadline - now);
+            sd_event_run(event.get(), remaining.count());
+        }
+        return true;
+    }
+
+    sdeventplus::Event event;
+    TestInstanceIdDb instanceIdDb;
+    PldmTransport transport;
+    FakeTerminus terminus;
+    requester::Handler<requester::Request> handler;
+    responder::Invoker invoker;
+
+  private:
+    LoopbackHarness(std::array<int, 2> sockets, pldm_tid_t terminusTid,
+                    uint8_t numRetries,
+                    std::chrono::milliseconds responseTimeOut) :
+        event(sdeventplus::Event::get_default()), transport(sockets[0]),
+        terminus(sockets[1], terminusTid),
+        handler(&transport, event, instanceIdDb, false,
+                std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
+                numRetries, responseTimeOut),
+        io(event, transport.getEventSource(), EPOLLIN,
+           std::bind_front(&LoopbackHarness::processRxMsg, this))
+    {}
+
+    static std::array<int, 2> createSocketPair()
+    {
+        std::array<int, 2> fds{};
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds.data()))
+        {
+            throw std::system_error(errno, std::generic_category());
+        }
+        return fds;
+    }
+
+    void processRxMsg(sdeventplus::source::IO& /*io*/, int /*fd*/,
+                      uint32_t revents)
+    {
+        if (!(revents & EPOLLIN))
+        {
+            return;
+        }
+
+        pldm_tid_t tid{};
+        void* msg = nullptr;
+        size_t len{};
+        if (transport.recvMsg(tid, msg, len) != PLDM_REQUESTER_SUCCESS)
+        {
+            return;
+        }
+        if (len < sizeof(pldm_msg_hdr))
+        {
+            free(msg);
+            return;
+        }
+
+        auto pldmMsg = static_cast<const pldm_msg*>(msg);
+        auto payloadLen = len - sizeof(pldm_msg_hdr);
+        if (!pldmMsg->hdr.request)
+        {
+            handler.handleResponse(tid, pldmMsg->hdr.instance_id,
+                                   pldmMsg->hdr.type, pldmMsg->hdr.command,
+                                   pldmMsg, payloadLen);
+        }
+        else
+        {
+            responder::Response response;
+            try
+            {
+                response = invoker.handle(tid, pldmMsg->hdr.type,
+                                          pldmMsg->hdr.command, pldmMsg,
+                                          payloadLen);
+            }
+            catch (const std::out_of_range&)
+            {
+                response = responder::CmdHandler::ccOnlyResponse(
+                    pldmMsg, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+            }
+            transport.sendMsg(tid, response.data(), response.size());
+        }
+        free(msg);
+    }
+
+    sdeventplus::source::IO io;
+};
+
+} // namespace test
+} // namespace pldm
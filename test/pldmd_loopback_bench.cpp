@@ -0,0 +1,116 @@
+#include "test/loopback_harness.hpp"
+
+#include <libpldm/base.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pldm::test;
+
+namespace
+{
+
+std::vector<uint8_t> getTidRequest(uint8_t instanceId)
+{
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr));
+    encode_get_tid_req(instanceId, reinterpret_cast<pldm_msg*>(request.data()));
+    return request;
+}
+
+void respondToGetTid(FakeTerminus& terminus)
+{
+    auto tid = terminus.getTid();
+    terminus.setResponder(PLDM_BASE, PLDM_GET_TID,
+                          [tid](const pldm_msg* request, size_t) {
+                              return getTidResponse(request, tid);
+                          });
+}
+
+} // namespace
+
+/* Blocking exchange, the pldmtool request path */
+static void BM_TransportSendRecv(benchmark::State& state)
+{
+    LoopbackHarness harness{};
+    respondToGetTid(harness.terminus);
+    harness.terminus.start();
+
+    auto tid = harness.terminus.getTid();
+    auto request = getTidRequest(0);
+    for (auto _ : state)
+    {
+        void* response = nullptr;
+        size_t responseLen{};
+        if (harness.transport.sendRecvMsg(tid, request.data(), request.size(),
+                                          response, responseLen) !=
+            PLDM_REQUESTER_SUCCESS)
+        {
+            state.SkipWithError("no response");
+            break;
+        }
+        free(response);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransportSendRecv);
+
+/* Requests issued by pldmd through requester::Handler, a batch of requests
+ * registered at once per iteration
+ */
+static void BM_RequesterHandlerRoundTrip(benchmark::State& state)
+{
+    LoopbackHarness harness{};
+    respondToGetTid(harness.terminus);
+    harness.terminus.start();
+
+    auto tid = harness.terminus.getTid();
+    auto batch = state.range(0);
+    for (auto _ : state)
+    {
+        int64_t completed = 0;
+        for (int64_t i = 0; i < batch; ++i)
+        {
+            auto instanceId = harness.instanceIdDb.next(tid);
+            harness.handler.registerRequest(
+                tid, instanceId, PLDM_BASE, PLDM_GET_TID,
+                getTidRequest(instanceId),
+                [&completed](mctp_eid_t, const pldm_msg*, size_t) {
+                    ++completed;
+                });
+        }
+        if (!harness.runUntil([&]() { return completed == batch; }))
+        {
+            state.SkipWithError("requests timed out");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_RequesterHandlerRoundTrip)->Arg(1)->Arg(8)->Arg(16);
+
+/* Requests received by pldmd and dispatched through the Invoker */
+static void BM_InvokerRoundTrip(benchmark::State& state)
+{
+    LoopbackHarness harness{};
+    harness.invoker.registerHandler(PLDM_BASE,
+                                    std::make_unique<GetTidHandler>(1));
+    harness.terminus.start();
+
+    auto request = getTidRequest(0);
+    uint64_t expected = 0;
+    for (auto _ : state)
+    {
+        harness.terminus.sendRequest(request);
+        ++expected;
+        if (!harness.runUntil([&]() {
+                return harness.terminus.responseCount() == expected;
+            }))
+        {
+            state.SkipWithError("no response");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InvokerRoundTrip);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+#include "test/loopback_harness.hpp"
+
+#include <libpldm/base.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::test;
+
+namespace
+{
+
+std::vector<uint8_t> getTidRequest(uint8_t instanceId)
+{
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr));
+    encode_get_tid_req(instanceId, reinterpret_cast<pldm_msg*>(request.data()));
+    return request;
+}
+
+} // namespace
+
+TEST(LoopbackTransport, sendRecvMsg)
+{
+    LoopbackHarness harness{};
+    auto tid = harness.terminus.getTid();
+    harness.terminus.setResponder(
+        PLDM_BASE, PLDM_GET_TID,
+        [tid](const pldm_msg* request, size_t) {
+            return getTidResponse(request, tid);
+        });
+    harness.terminus.start();
+
+    auto request = getTidRequest(3);
+    void* response = nullptr;
+    size_t responseLen{};
+    auto rc = harness.transport.sendRecvMsg(tid, request.data(), request.size(),
+                                            response, responseLen);
+    ASSERT_EQ(rc, PLDM_REQUESTER_SUCCESS);
+    ASSERT_EQ(responseLen, sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES);
+
+    uint8_t cc{};
+    uint8_t respTid{};
+    rc = decode_get_tid_resp(static_cast<pldm_msg*>(response),
+                             PLDM_GET_TID_RESP_BYTES, &cc, &respTid);
+    free(response);
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(respTid, tid);
+}
+
+TEST(LoopbackTransport, rejectsInvalidSocket)
+{
+    EXPECT_THROW(PldmTransport{-1}, std::system_error);
+
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    EXPECT_THROW(PldmTransport{fds[0]}, std::system_error);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(LoopbackHarness, requesterRoundTrip)
+{
+    LoopbackHarness harness{};
+    auto tid = harness.terminus.getTid();
+    harness.terminus.start();
+
+    // No responder registered for GetTID, the terminus rejects it
+    uint8_t completionCode = PLDM_SUCCESS;
+    bool done = false;
+    auto instanceId = harness.instanceIdDb.next(tid);
+    auto rc = harness.handler.registerRequest(
+        tid, instanceId, PLDM_BASE, PLDM_GET_TID, getTidRequest(instanceId),
+        [&](mctp_eid_t, const pldm_msg* response, size_t respMsgLen) {
+            ASSERT_NE(response, nullptr);
+            ASSERT_GE(respMsgLen, 1);
+            completionCode = response->payload[0];
+            done = true;
+        });
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+
+    EXPECT_TRUE(harness.runUntil([&done]() { return done; }));
+    EXPECT_EQ(completionCode, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+    EXPECT_EQ(harness.terminus.requestCount(), 1);
+}
+
+TEST(LoopbackHarness, invokerDispatch)
+{
+    LoopbackHarness harness{};
+    harness.invoker.registerHandler(PLDM_BASE,
+                                    std::make_unique<GetTidHandler>(1));
+    harness.terminus.start();
+
+    ASSERT_TRUE(harness.terminus.sendRequest(getTidRequest(0)));
+    EXPECT_TRUE(harness.runUntil(
+        [&harness]() { return harness.terminus.responseCount() == 1; }));
+
+    // unsupported PLDM type
+    auto request = getTidRequest(1);
+    reinterpret_cast<pldm_msg*>(request.data())->hdr.type = PLDM_FRU;
+    ASSERT_TRUE(harness.terminus.sendRequest(request));
+    EXPECT_TRUE(harness.runUntil(
+        [&harness]() { return harness.terminus.responseCount() == 2; }));
+}
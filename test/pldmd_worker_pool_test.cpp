@@ -0,0 +1,97 @@
+#include "pldmd/invoker.hpp"
+#include "pldmd/worker_pool.hpp"
+
+#include <libpldm/base.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+
+namespace
+{
+
+class OffloadHandler : public CmdHandler
+{
+  public:
+    OffloadHandler()
+    {
+        handlers.emplace(PLDM_GET_TID,
+                         [](pldm_tid_t, const pldm_msg*, size_t) {
+                             return Response{PLDM_SUCCESS};
+                         });
+        handlers.emplace(PLDM_GET_PLDM_TYPES,
+                         [](pldm_tid_t, const pldm_msg*, size_t) {
+                             return Response{PLDM_SUCCESS};
+                         });
+        offloadable.emplace(PLDM_GET_TID);
+    }
+};
+
+} // namespace
+
+TEST(WorkerPool, completionOnEventLoop)
+{
+    auto event = sdeventplus::Event::get_new();
+    WorkerPool pool(event, 2);
+    EXPECT_EQ(pool.size(), 2);
+
+    auto loopThread = std::this_thread::get_id();
+    std::thread::id jobThread{};
+    int completed = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        pool.submit(
+            [&jobThread, i]() {
+                jobThread = std::this_thread::get_id();
+                return Response{static_cast<uint8_t>(i)};
+            },
+            [&completed, loopThread](Response&& response) {
+                EXPECT_EQ(std::this_thread::get_id(), loopThread);
+                EXPECT_EQ(response.size(), 1);
+                ++completed;
+            });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (completed < 4 && std::chrono::steady_clock::now() < deadline)
+    {
+        event.run(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(completed, 4);
+    EXPECT_NE(jobThread, loopThread);
+}
+
+TEST(WorkerPool, failedJob)
+{
+    auto event = sdeventplus::Event::get_new();
+    WorkerPool pool(event, 1);
+
+    bool done = false;
+    pool.submit([]() -> Response { throw std::runtime_error("failed"); },
+                [&done](Response&& response) {
+                    EXPECT_TRUE(response.empty());
+                    done = true;
+                });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done && std::chrono::steady_clock::now() < deadline)
+    {
+        event.run(std::chrono::milliseconds(100));
+    }
+    EXPECT_TRUE(done);
+}
+
+TEST(Invoker, isOffloadable)
+{
+    Invoker invoker{};
+    invoker.registerHandler(PLDM_BASE, std::make_unique<OffloadHandler>());
+
+    EXPECT_TRUE(invoker.isOffloadable(PLDM_BASE, PLDM_GET_TID));
+    EXPECT_FALSE(invoker.isOffloadable(PLDM_BASE, PLDM_GET_PLDM_TYPES));
+    EXPECT_FALSE(invoker.isOffloadable(PLDM_PLATFORM, PLDM_GET_TID));
+}